@@ -0,0 +1,573 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        bench.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+/*
+ * Runs every solver x line search combination over the problems of
+ * bench_problem.c for n = 2, 10, 100, ..., max_n and writes
+ *  prefix.csv, prefix.json:        one record per run
+ *  prefix_profile_seconds.csv,
+ *  prefix_profile_evaluations.csv: Dolan-More performance profiles
+ *
+ *  usage: bench [-m max_n] [-d dense_n] [-t seconds] [-p problem]
+ *               [-o prefix]
+ *   -m  largest n (default 10000, up to 1000000)
+ *   -d  largest n of the methods with an n x n matrix (default 200)
+ *   -t  time limit of a run in seconds (default 60)
+ *   -p  run only the problem of this name
+ *
+ * Every run is a child process, so that the peak RSS is its own and a
+ * run which crashes or exceeds the time limit fails alone.
+ */
+
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench_problem.h"
+#include "../src/include/non_linear_component.h"
+#include "../src/include/line_search_component.h"
+#include "../src/include/quasi_newton.h"
+#include "../src/include/conjugate_gradient.h"
+#include "../src/include/trust_region.h"
+#include "../src/include/nelder_mead.h"
+#include "../src/include/anderson_acceleration.h"
+#include "../src/include/armijo.h"
+#include "../src/include/wolfe.h"
+#include "../src/include/strong_wolfe.h"
+#include "../src/include/backtracking_wolfe.h"
+#include "../src/include/backtracking_strong_wolfe.h"
+#include "../src/include/mymath.h"
+
+#define MAX_SOLVERS 32
+#define NELDER_MEAD_MAX_N 100
+#define TOLERANCE 1.e-6
+#define SOLVED_TOLERANCE 1.e-5
+
+enum BenchStatus {
+    BENCH_TIMEOUT = -100,
+    BENCH_CRASHED,
+};
+
+typedef struct _BenchLineSearch {
+    const char *name;
+    line_search_t line_search;
+} BenchLineSearch;
+
+/*
+ * kind:
+ *  'q' - quasi_newton with formula
+ *  'c' - conjugate_gradient
+ *  't' - trust_region with formula
+ *  'n' - nelder_mead
+ *  'a' - anderson_gradient_descent
+ */
+typedef struct _BenchSolver {
+    char name[48];
+    char kind;
+    char formula;
+    int line_search;
+    int dense;
+} BenchSolver;
+
+typedef struct _BenchRecord {
+    int problem;
+    int n;
+    int solver;
+    int status;
+    int solved;
+    int iterations;
+    int evaluations_f;
+    int evaluations_g;
+    long int sor_sweeps;
+    double seconds;
+    double f;
+    double g_norm;
+    long int max_rss;
+} BenchRecord;
+
+static const BenchLineSearch bench_line_search[] = {
+    {"armijo", armijo},
+    {"wolfe", wolfe},
+    {"strong_wolfe", strong_wolfe},
+    {"backtracking_wolfe", backtracking_wolfe},
+    {"backtracking_strong_wolfe", backtracking_strong_wolfe},
+};
+
+static const int num_bench_line_searches =
+    sizeof(bench_line_search) / sizeof(BenchLineSearch);
+
+static int
+set_bench_solver(
+    BenchSolver *solver
+);
+
+static void
+run_solver(
+    const BenchProblem *problem,
+    int n,
+    const BenchSolver *solver,
+    BenchRecord *record
+);
+
+static int
+run_child(
+    const BenchProblem *problem,
+    int n,
+    const BenchSolver *solver,
+    int timeout,
+    BenchRecord *record
+);
+
+static void
+write_profile(
+    const char *path,
+    const BenchRecord *record,
+    int num_records,
+    const BenchSolver *solver,
+    int num_solvers,
+    int measure
+);
+
+static double
+monotonic_seconds(
+    void
+);
+
+int
+main(
+    int argc,
+    char **argv
+) {
+    int i, p, s, k, n, option, max_n, dense_n, timeout,
+        num_solvers, num_records, capacity;
+    const char *prefix = "bench", *only = NULL;
+    char path[1024];
+    FILE *csv, *json;
+    BenchSolver solver[MAX_SOLVERS];
+    BenchRecord *record, *grown;
+
+    max_n = 10000;
+    dense_n = 200;
+    timeout = 60;
+    while (-1 != (option = getopt(argc, argv, "m:d:t:p:o:"))) {
+        switch (option) {
+            case 'm':
+                max_n = atoi(optarg);
+                break;
+            case 'd':
+                dense_n = atoi(optarg);
+                break;
+            case 't':
+                timeout = atoi(optarg);
+                break;
+            case 'p':
+                only = optarg;
+                break;
+            case 'o':
+                prefix = optarg;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-m max_n] [-d dense_n] "
+                        "[-t seconds] [-p problem] [-o prefix]\n", argv[0]);
+                return 1;
+        }
+    }
+    num_solvers = set_bench_solver(solver);
+
+    snprintf(path, sizeof(path), "%s.csv", prefix);
+    if (NULL == (csv = fopen(path, "w"))) {
+        perror(path);
+        return 1;
+    }
+    snprintf(path, sizeof(path), "%s.json", prefix);
+    if (NULL == (json = fopen(path, "w"))) {
+        perror(path);
+        fclose(csv);
+        return 1;
+    }
+    capacity = 1024;
+    num_records = 0;
+    if (NULL == (record = (BenchRecord *)malloc(
+                    sizeof(BenchRecord) * capacity))) {
+        perror("record");
+        fclose(json);
+        fclose(csv);
+        return 1;
+    }
+    fprintf(csv, "problem,n,solver,status,solved,seconds,iterations,"
+            "evaluations_f,evaluations_g,sor_sweeps,f,g_norm,max_rss_kb\n");
+    fprintf(json, "[");
+
+    for (p = 0; p < num_bench_problems; ++p) {
+        if (NULL != only && 0 != strcmp(only, bench_problem[p].name))
+            continue;
+        for (k = 2; k <= max_n; k = 2 == k ? 10 : 10 * k) {
+            n = k - k % bench_problem[p].step;
+            if (n < bench_problem[p].min_n || (bench_problem[p].max_n > 0
+                        && n > bench_problem[p].max_n))
+                continue;
+            for (s = 0; s < num_solvers; ++s) {
+                if ((solver[s].dense && n > dense_n)
+                        || ('n' == solver[s].kind && n > NELDER_MEAD_MAX_N))
+                    continue;
+                if (num_records == capacity) {
+                    /* the runs recorded so far are kept and written out */
+                    if (NULL == (grown = (BenchRecord *)realloc(record,
+                                    sizeof(BenchRecord) * 2 * capacity))) {
+                        perror("record");
+                        goto finish;
+                    }
+                    record = grown;
+                    capacity *= 2;
+                }
+                run_child(&bench_problem[p], n, &solver[s], timeout,
+                        &record[num_records]);
+                record[num_records].problem = p;
+                record[num_records].n = n;
+                record[num_records].solver = s;
+                i = num_records++;
+                fprintf(csv, "%s,%d,%s,%d,%d,%.6e,%d,%d,%d,%ld,%.17g,%.6e,"
+                        "%ld\n", bench_problem[p].name, n, solver[s].name,
+                        record[i].status, record[i].solved, record[i].seconds,
+                        record[i].iterations, record[i].evaluations_f,
+                        record[i].evaluations_g, record[i].sor_sweeps,
+                        record[i].f,
+                        record[i].g_norm, record[i].max_rss);
+                fprintf(json, "%s\n {\"problem\": \"%s\", \"n\": %d, "
+                        "\"solver\": \"%s\", \"status\": %d, \"solved\": %s, "
+                        "\"seconds\": %.6e, \"iterations\": %d, "
+                        "\"evaluations_f\": %d, \"evaluations_g\": %d, "
+                        "\"sor_sweeps\": %ld, \"f\": %.17g, \"g_norm\": %.6e, \"max_rss_kb\": %ld}",
+                        i > 0 ? "," : "", bench_problem[p].name, n,
+                        solver[s].name, record[i].status,
+                        record[i].solved ? "true" : "false",
+                        record[i].seconds, record[i].iterations,
+                        record[i].evaluations_f, record[i].evaluations_g,
+                        record[i].sor_sweeps, isfinite(record[i].f) ? record[i].f : 0.,
+                        isfinite(record[i].g_norm) ? record[i].g_norm : 0.,
+                        record[i].max_rss);
+                fflush(csv);
+                fprintf(stderr, "%-20s %8d %-40s %s %.3es\n",
+                        bench_problem[p].name, n, solver[s].name,
+                        record[i].solved ? "solved" : "failed",
+                        record[i].seconds);
+            }
+        }
+    }
+finish:
+    fprintf(json, "\n]\n");
+    fclose(json);
+    fclose(csv);
+
+    snprintf(path, sizeof(path), "%s_profile_seconds.csv", prefix);
+    write_profile(path, record, num_records, solver, num_solvers, 's');
+    snprintf(path, sizeof(path), "%s_profile_evaluations.csv", prefix);
+    write_profile(path, record, num_records, solver, num_solvers, 'e');
+    free(record);
+    return 0;
+}
+
+static int
+set_bench_solver(
+    BenchSolver *solver
+) {
+    static const char formula[] = "bhs";
+    static const char *formula_name[] = {"bfgs_b", "bfgs_h", "sr1_h"};
+    int i, l, num = 0;
+
+    for (i = 0; i < 3; ++i) {
+        for (l = 0; l < num_bench_line_searches; ++l, ++num) {
+            snprintf(solver[num].name, sizeof(solver[num].name), "qn_%s/%s",
+                    formula_name[i], bench_line_search[l].name);
+            solver[num].kind = 'q';
+            solver[num].formula = formula[i];
+            solver[num].line_search = l;
+            solver[num].dense = 1;
+        }
+    }
+    for (l = 0; l < num_bench_line_searches; ++l, ++num) {
+        snprintf(solver[num].name, sizeof(solver[num].name), "cg/%s",
+                bench_line_search[l].name);
+        solver[num].kind = 'c';
+        solver[num].formula = 0;
+        solver[num].line_search = l;
+        solver[num].dense = 0;
+    }
+    strcpy(solver[num].name, "tr_sr1");
+    solver[num].kind = 't';
+    solver[num].formula = 's';
+    solver[num].line_search = -1;
+    solver[num++].dense = 1;
+    strcpy(solver[num].name, "tr_lsr1");
+    solver[num].kind = 't';
+    solver[num].formula = 'l';
+    solver[num].line_search = -1;
+    solver[num++].dense = 0;
+    strcpy(solver[num].name, "nelder_mead");
+    solver[num].kind = 'n';
+    solver[num].formula = 0;
+    solver[num].line_search = -1;
+    solver[num++].dense = 0;
+    strcpy(solver[num].name, "anderson_gd");
+    solver[num].kind = 'a';
+    solver[num].formula = 0;
+    solver[num].line_search = -1;
+    solver[num++].dense = 0;
+    return num;
+}
+
+static void
+run_solver(
+    const BenchProblem *problem,
+    int n,
+    const BenchSolver *solver,
+    BenchRecord *record
+) {
+    double *x, *g, g0_norm, started;
+    FunctionObject function_object;
+    SolverObserver observer;
+    SolverStatistics statistics;
+    LineSearchParameter line_search_parameter;
+    QuasiNewtonParameter quasi_newton_parameter;
+    ConjugateGradientParameter conjugate_gradient_parameter;
+    TrustRegionParameter trust_region_parameter;
+    NelderMeadParameter nelder_mead_parameter;
+    AndersonParameter anderson_parameter;
+
+    memset(record, 0, sizeof(BenchRecord));
+    record->status = NON_LINEAR_OUT_OF_MEMORY;
+    x = (double *)malloc(sizeof(double) * n);
+    g = (double *)malloc(sizeof(double) * n);
+    if (NULL == x || NULL == g)
+        return;
+    problem->initial(x, n);
+    problem->gradient(g, x, n, NULL);
+    g0_norm = infinity_norm(g, n);
+
+    memset(&statistics, 0, sizeof(statistics));
+    memset(&observer, 0, sizeof(observer));
+    observer.statistics = &statistics;
+    default_function_object(&function_object);
+    function_object.function = problem->function;
+    function_object.gradient = problem->gradient;
+    function_object.observer = &observer;
+    default_line_search_parameter(&line_search_parameter);
+
+    started = monotonic_seconds();
+    switch (solver->kind) {
+        case 'q':
+            memset(&quasi_newton_parameter, 0, sizeof(QuasiNewtonParameter));
+            quasi_newton_parameter.formula = solver->formula;
+            quasi_newton_parameter.tolerance = TOLERANCE;
+            record->status = quasi_newton(x, NULL, n, &function_object,
+                    bench_line_search[solver->line_search].line_search,
+                    &line_search_parameter, &quasi_newton_parameter);
+            break;
+        case 'c':
+            memset(&conjugate_gradient_parameter, 0,
+                    sizeof(ConjugateGradientParameter));
+            conjugate_gradient_parameter.tolerance = TOLERANCE;
+            record->status = conjugate_gradient(x, n, &function_object,
+                    bench_line_search[solver->line_search].line_search,
+                    &line_search_parameter, &conjugate_gradient_parameter);
+            break;
+        case 't':
+            memset(&trust_region_parameter, 0, sizeof(TrustRegionParameter));
+            trust_region_parameter.formula = solver->formula;
+            trust_region_parameter.tolerance = TOLERANCE;
+            record->status = trust_region(x, NULL, n, &function_object,
+                    &trust_region_parameter);
+            break;
+        case 'n':
+            memset(&nelder_mead_parameter, 0, sizeof(NelderMeadParameter));
+            record->status = nelder_mead(x, n, &function_object,
+                    &nelder_mead_parameter);
+            break;
+        case 'a':
+            memset(&anderson_parameter, 0, sizeof(AndersonParameter));
+            anderson_parameter.tolerance = TOLERANCE;
+            record->status = anderson_gradient_descent(x, n,
+                    &function_object, &anderson_parameter);
+            break;
+        default:
+            break;
+    }
+    record->seconds = monotonic_seconds() - started;
+    record->iterations = statistics.iterations;
+    record->evaluations_f = statistics.iteration_f;
+    record->evaluations_g = statistics.iteration_g;
+    record->sor_sweeps = statistics.sor_sweeps;
+    record->f = problem->function(x, n, NULL);
+    problem->gradient(g, x, n, NULL);
+    record->g_norm = infinity_norm(g, n);
+    record->solved = isfinite(record->f)
+        && record->g_norm <= SOLVED_TOLERANCE * (g0_norm > 1. ? g0_norm : 1.);
+    free(g);
+    free(x);
+}
+
+static int
+run_child(
+    const BenchProblem *problem,
+    int n,
+    const BenchSolver *solver,
+    int timeout,
+    BenchRecord *record
+) {
+    int pipe_fd[2], status;
+    pid_t pid;
+    struct rusage usage;
+    BenchRecord child;
+
+    memset(record, 0, sizeof(BenchRecord));
+    record->status = BENCH_CRASHED;
+    record->f = record->g_norm = HUGE_VAL;
+    if (0 != pipe(pipe_fd))
+        return -1;
+    fflush(NULL);
+    if (0 == (pid = fork())) {
+        close(pipe_fd[0]);
+        alarm(timeout);
+        run_solver(problem, n, solver, &child);
+        if (sizeof(child) != write(pipe_fd[1], &child, sizeof(child)))
+            _exit(1);
+        _exit(0);
+    }
+    close(pipe_fd[1]);
+    if (pid < 0) {
+        close(pipe_fd[0]);
+        return -1;
+    }
+    if (sizeof(child) == read(pipe_fd[0], &child, sizeof(child)))
+        *record = child;
+    close(pipe_fd[0]);
+    if (pid == wait4(pid, &status, 0, &usage)) {
+        /* ru_maxrss is in kilobytes on Linux */
+        record->max_rss = usage.ru_maxrss;
+        if (WIFSIGNALED(status)) {
+            record->status = SIGALRM == WTERMSIG(status)
+                ? BENCH_TIMEOUT : BENCH_CRASHED;
+            record->solved = 0;
+            record->seconds = SIGALRM == WTERMSIG(status) ? timeout : 0.;
+        }
+    }
+    return 0;
+}
+
+/*
+ * rho_s(tau) = |{p : r_p,s <= tau}| / |P|, where r_p,s = t_p,s / min t_p
+ * over the problems P (problem and n) which some solver solved; t_p,s is
+ * the seconds or the evaluations of f and gf, and infinity if s failed
+ * on p or did not run it. tau is sampled at 2^(k/4).
+ */
+static void
+write_profile(
+    const char *path,
+    const BenchRecord *record,
+    int num_records,
+    const BenchSolver *solver,
+    int num_solvers,
+    int measure
+) {
+    int i, j, s, k, num_problems, count;
+    double *ratio, *best, tau, max_ratio, t;
+    int *problem_of;
+    FILE *stream;
+
+    /* number the problems by the first record of each (problem, n) */
+    problem_of = (int *)malloc(sizeof(int) * (num_records + 1));
+    best = (double *)malloc(sizeof(double) * (num_records + 1));
+    ratio = (double *)malloc(sizeof(double)
+            * (num_records + 1) * num_solvers);
+    if (NULL == problem_of || NULL == best || NULL == ratio)
+        goto release;
+    num_problems = 0;
+    for (i = 0; i < num_records; ++i) {
+        for (j = 0; j < i; ++j) {
+            if (record[j].problem == record[i].problem
+                    && record[j].n == record[i].n)
+                break;
+        }
+        problem_of[i] = j < i ? problem_of[j] : num_problems++;
+    }
+    for (i = 0; i < num_problems; ++i)
+        best[i] = HUGE_VAL;
+    for (i = 0; i < num_problems * num_solvers; ++i)
+        ratio[i] = HUGE_VAL;
+    for (i = 0; i < num_records; ++i) {
+        if (!record[i].solved)
+            continue;
+        t = 's' == measure ? record[i].seconds
+            : record[i].evaluations_f + record[i].evaluations_g;
+        /* a clock tick as the least time keeps the ratios finite */
+        t = t > 1.e-9 ? t : 1.e-9;
+        ratio[problem_of[i] * num_solvers + record[i].solver] = t;
+        if (t < best[problem_of[i]])
+            best[problem_of[i]] = t;
+    }
+    max_ratio = 1.;
+    for (i = 0, count = 0; i < num_problems; ++i) {
+        if (HUGE_VAL == best[i])
+            continue;
+        ++count;
+        for (s = 0; s < num_solvers; ++s) {
+            ratio[i * num_solvers + s] /= best[i];
+            if (isfinite(ratio[i * num_solvers + s])
+                    && ratio[i * num_solvers + s] > max_ratio)
+                max_ratio = ratio[i * num_solvers + s];
+        }
+    }
+
+    if (NULL == (stream = fopen(path, "w"))) {
+        perror(path);
+        goto release;
+    }
+    fprintf(stream, "tau");
+    for (s = 0; s < num_solvers; ++s)
+        fprintf(stream, ",%s", solver[s].name);
+    fprintf(stream, "\n");
+    for (k = 0; ; ++k) {
+        tau = pow(2., k / 4.);
+        fprintf(stream, "%.6g", tau);
+        for (s = 0; s < num_solvers; ++s) {
+            for (i = 0, j = 0; i < num_problems; ++i) {
+                if (HUGE_VAL != best[i] && ratio[i * num_solvers + s] <= tau)
+                    ++j;
+            }
+            fprintf(stream, ",%.6f", count > 0 ? (double)j / count : 0.);
+        }
+        fprintf(stream, "\n");
+        if (tau >= max_ratio)
+            break;
+    }
+    fclose(stream);
+release:
+    free(ratio);
+    free(best);
+    free(problem_of);
+}
+
+static double
+monotonic_seconds(
+    void
+) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec;
+}
@@ -0,0 +1,671 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        bench_problem.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+/*
+ * The problems of driver1.c ... driver7.c (with gradients which agree
+ * with their functions) and scalable problems of the CUTEst collection.
+ * Every gradient costs O(n).
+ */
+
+#include "bench_problem.h"
+
+#include <math.h>
+#include <stddef.h>
+
+#define PI 3.14159265358979323846264338327
+
+static void
+initial_zeros(
+    double *x,
+    int n
+) {
+    int i;
+    for (i = 0; i < n; ++i)
+        x[i] = 0.;
+}
+
+static void
+initial_ones(
+    double *x,
+    int n
+) {
+    int i;
+    for (i = 0; i < n; ++i)
+        x[i] = 1.;
+}
+
+static void
+initial_minus_ones(
+    double *x,
+    int n
+) {
+    int i;
+    for (i = 0; i < n; ++i)
+        x[i] = -1.;
+}
+
+/*
+ * driver1: f(x) = (x1 - x2^2)^2 + (x2 - 2)^2 / 2
+ */
+static double
+driver1_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    double r = x[0] - x[1] * x[1];
+    return r * r + (x[1] - 2.) * (x[1] - 2.) / 2.;
+}
+
+static void
+driver1_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    double r = x[0] - x[1] * x[1];
+    g[0] = 2. * r;
+    g[1] = -4. * x[1] * r + x[1] - 2.;
+}
+
+/*
+ * driver2: f(x) = sum {e^x_i - x_i * sqrt(i + 1)}
+ */
+static double
+exponential_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 0.;
+    for (i = 0; i < n; ++i)
+        f += exp(x[i]) - x[i] * sqrt(i + 1.);
+    return f;
+}
+
+static void
+exponential_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    for (i = 0; i < n; ++i)
+        g[i] = exp(x[i]) - sqrt(i + 1.);
+}
+
+/*
+ * driver3: f(x) = 1 + sum x_i^2 / 4000 - prod cos(x_i / (i + 1))
+ */
+static double
+griewank_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 0., product = 1.;
+    for (i = 0; i < n; ++i) {
+        f += x[i] * x[i];
+        product *= cos(x[i] / (i + 1));
+    }
+    return 1. + f / 4000. - product;
+}
+
+static void
+griewank_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i, j;
+    double product = 1., c, others;
+    for (i = 0; i < n; ++i)
+        product *= cos(x[i] / (i + 1));
+    for (i = 0; i < n; ++i) {
+        c = cos(x[i] / (i + 1));
+        if (fabs(c) > 1.e-8) {
+            others = product / c;
+        } else {
+            for (j = 0, others = 1.; j < n; ++j) {
+                if (j != i)
+                    others *= cos(x[j] / (j + 1));
+            }
+        }
+        g[i] = x[i] / 2000. + sin(x[i] / (i + 1)) / (i + 1) * others;
+    }
+}
+
+/*
+ * driver4: f(x) = sum x_i^2
+ */
+static double
+sphere_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 0.;
+    for (i = 0; i < n; ++i)
+        f += x[i] * x[i];
+    return f;
+}
+
+static void
+sphere_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    for (i = 0; i < n; ++i)
+        g[i] = 2. * x[i];
+}
+
+/*
+ * driver5: f(x) = sum_i (sum_{j <= i} x_j)^2
+ *  gf(x)_k = 2 * sum_{i >= k} sum_{j <= i} x_j
+ */
+static double
+partial_sum_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 0., sum = 0.;
+    for (i = 0; i < n; ++i) {
+        sum += x[i];
+        f += sum * sum;
+    }
+    return f;
+}
+
+static void
+partial_sum_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double sum = 0., tail = 0.;
+    for (i = 0; i < n; ++i) {
+        sum += x[i];
+        g[i] = sum;
+    }
+    for (i = n - 1; i >= 0; --i) {
+        tail += g[i];
+        g[i] = 2. * tail;
+    }
+}
+
+/*
+ * driver6: f(x) = sum x_i^2 + 10 * sum {1 - cos(2 pi x_i)}
+ */
+static double
+rastrigin_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 0.;
+    for (i = 0; i < n; ++i)
+        f += x[i] * x[i] + 10. * (1. - cos(2. * PI * x[i]));
+    return f;
+}
+
+static void
+rastrigin_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    for (i = 0; i < n; ++i)
+        g[i] = 2. * x[i] + 20. * PI * sin(2. * PI * x[i]);
+}
+
+/*
+ * driver7: f(x) = 20 * (1 - e^(-||x|| / (5 sqrt(n))))
+ *                  + e - e^(sum cos(2 pi x_i) / n)
+ */
+static double
+ackley_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double norm = 0., sum = 0.;
+    for (i = 0; i < n; ++i) {
+        norm += x[i] * x[i];
+        sum += cos(2. * PI * x[i]);
+    }
+    return 20. * (1. - exp(-sqrt(norm) / (5. * sqrt(n))))
+        + exp(1.) - exp(sum / n);
+}
+
+static void
+ackley_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double norm = 0., sum = 0., a, radial, periodic;
+    for (i = 0; i < n; ++i) {
+        norm += x[i] * x[i];
+        sum += cos(2. * PI * x[i]);
+    }
+    norm = sqrt(norm);
+    a = 5. * sqrt(n);
+    radial = norm > 0. ? 20. * exp(-norm / a) / (a * norm) : 0.;
+    periodic = 2. * PI * exp(sum / n) / n;
+    for (i = 0; i < n; ++i)
+        g[i] = radial * x[i] + periodic * sin(2. * PI * x[i]);
+}
+
+/*
+ * extended Rosenbrock (CUTEst EXTROSNB form, n even)
+ *  f(x) = sum_k 100 (x_2k+1 - x_2k^2)^2 + (1 - x_2k)^2
+ */
+static void
+rosenbrock_initial(
+    double *x,
+    int n
+) {
+    int i;
+    for (i = 0; i < n; i += 2) {
+        x[i] = -1.2;
+        x[i + 1] = 1.;
+    }
+}
+
+static double
+rosenbrock_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 0., a, b;
+    for (i = 0; i < n; i += 2) {
+        a = x[i + 1] - x[i] * x[i];
+        b = 1. - x[i];
+        f += 100. * a * a + b * b;
+    }
+    return f;
+}
+
+static void
+rosenbrock_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double a;
+    for (i = 0; i < n; i += 2) {
+        a = x[i + 1] - x[i] * x[i];
+        g[i] = -400. * x[i] * a - 2. * (1. - x[i]);
+        g[i + 1] = 200. * a;
+    }
+}
+
+/*
+ * GENROSE: f(x) = 1 + sum_{i >= 1} 100 (x_i - x_i-1^2)^2 + (x_i - 1)^2
+ */
+static void
+genrose_initial(
+    double *x,
+    int n
+) {
+    int i;
+    for (i = 0; i < n; ++i)
+        x[i] = (i + 1.) / (n + 1.);
+}
+
+static double
+genrose_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 1., a;
+    for (i = 1; i < n; ++i) {
+        a = x[i] - x[i - 1] * x[i - 1];
+        f += 100. * a * a + (x[i] - 1.) * (x[i] - 1.);
+    }
+    return f;
+}
+
+static void
+genrose_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double a;
+    g[0] = 0.;
+    for (i = 1; i < n; ++i) {
+        a = x[i] - x[i - 1] * x[i - 1];
+        g[i - 1] += -400. * x[i - 1] * a;
+        g[i] = 200. * a + 2. * (x[i] - 1.);
+    }
+}
+
+/*
+ * extended Powell singular (n multiple of 4)
+ */
+static void
+powell_initial(
+    double *x,
+    int n
+) {
+    int i;
+    for (i = 0; i < n; i += 4) {
+        x[i] = 3.;
+        x[i + 1] = -1.;
+        x[i + 2] = 0.;
+        x[i + 3] = 1.;
+    }
+}
+
+static double
+powell_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 0., a, b, c, d;
+    for (i = 0; i < n; i += 4) {
+        a = x[i] + 10. * x[i + 1];
+        b = x[i + 2] - x[i + 3];
+        c = x[i + 1] - 2. * x[i + 2];
+        d = x[i] - x[i + 3];
+        f += a * a + 5. * b * b + c * c * c * c + 10. * d * d * d * d;
+    }
+    return f;
+}
+
+static void
+powell_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double a, b, c, d;
+    for (i = 0; i < n; i += 4) {
+        a = x[i] + 10. * x[i + 1];
+        b = x[i + 2] - x[i + 3];
+        c = x[i + 1] - 2. * x[i + 2];
+        d = x[i] - x[i + 3];
+        g[i] = 2. * a + 40. * d * d * d;
+        g[i + 1] = 20. * a + 4. * c * c * c;
+        g[i + 2] = 10. * b - 8. * c * c * c;
+        g[i + 3] = -10. * b - 40. * d * d * d;
+    }
+}
+
+/*
+ * Broyden tridiagonal as least squares
+ *  r_i = (3 - 2 x_i) x_i - x_i-1 - 2 x_i+1 + 1, f(x) = sum r_i^2
+ */
+static double
+broyden_residual(
+    const double *x,
+    int n,
+    int i
+) {
+    return (3. - 2. * x[i]) * x[i] - (i > 0 ? x[i - 1] : 0.)
+        - 2. * (i < n - 1 ? x[i + 1] : 0.) + 1.;
+}
+
+static double
+broyden_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 0., r;
+    for (i = 0; i < n; ++i) {
+        r = broyden_residual(x, n, i);
+        f += r * r;
+    }
+    return f;
+}
+
+static void
+broyden_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double r_previous, r, r_next;
+    r_previous = 0.;
+    r = broyden_residual(x, n, 0);
+    for (i = 0; i < n; ++i) {
+        r_next = i < n - 1 ? broyden_residual(x, n, i + 1) : 0.;
+        g[i] = 2. * (r * (3. - 4. * x[i]) - r_next - 2. * r_previous);
+        r_previous = r;
+        r = r_next;
+    }
+}
+
+/*
+ * ARWHEAD: f(x) = sum_{i < n-1} (-4 x_i + 3) + (x_i^2 + x_n-1^2)^2
+ */
+static double
+arwhead_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 0., a, last = x[n - 1] * x[n - 1];
+    for (i = 0; i < n - 1; ++i) {
+        a = x[i] * x[i] + last;
+        f += -4. * x[i] + 3. + a * a;
+    }
+    return f;
+}
+
+static void
+arwhead_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double a, last = x[n - 1] * x[n - 1];
+    g[n - 1] = 0.;
+    for (i = 0; i < n - 1; ++i) {
+        a = x[i] * x[i] + last;
+        g[i] = -4. + 4. * x[i] * a;
+        g[n - 1] += 4. * x[n - 1] * a;
+    }
+}
+
+/*
+ * Dixon-Price: f(x) = (x_0 - 1)^2 + sum_{i >= 1} (i + 1) (2 x_i^2 - x_i-1)^2
+ */
+static double
+dixon_price_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = (x[0] - 1.) * (x[0] - 1.), t;
+    for (i = 1; i < n; ++i) {
+        t = 2. * x[i] * x[i] - x[i - 1];
+        f += (i + 1.) * t * t;
+    }
+    return f;
+}
+
+static void
+dixon_price_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double t;
+    g[0] = 2. * (x[0] - 1.);
+    for (i = 1; i < n; ++i) {
+        t = 2. * x[i] * x[i] - x[i - 1];
+        g[i] = 8. * (i + 1.) * t * x[i];
+        g[i - 1] -= 2. * (i + 1.) * t;
+    }
+}
+
+/*
+ * trigonometric (More, Garbow and Hillstrom)
+ *  r_i = n - sum cos x_j + (i + 1) (1 - cos x_i) - sin x_i
+ */
+static void
+trigonometric_initial(
+    double *x,
+    int n
+) {
+    int i;
+    for (i = 0; i < n; ++i)
+        x[i] = 1. / n;
+}
+
+static double
+trigonometric_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = 0., sum = 0., r;
+    for (i = 0; i < n; ++i)
+        sum += cos(x[i]);
+    for (i = 0; i < n; ++i) {
+        r = n - sum + (i + 1.) * (1. - cos(x[i])) - sin(x[i]);
+        f += r * r;
+    }
+    return f;
+}
+
+static void
+trigonometric_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double sum = 0., total = 0., r;
+    for (i = 0; i < n; ++i)
+        sum += cos(x[i]);
+    for (i = 0; i < n; ++i) {
+        r = n - sum + (i + 1.) * (1. - cos(x[i])) - sin(x[i]);
+        total += r;
+        g[i] = 2. * r * ((i + 1.) * sin(x[i]) - cos(x[i]));
+    }
+    for (i = 0; i < n; ++i)
+        g[i] += 2. * total * sin(x[i]);
+}
+
+/*
+ * TRIDIA: f(x) = (x_0 - 1)^2 + sum_{i >= 1} (i + 1) (2 x_i - x_i-1)^2
+ */
+static double
+tridia_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double f = (x[0] - 1.) * (x[0] - 1.), t;
+    for (i = 1; i < n; ++i) {
+        t = 2. * x[i] - x[i - 1];
+        f += (i + 1.) * t * t;
+    }
+    return f;
+}
+
+static void
+tridia_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i;
+    double t;
+    g[0] = 2. * (x[0] - 1.);
+    for (i = 1; i < n; ++i) {
+        t = 2. * x[i] - x[i - 1];
+        g[i] = 4. * (i + 1.) * t;
+        g[i - 1] -= 2. * (i + 1.) * t;
+    }
+}
+
+const BenchProblem bench_problem[] = {
+    {"driver1", 2, 2, 1, initial_zeros,
+        driver1_function, driver1_gradient},
+    {"exponential", 1, 0, 1, initial_ones,
+        exponential_function, exponential_gradient},
+    {"griewank", 1, 0, 1, initial_ones,
+        griewank_function, griewank_gradient},
+    {"sphere", 1, 0, 1, initial_ones,
+        sphere_function, sphere_gradient},
+    {"partial_sum", 1, 0, 1, initial_ones,
+        partial_sum_function, partial_sum_gradient},
+    {"rastrigin", 1, 0, 1, initial_ones,
+        rastrigin_function, rastrigin_gradient},
+    {"ackley", 1, 0, 1, initial_ones,
+        ackley_function, ackley_gradient},
+    {"rosenbrock", 2, 0, 2, rosenbrock_initial,
+        rosenbrock_function, rosenbrock_gradient},
+    {"genrose", 2, 0, 1, genrose_initial,
+        genrose_function, genrose_gradient},
+    {"powell", 4, 0, 4, powell_initial,
+        powell_function, powell_gradient},
+    {"broyden_tridiagonal", 1, 0, 1, initial_minus_ones,
+        broyden_function, broyden_gradient},
+    {"arwhead", 2, 0, 1, initial_ones,
+        arwhead_function, arwhead_gradient},
+    {"dixon_price", 2, 0, 1, initial_ones,
+        dixon_price_function, dixon_price_gradient},
+    {"trigonometric", 1, 0, 1, trigonometric_initial,
+        trigonometric_function, trigonometric_gradient},
+    {"tridia", 2, 0, 1, initial_ones,
+        tridia_function, tridia_gradient},
+};
+
+const int num_bench_problems = sizeof(bench_problem) / sizeof(BenchProblem);
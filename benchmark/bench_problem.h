@@ -0,0 +1,30 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        bench_problem.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_BENCH_PROBLEM_H
+#define OPTIMIZATION_BENCH_PROBLEM_H
+
+/*
+ * A scalable test problem. n must satisfy min_n <= n (<= max_n unless
+ * max_n is 0) and be a multiple of step.
+ */
+typedef struct _BenchProblem {
+    const char *name;
+    int min_n;
+    int max_n;
+    int step;
+    void    (*initial)(double *, int);
+    double  (*function)(const double *, int, void *);
+    void    (*gradient)(double *, const double *, int, void *);
+} BenchProblem;
+
+extern const BenchProblem bench_problem[];
+extern const int num_bench_problems;
+
+#endif // OPTIMIZATION_BENCH_PROBLEM_H
@@ -0,0 +1,431 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        microbench.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+/*
+ * Microbenchmark of the kernels of mymath.c and of the BFGS kernels of
+ * quasi_newton.c over n from L1 resident to DRAM resident sizes.
+ * For every kernel and n it reports ns per element, GFLOP/s, GB/s and
+ * the fraction of the roofline min(peak GFLOP/s, intensity * bandwidth),
+ * where the bandwidth (triad) and the peak (independent multiply-adds)
+ * are measured on this machine with the same compiler flags.  The
+ * bandwidth is that of the largest vector, so cache resident kernels can
+ * run above their (DRAM) roof.
+ *
+ *  usage: microbench [-v max_vector_n] [-m max_matrix_n] [-o csv]
+ *
+ * The BFGS kernels are those of quasi_newton.c, declared in
+ * quasi_newton_kernels.h, so the code measured is the code the solver
+ * runs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/include/mymath.h"
+#include "../src/include/quasi_newton_kernels.h"
+
+#define TRIALS 5
+#define MIN_TRIAL_SECONDS 1.e-2
+#define PEAK_ACCUMULATORS 16
+
+typedef struct _Kernel Kernel;
+
+/*
+ * flop and byte are per call: the bytes are those the kernel must move
+ * (every operand read once, every result written once)
+ */
+struct _Kernel {
+    const char *name;
+    char shape;
+    void    (*run)(Kernel *);
+    double  (*flop)(int);
+    double  (*byte)(int);
+    int n;
+    double *x;
+    double *y;
+    double *z;
+    double **a;
+    double sink;
+};
+
+static double
+monotonic_seconds(
+    void
+) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec;
+}
+
+/*
+ * best seconds of a call over TRIALS trials of enough repetitions
+ */
+static double
+time_kernel(
+    Kernel *kernel
+) {
+    int trial;
+    long int r, repeat;
+    double started, seconds, best;
+
+    repeat = 1;
+    for (;;) {
+        started = monotonic_seconds();
+        for (r = 0; r < repeat; ++r)
+            kernel->run(kernel);
+        seconds = monotonic_seconds() - started;
+        if (seconds >= MIN_TRIAL_SECONDS)
+            break;
+        repeat *= 2;
+    }
+    best = seconds / repeat;
+    for (trial = 1; trial < TRIALS; ++trial) {
+        started = monotonic_seconds();
+        for (r = 0; r < repeat; ++r)
+            kernel->run(kernel);
+        seconds = (monotonic_seconds() - started) / repeat;
+        if (seconds < best)
+            best = seconds;
+    }
+    return best;
+}
+
+/*
+ * the kernels
+ */
+static void
+run_dot_product(
+    Kernel *kernel
+) {
+    kernel->sink += dot_product(kernel->x, kernel->y, kernel->n);
+}
+
+static void
+run_update_step_vector(
+    Kernel *kernel
+) {
+    update_step_vector(kernel->z, kernel->x, 1.e-3, kernel->y, kernel->n);
+    kernel->sink += kernel->z[0];
+}
+
+static void
+run_manhattan_norm(
+    Kernel *kernel
+) {
+    kernel->sink += manhattan_norm(kernel->x, kernel->n);
+}
+
+static void
+run_euclidean_norm(
+    Kernel *kernel
+) {
+    kernel->sink += euclidean_norm(kernel->x, kernel->n);
+}
+
+static void
+run_infinity_norm(
+    Kernel *kernel
+) {
+    kernel->sink += infinity_norm(kernel->x, kernel->n);
+}
+
+static void
+run_triad(
+    Kernel *kernel
+) {
+    int i;
+    for (i = 0; i < kernel->n; ++i)
+        kernel->z[i] = kernel->x[i] + 1.e-3 * kernel->y[i];
+    kernel->sink += kernel->z[0];
+}
+
+/*
+ * one sweep of SOR: epsilon is large enough that the first sweep ends it
+ */
+static void
+run_sor_sweep(
+    Kernel *kernel
+) {
+    int sweeps;
+    successive_over_relaxation_sweeps(kernel->a, kernel->z, kernel->y,
+            kernel->n, 1.e300, 0.5, &sweeps);
+    kernel->sink += kernel->z[0];
+}
+
+static void
+run_bfgs_matrix_vector(
+    Kernel *kernel
+) {
+    NonLinearComponent component;
+
+    component.statistics = NULL;
+    direction_search_bfgs_H_formula(
+            kernel->z, kernel->a, kernel->y, NULL, kernel->n, &component);
+    kernel->sink += kernel->z[0];
+}
+
+/*
+ * H already satisfies the secant condition H y = s, so that the update
+ * leaves it (numerically) as it is and can be repeated
+ */
+static void
+run_bfgs_H_update(
+    Kernel *kernel
+) {
+    update_matrix_bfgs_H_formula(
+            kernel->a, kernel->x, kernel->y, kernel->z, kernel->n);
+    kernel->sink += kernel->a[0][0];
+}
+
+static void
+run_bfgs_B_update(
+    Kernel *kernel
+) {
+    update_matrix_bfgs_B_formula(
+            kernel->a, kernel->x, kernel->y, kernel->z, kernel->n);
+    kernel->sink += kernel->a[0][0];
+}
+
+static double flop_1n(int n) { return n; }
+static double flop_2n(int n) { return 2. * n; }
+static double flop_2n2(int n) { return 2. * n * n; }
+static double flop_8n2(int n) { return 8. * n * n; }
+static double flop_10n2(int n) { return 10. * n * n; }
+static double byte_8n(int n) { return 8. * n; }
+static double byte_16n(int n) { return 16. * n; }
+static double byte_24n(int n) { return 24. * n; }
+static double byte_8n2(int n) { return 8. * n * n; }
+static double byte_24n2(int n) { return 24. * n * n; }
+
+static Kernel kernels[] = {
+    {"dot_product", 'v', run_dot_product, flop_2n, byte_16n},
+    {"update_step_vector", 'v', run_update_step_vector, flop_2n, byte_24n},
+    {"manhattan_norm", 'v', run_manhattan_norm, flop_1n, byte_8n},
+    {"euclidean_norm", 'v', run_euclidean_norm, flop_2n, byte_8n},
+    {"infinity_norm", 'v', run_infinity_norm, flop_1n, byte_8n},
+    {"sor_sweep", 'm', run_sor_sweep, flop_2n2, byte_8n2},
+    {"bfgs_matrix_vector", 'm', run_bfgs_matrix_vector, flop_2n2, byte_8n2},
+    {"bfgs_H_update", 'm', run_bfgs_H_update, flop_10n2, byte_24n2},
+    {"bfgs_B_update", 'm', run_bfgs_B_update, flop_8n2, byte_24n2},
+};
+
+static const int num_kernels = sizeof(kernels) / sizeof(Kernel);
+
+/*
+ * GFLOP/s of independent multiply-adds in registers, two doubles wide
+ * (the widest the flags of the Makefile let the compiler use)
+ */
+typedef double PeakLane __attribute__((vector_size(16)));
+
+static double
+measure_peak_gflops(
+    void
+) {
+    int k, trial;
+    long int r, repeat = 1 << 20;
+    double started, seconds, gflops, best = 0., sink = 0.;
+    PeakLane acc[PEAK_ACCUMULATORS];
+    const PeakLane a = {0.999999, 0.999999}, b = {1.e-7, 1.e-7};
+
+    for (trial = 0; trial < TRIALS; ++trial) {
+        for (k = 0; k < PEAK_ACCUMULATORS; ++k)
+            acc[k] = (PeakLane){1. + k * 1.e-3, 1. - k * 1.e-3};
+        started = monotonic_seconds();
+        for (r = 0; r < repeat; ++r) {
+            for (k = 0; k < PEAK_ACCUMULATORS; ++k)
+                acc[k] = acc[k] * a + b;
+        }
+        seconds = monotonic_seconds() - started;
+        for (k = 0; k < PEAK_ACCUMULATORS; ++k)
+            sink += acc[k][0] + acc[k][1];
+        gflops = 4. * PEAK_ACCUMULATORS * repeat / seconds * 1.e-9;
+        if (gflops > best)
+            best = gflops;
+    }
+    return sink != sink ? 0. : best;
+}
+
+static const char *
+residency(
+    double working_set
+) {
+    long int l1, l2, l3;
+
+    l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (l1 > 0 && working_set <= l1)
+        return "L1";
+    if (l2 > 0 && working_set <= l2)
+        return "L2";
+    if (l3 > 0 && working_set <= l3)
+        return "L3";
+    return l3 > 0 ? "DRAM" : "-";
+}
+
+static void
+set_matrix(
+    Kernel *kernel
+) {
+    int i, j, n = kernel->n;
+
+    for (i = 0; i < n; ++i) {
+        kernel->a[i] = *kernel->a + (long int)i * n;
+        for (j = 0; j < n; ++j)
+            kernel->a[i][j] = 0.;
+        /* diagonally dominant for SOR; H = I and y = s for the updates */
+        kernel->a[i][i] = 1.;
+        kernel->x[i] = kernel->y[i] = 1. / (i + 1.);
+        kernel->z[i] = 0.;
+    }
+}
+
+int
+main(
+    int argc,
+    char **argv
+) {
+    int i, k, n, option, max_vector, max_matrix;
+    long int l3;
+    double peak, bandwidth, seconds, gflops, gbytes, roof, intensity;
+    const char *path = NULL;
+    FILE *csv = NULL;
+    Kernel triad, *kernel;
+
+    l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    l3 = l3 > 0 ? l3 : 32L << 20;
+    /* vectors and matrices well beyond the last level cache */
+    for (max_vector = 1 << 8; max_vector < (1 << 26)
+            && 16. * max_vector < 4. * l3; max_vector <<= 1)
+        ;
+    for (max_matrix = 16; max_matrix < 16384
+            && 8. * max_matrix * max_matrix < 2. * l3; max_matrix <<= 1)
+        ;
+    while (-1 != (option = getopt(argc, argv, "v:m:o:"))) {
+        switch (option) {
+            case 'v':
+                max_vector = atoi(optarg);
+                break;
+            case 'm':
+                max_matrix = atoi(optarg);
+                break;
+            case 'o':
+                path = optarg;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-v max_vector_n] "
+                        "[-m max_matrix_n] [-o csv]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (NULL != path && NULL == (csv = fopen(path, "w"))) {
+        perror(path);
+        return 1;
+    }
+
+    /* the roofs of this machine */
+    memset(&triad, 0, sizeof(triad));
+    triad.run = run_triad;
+    triad.n = max_vector;
+    triad.x = (double *)malloc(sizeof(double) * max_vector);
+    triad.y = (double *)malloc(sizeof(double) * max_vector);
+    triad.z = (double *)malloc(sizeof(double) * max_vector);
+    if (NULL == triad.x || NULL == triad.y || NULL == triad.z) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (i = 0; i < max_vector; ++i) {
+        triad.x[i] = triad.y[i] = 1.;
+        triad.z[i] = 0.;
+    }
+    bandwidth = 24. * max_vector / time_kernel(&triad) * 1.e-9;
+    peak = measure_peak_gflops();
+    printf("bandwidth (triad, n = %d): %.2f GB/s\n", max_vector, bandwidth);
+    printf("peak (multiply-add):       %.2f GFLOP/s\n", peak);
+    printf("ridge point:               %.2f flop/byte\n\n", peak / bandwidth);
+    printf("%-20s %9s %-4s %10s %9s %9s %7s\n", "kernel", "n", "in",
+            "ns/elem", "GFLOP/s", "GB/s", "roof");
+    if (NULL != csv) {
+        fprintf(csv, "kernel,n,residency,ns_per_element,gflops,gbytes,"
+                "roofline_fraction,bandwidth,peak_gflops\n");
+    }
+
+    for (k = 0; k < num_kernels; ++k) {
+        kernel = &kernels[k];
+        kernel->x = triad.x;
+        kernel->y = triad.y;
+        kernel->z = triad.z;
+        if ('v' == kernel->shape) {
+            for (n = 1 << 8; n <= max_vector; n <<= 1) {
+                kernel->n = n;
+                for (i = 0; i < n; ++i)
+                    kernel->x[i] = kernel->y[i] = 1. / (i + 1.);
+                seconds = time_kernel(kernel);
+                gflops = kernel->flop(n) / seconds * 1.e-9;
+                gbytes = kernel->byte(n) / seconds * 1.e-9;
+                intensity = kernel->flop(n) / kernel->byte(n);
+                roof = intensity * bandwidth < peak
+                    ? intensity * bandwidth : peak;
+                printf("%-20s %9d %-4s %10.3f %9.3f %9.2f %6.0f%%\n",
+                        kernel->name, n, residency(kernel->byte(n)),
+                        seconds / n * 1.e9, gflops, gbytes,
+                        100. * gflops / roof);
+                if (NULL != csv) {
+                    fprintf(csv, "%s,%d,%s,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g\n",
+                            kernel->name, n, residency(kernel->byte(n)),
+                            seconds / n * 1.e9, gflops, gbytes,
+                            gflops / roof, bandwidth, peak);
+                }
+            }
+        } else {
+            for (n = 16; n <= max_matrix; n <<= 1) {
+                kernel->n = n;
+                kernel->a = (double **)malloc(sizeof(double *) * n);
+                if (NULL == kernel->a || NULL == (*kernel->a
+                            = (double *)malloc(sizeof(double) * n * n))) {
+                    fprintf(stderr, "out of memory at n = %d\n", n);
+                    free(kernel->a);
+                    break;
+                }
+                set_matrix(kernel);
+                seconds = time_kernel(kernel);
+                gflops = kernel->flop(n) / seconds * 1.e-9;
+                gbytes = kernel->byte(n) / seconds * 1.e-9;
+                intensity = kernel->flop(n) / kernel->byte(n);
+                roof = intensity * bandwidth < peak
+                    ? intensity * bandwidth : peak;
+                printf("%-20s %9d %-4s %10.3f %9.3f %9.2f %6.0f%%\n",
+                        kernel->name, n, residency(8. * n * n),
+                        seconds / ((double)n * n) * 1.e9, gflops, gbytes,
+                        100. * gflops / roof);
+                if (NULL != csv) {
+                    fprintf(csv, "%s,%d,%s,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g\n",
+                            kernel->name, n, residency(8. * n * n),
+                            seconds / ((double)n * n) * 1.e9, gflops,
+                            gbytes, gflops / roof, bandwidth, peak);
+                }
+                free(*kernel->a);
+                free(kernel->a);
+            }
+        }
+        if (kernel->sink != kernel->sink)
+            printf("(%s produced NaN)\n", kernel->name);
+    }
+    if (NULL != csv)
+        fclose(csv);
+    free(triad.x);
+    free(triad.y);
+    free(triad.z);
+    return 0;
+}
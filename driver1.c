@@ -26,6 +26,7 @@
 #endif
 #include "src/include/non_linear_component.h"
 #include "src/include/line_search_component.h"
+#include "src/include/print_message.h"
 
 #define __LINE_SEARCH_METHOD 4
 #if __LINE_SEARCH_METHOD == 1
@@ -41,16 +42,17 @@
 #endif
 
 static double
-function(const double *x, int n);
+function(const double *x, int n, void *user);
 
 static void
-gradient(double *g, const double *x, int n);
+gradient(double *g, const double *x, int n, void *user);
 
 int
 main(int argc, char* argv[]) {
     int i, n;
     double *x, **b;
     FunctionObject Function;
+    SolverObserver observer;
     LineSearchParameter line_search_parameter;
     QuasiNewtonParameter quasi_newton_parameter;
 
@@ -64,6 +66,9 @@ main(int argc, char* argv[]) {
     b[0][0] = 1.;   b[0][1] = -2.;
     b[1][0] = -2.;  b[1][1] = 6.;
 
+    default_function_object(&Function);
+    initialize_print_observer(&observer, SOLVER_VERBOSITY_ITERATION);
+    Function.observer = &observer;
     Function.function = function;
     Function.gradient = gradient;
 #ifdef OPTIMIZATION_LINE_SEARCH_ARMIJO_H
@@ -154,12 +159,12 @@ main(int argc, char* argv[]) {
 }
 
 static double
-function(const double *x, int n) {
+function(const double *x, int n, void *user) {
     return (x[0] - x[1] * x[1]) * (x[0] - x[1] * x[1]) + (x[1] - 2.) * (x[1] - 2.) / 2.;
 }
 
 static void
-gradient(double *g, const double *x, int n) {
+gradient(double *g, const double *x, int n, void *user) {
     g[0] = x[0] - x[1] * x[1];
     g[1] = -2. * x[1] * (x[0] - x[1] * x[1]) + x[1] - 2.;
 }
@@ -19,6 +19,7 @@
 
 #include "src/include/quasi_newton.h"
 #include "src/include/line_search_component.h"
+#include "src/include/print_message.h"
 #include "src/include/non_linear_component.h"
 
 #define __LINE_SEARCH_METHOD 4
@@ -35,16 +36,17 @@
 #endif
 
 static double
-function(const double *x, int n);
+function(const double *x, int n, void *user);
 
 static void
-gradient(double *g, const double *x, int n);
+gradient(double *g, const double *x, int n, void *user);
 
 int
 main(int argc, char* argv[]) {
     int i, n;
     double *x;
     FunctionObject Function;
+    SolverObserver observer;
     LineSearchParameter line_search_parameter;
 
     n = 100;
@@ -52,6 +54,9 @@ main(int argc, char* argv[]) {
 
     for (i = 0; i < n; ++i) x[i] = 1.;
 
+    default_function_object(&Function);
+    initialize_print_observer(&observer, SOLVER_VERBOSITY_ITERATION);
+    Function.observer = &observer;
     Function.function = function;
     Function.gradient = gradient;
 #ifdef OPTIMIZATION_LINE_SEARCH_ARMIJO_H
@@ -115,7 +120,7 @@ main(int argc, char* argv[]) {
 }
 
 static double
-function(const double *x, int n) {
+function(const double *x, int n, void *user) {
     int i;
     double f = 0.;
     for (i = 0; i < n; ++i) {
@@ -125,7 +130,7 @@ function(const double *x, int n) {
 }
 
 static void
-gradient(double *g, const double *x, int n) {
+gradient(double *g, const double *x, int n, void *user) {
     int i;
     for (i = 0; i < n; ++i) {
         g[i] = exp(x[i]) - sqrt(i + 1.);
@@ -15,6 +15,7 @@
 
 #include "src/include/quasi_newton.h"
 #include "src/include/line_search_component.h"
+#include "src/include/print_message.h"
 #include "src/include/non_linear_component.h"
 
 #define __LINE_SEARCH_METHOD 4
@@ -31,16 +32,17 @@
 #endif
 
 static double
-function(const double *x, int n);
+function(const double *x, int n, void *user);
 
 static void
-gradient(double *g, const double *x, int n);
+gradient(double *g, const double *x, int n, void *user);
 
 int
 main(int argc, char* argv[]) {
     int i, n;
     double *x;
     FunctionObject Function;
+    SolverObserver observer;
     LineSearchParameter line_search_parameter;
 
     n = 10;
@@ -48,6 +50,9 @@ main(int argc, char* argv[]) {
 
     for (i = 0; i < n; ++i) x[i] = 1.;
 
+    default_function_object(&Function);
+    initialize_print_observer(&observer, SOLVER_VERBOSITY_ITERATION);
+    Function.observer = &observer;
     Function.function = function;
     Function.gradient = gradient;
 #ifdef OPTIMIZATION_LINE_SEARCH_ARMIJO_H
@@ -111,7 +116,7 @@ main(int argc, char* argv[]) {
 }
 
 static double
-function(const double *x, int n) {
+function(const double *x, int n, void *user) {
     int i;
     double f = 0., temp;
     for (i = 0; i < n; ++i) {
@@ -127,7 +132,7 @@ function(const double *x, int n) {
 }
 
 static void
-gradient(double *g, const double *x, int n) {
+gradient(double *g, const double *x, int n, void *user) {
     int i, j;
     double temp;
     for (i = 0; i < n; ++i) {
@@ -3,7 +3,7 @@
  *
  * File:        driver5.c
  * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
- * Last Change: 08-Jul-2012.
+ * Last Change: 19-Oct-2026.
  *
  * Problem:     Schwefel function
  */
@@ -18,7 +18,9 @@
     #include "src/include/conjugate_gradient.h"
 #endif
 #include "src/include/line_search_component.h"
+#include "src/include/print_message.h"
 #include "src/include/non_linear_component.h"
+#include "src/include/forward_mode.h"
 
 #define __LINE_SEARCH_METHOD 4
 #if __LINE_SEARCH_METHOD == 1
@@ -34,16 +36,18 @@
 #endif
 
 static double
-function(const double *x, int n);
+function(const double *x, int n, void *user);
 
-static void
-gradient(double *g, const double *x, int n);
+static Dual
+dual_function(const Dual *x, int n, void *user);
 
 int
 main(int argc, char* argv[]) {
     int i, n;
     double *x;
     FunctionObject Function;
+    ForwardModeObject forward_mode;
+    SolverObserver observer;
     LineSearchParameter line_search_parameter;
 
     n = 10;
@@ -51,8 +55,14 @@ main(int argc, char* argv[]) {
 
     for (i = 0; i < n; ++i) x[i] = 1.;
 
-    Function.function = function;
-    Function.gradient = gradient;
+    default_function_object(&Function);
+    initialize_print_observer(&observer, SOLVER_VERBOSITY_ITERATION);
+    Function.observer = &observer;
+    /* the gradient is differentiated from dual_function */
+    forward_mode.function = function;
+    forward_mode.dual_function = dual_function;
+    forward_mode.user = NULL;
+    initialize_forward_mode(&Function, &forward_mode);
 #ifdef OPTIMIZATION_LINE_SEARCH_ARMIJO_H
     default_armijo_parameter(&line_search_parameter);
 #endif
@@ -130,7 +140,7 @@ main(int argc, char* argv[]) {
 }
 
 static double
-function(const double *x, int n) {
+function(const double *x, int n, void *user) {
     int i, j;
     double f = 0., temp;
     for (i = 0; i < n; ++i) {
@@ -142,18 +152,13 @@ function(const double *x, int n) {
     return f;
 }
 
-static void
-gradient(double *g, const double *x, int n) {
-    int i, j;
-    double temp;
+static Dual
+dual_function(const Dual *x, int n, void *user) {
+    int i;
+    Dual f = dual_constant(0.), temp = dual_constant(0.);
     for (i = 0; i < n; ++i) {
-        for (j = 0, temp = 0.; j < i; ++j) {
-            temp += (n - i) * x[i];
-        }
-        for (j = i; j < i; ++j) {
-            temp += (n - j) * x[i];
-        }
-        g[i] = 2 * temp;
+        temp = dual_add(temp, x[i]);
+        f = dual_add(f, dual_sqr(temp));
     }
+    return f;
 }
-
@@ -0,0 +1,102 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        driver8.c
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ *
+ * Problem:     partially separable objectives
+ *  1: sum[i=1 to n] {e^x_i - x_i * sqrt(i + 1)} (driver2), elements {x_i}
+ *  2: chained Rosenbrock
+ *      sum[i=1 to n-1] {100 (x_i+1 - x_i^2)^2 + (1 - x_i)^2},
+ *      elements {x_i, x_i+1}
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "src/include/partitioned_quasi_newton.h"
+#include "src/include/line_search_component.h"
+#include "src/include/print_message.h"
+#include "src/include/non_linear_component.h"
+#include "src/include/backtracking_wolfe.h"
+
+#define __PROBLEM 2
+
+static double
+function(const double *x, int n, int e, void *user);
+
+static void
+gradient(double *g, const double *x, int n, int e, void *user);
+
+int
+main(int argc, char* argv[]) {
+    int i, n, k, num_elements, *element_start, *index;
+    double *x;
+    PartiallySeparableObject object;
+    SolverObserver observer;
+    LineSearchParameter line_search_parameter;
+
+    n = 1000000;
+#if __PROBLEM == 1
+    num_elements = n;
+    k = 1;
+#else
+    num_elements = n - 1;
+    k = 2;
+#endif
+    x = (double *)malloc(sizeof(double) * n);
+    element_start = (int *)malloc(sizeof(int) * (num_elements + 1));
+    index = (int *)malloc(sizeof(int) * num_elements * k);
+    if (NULL == x || NULL == element_start || NULL == index)
+        return 1;
+
+    for (i = 0; i < n; ++i) x[i] = __PROBLEM == 1 ? 1. : -1.2;
+    for (i = 0; i <= num_elements; ++i) element_start[i] = k * i;
+    for (i = 0; i < num_elements * k; ++i) index[i] = i / k + i % k;
+
+    initialize_print_observer(&observer, SOLVER_VERBOSITY_RESULT);
+    object.num_elements = num_elements;
+    object.element_start = element_start;
+    object.index = index;
+    object.function = function;
+    object.gradient = gradient;
+    object.user = NULL;
+    object.observer = &observer;
+    default_backtracking_wolfe_parameter(&line_search_parameter);
+
+    partitioned_quasi_newton(
+            x,
+            n,
+            &object,
+            backtracking_wolfe,
+            &line_search_parameter,
+            NULL
+    );
+
+    free(x);
+    free(element_start);
+    free(index);
+
+    return 0;
+}
+
+static double
+function(const double *x, int n, int e, void *user) {
+#if __PROBLEM == 1
+    return exp(x[0]) - x[0] * sqrt(e + 1.);
+#else
+    return 100. * (x[1] - x[0] * x[0]) * (x[1] - x[0] * x[0])
+        + (1. - x[0]) * (1. - x[0]);
+#endif
+}
+
+static void
+gradient(double *g, const double *x, int n, int e, void *user) {
+#if __PROBLEM == 1
+    g[0] = exp(x[0]) - sqrt(e + 1.);
+#else
+    g[0] = -400. * x[0] * (x[1] - x[0] * x[0]) - 2. * (1. - x[0]);
+    g[1] = 200. * (x[1] - x[0] * x[0]);
+#endif
+}
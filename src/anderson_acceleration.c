@@ -0,0 +1,527 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        anderson_acceleration.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/anderson_acceleration.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/mymath.h"
+
+static const char method_name[] = "Anderson Acceleration";
+
+/*
+ * iteration map wrapped by the accelerator: gx = G(x)
+ */
+typedef int (*iteration_map_t)(
+    double *,
+    const double *,
+    int,
+    void *
+);
+
+typedef struct _GradientStep {
+    double step;
+    double *g;
+    void    (*projection)(double *, int);
+    EvaluateObject *evaluate_object;
+    NonLinearComponent *component;
+} GradientStep;
+
+static void
+default_anderson_parameter(
+    AndersonParameter *parameter
+);
+
+static int
+anderson_iteration(
+    double *x,
+    int n,
+    iteration_map_t map,
+    void *closure,
+    GradientStep *gradient_step,
+    AndersonParameter *parameter,
+    NonLinearComponent *component
+);
+
+static void
+restart_anderson_accelerator(
+    AndersonAccelerator *accelerator
+);
+
+static int
+fixed_point_map(
+    double *gx,
+    const double *x,
+    int n,
+    void *closure
+);
+
+static int
+gradient_step_map(
+    double *gx,
+    const double *x,
+    int n,
+    void *closure
+);
+
+static void
+append_column(
+    AndersonAccelerator *accelerator,
+    const double *df,
+    const double *dg
+);
+
+static void
+delete_first_column(
+    AndersonAccelerator *accelerator
+);
+
+int
+initialize_anderson_accelerator(
+    AndersonAccelerator *accelerator,
+    int n,
+    int memory,
+    double beta
+) {
+    /* Q, dG (memory * n), f_old, g_old, work (3 * n), R (memory * memory)
+     * and gamma (memory) share one block of memory */
+    accelerator->n = n;
+    accelerator->memory = memory;
+    accelerator->k = 0;
+    accelerator->iteration = 0;
+    accelerator->beta = beta;
+    if (NULL == (accelerator->q = (double *)malloc(sizeof(double)
+                    * (2 * memory * n + 3 * n + memory * memory + memory)))) {
+        return MY_MATH_OUT_OF_MEMORY;
+    }
+    accelerator->dg = accelerator->q + memory * n;
+    accelerator->f_old = accelerator->dg + memory * n;
+    accelerator->g_old = accelerator->f_old + n;
+    accelerator->work = accelerator->g_old + n;
+    accelerator->r = accelerator->work + n;
+    accelerator->gamma = accelerator->r + memory * memory;
+    return MY_MATH_SATISFIED;
+}
+
+int
+anderson_accelerate(
+    AndersonAccelerator *accelerator,
+    double *x,
+    const double *gx
+) {
+    /*
+     * f_k = G(x_k) - x_k
+     * gamma = argmin || f_k - dF * gamma || = R^-1 Q^T f_k
+     * x_k+1 = G(x_k) - dG * gamma - (1 - beta) * (f_k - dF * gamma)
+     */
+    int i, j, n, m, k;
+    double temp, *f, *df, *qtf;
+
+    n = accelerator->n;
+    m = accelerator->memory;
+    f = accelerator->work;
+    df = accelerator->f_old;
+    for (i = 0; i < n; ++i) {
+        f[i] = gx[i] - x[i];
+        if (f[i] != f[i])
+            return MY_MATH_FUNCTION_NAN;
+    }
+    if (accelerator->iteration > 0) {
+        /* df = f_k - f_k-1 and dg = G(x_k) - G(x_k-1) are stored over
+         * f_old and g_old */
+        for (i = 0; i < n; ++i) {
+            df[i] = f[i] - df[i];
+            accelerator->g_old[i] = gx[i] - accelerator->g_old[i];
+        }
+        if (accelerator->k == m)
+            delete_first_column(accelerator);
+        append_column(accelerator, df, accelerator->g_old);
+    }
+    accelerator->iteration++;
+    memcpy(accelerator->f_old, f, sizeof(double) * n);
+    memcpy(accelerator->g_old, gx, sizeof(double) * n);
+
+    k = accelerator->k;
+    qtf = accelerator->gamma;
+    for (j = 0; j < k; ++j) {
+        qtf[j] = dot_product(accelerator->q + j * n, f, n);
+    }
+    /* f = f - Q Q^T f is the residual of the least squares */
+    for (j = 0; j < k; ++j) {
+        update_step_vector(f, f, -qtf[j], accelerator->q + j * n, n);
+    }
+    /* back substitution R gamma = Q^T f */
+    for (i = k - 1; i >= 0; --i) {
+        for (j = i + 1, temp = qtf[i]; j < k; ++j) {
+            temp -= accelerator->r[i * m + j] * qtf[j];
+        }
+        qtf[i] = temp / accelerator->r[i * m + i];
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = gx[i] - (1. - accelerator->beta) * f[i];
+    }
+    for (j = 0; j < k; ++j) {
+        update_step_vector(x, x, -qtf[j], accelerator->dg + j * n, n);
+    }
+    for (i = 0; i < n; ++i) {
+        if (x[i] != x[i])
+            return MY_MATH_FUNCTION_NAN;
+    }
+    return MY_MATH_SATISFIED;
+}
+
+void
+release_anderson_accelerator(
+    AndersonAccelerator *accelerator
+) {
+    if (NULL != accelerator->q) {
+        free(accelerator->q);
+        accelerator->q = NULL;
+    }
+}
+
+int
+anderson_fixed_point(
+    double *x,
+    int n,
+    FixedPointObject *fixed_point_object,
+    AndersonParameter *anderson_parameter
+) {
+    int status;
+    NonLinearComponent component;
+    EvaluateObject evaluate_object;
+    AndersonParameter _anderson_parameter;
+
+    if (NULL == fixed_point_object->map) {
+        return NON_LINEAR_NO_FUNCTION;
+    }
+    initialize_non_linear_component(
+            method_name, NULL, &evaluate_object, &component);
+    attach_observer(fixed_point_object->observer, &component);
+    if (NULL == anderson_parameter) {
+        anderson_parameter = &_anderson_parameter;
+        memset(anderson_parameter, 0, sizeof(AndersonParameter));
+    }
+    default_anderson_parameter(anderson_parameter);
+
+    status = anderson_iteration(x, n, fixed_point_map, fixed_point_object,
+            NULL, anderson_parameter, &component);
+    return status;
+}
+
+int
+anderson_gradient_descent(
+    double *x,
+    int n,
+    FunctionObject *function_object,
+    AndersonParameter *anderson_parameter
+) {
+    int status;
+    NonLinearComponent component;
+    EvaluateObject evaluate_object;
+    AndersonParameter _anderson_parameter;
+    GradientStep gradient_step;
+
+    if (NULL == function_object->function) {
+        return NON_LINEAR_NO_FUNCTION;
+    }
+    initialize_non_linear_component(
+            method_name, function_object, &evaluate_object, &component);
+    if (NULL == anderson_parameter) {
+        anderson_parameter = &_anderson_parameter;
+        memset(anderson_parameter, 0, sizeof(AndersonParameter));
+    }
+    default_anderson_parameter(anderson_parameter);
+
+    if (NULL == (gradient_step.g = (double *)malloc(sizeof(double) * n))) {
+        return NON_LINEAR_OUT_OF_MEMORY;
+    }
+    gradient_step.step = anderson_parameter->step;
+    gradient_step.projection = anderson_parameter->projection;
+    gradient_step.evaluate_object = &evaluate_object;
+    gradient_step.component = &component;
+
+    status = anderson_iteration(x, n, gradient_step_map, &gradient_step,
+            &gradient_step, anderson_parameter, &component);
+
+    free(gradient_step.g);
+    return status;
+}
+
+static void
+default_anderson_parameter(
+    AndersonParameter *parameter
+) {
+    parameter->memory = parameter->memory > 0 ? parameter->memory : 5;
+    parameter->beta =
+        parameter->beta > 0. && parameter->beta <= 1. ? parameter->beta : 1.;
+    parameter->step = parameter->step > 0. ? parameter->step : 1.;
+    parameter->tolerance =
+        parameter->tolerance > lower_eps ? parameter->tolerance : lower_eps;
+    parameter->upper_iter = parameter->upper_iter > lower_iteration
+        && parameter->upper_iter < upper_iteration
+        ? parameter->upper_iter : upper_iteration;
+}
+
+/*
+ * Safeguard: an accelerated iterate is kept only when it does not increase
+ * f of a gradient step, or the residual of a fixed-point map, over that of
+ * the last iterate kept. Otherwise the window is restarted from the plain
+ * G(x) of that iterate. A plain gradient step which increases f is retried
+ * with the step halved, which restarts the window too since G changes.
+ */
+static int
+anderson_iteration(
+    double *x,
+    int n,
+    iteration_map_t map,
+    void *closure,
+    GradientStep *gradient_step,
+    AndersonParameter *parameter,
+    NonLinearComponent *component
+) {
+    int i, iter, status, accelerated, rejected;
+    double r_norm, r_kept, f_kept, temp,
+           *gx, *x_kept, *gx_kept, *g_kept;
+    AndersonAccelerator accelerator;
+
+    iter = 0;
+    if (NULL == (gx = (double *)malloc(sizeof(double) * 4 * n))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    x_kept = gx + n;
+    gx_kept = x_kept + n;
+    g_kept = gx_kept + n;
+    if (MY_MATH_SATISFIED != initialize_anderson_accelerator(
+                &accelerator, n, parameter->memory, parameter->beta)) {
+        free(gx);
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    accelerated = 0;
+    r_kept = f_kept = HUGE_VAL;
+    for (iter = 1; iter <= parameter->upper_iter; ++iter) {
+        /* compute infinity-norm of residual G(x) - x */
+        r_norm = NAN;
+        if (NON_LINEAR_FUNCTION_OBJECT_NAN != map(gx, x, n, closure)) {
+            for (i = 0, r_norm = 0.; i < n; ++i) {
+                temp = fabs(gx[i] - x[i]);
+                if (temp != temp) {
+                    r_norm = temp;
+                    break;
+                }
+                if (temp > r_norm)
+                    r_norm = temp;
+            }
+        }
+        /* the residual of a gradient step is scaled by 1 / step so that
+         * the tolerance is measured against the (projected) gradient */
+        if (NULL != gradient_step) {
+            r_norm /= gradient_step->step;
+            rejected = !(component->f <= f_kept);
+        } else {
+            rejected = !(r_norm <= r_kept);
+        }
+        if (r_norm != r_norm)
+            rejected = 1;
+
+        if (rejected && accelerated) {
+            restart_anderson_accelerator(&accelerator);
+            memcpy(x, gx_kept, sizeof(double) * n);
+            accelerated = 0;
+            continue;
+        }
+        if (rejected && 1 < iter && NULL != gradient_step) {
+            gradient_step->step *= .5;
+            if (gradient_step->step < lower_eps * lower_eps) {
+                memcpy(x, x_kept, sizeof(double) * n);
+                status = NON_LINEAR_FAILED;
+                goto release;
+            }
+            restart_anderson_accelerator(&accelerator);
+            update_step_vector(x, x_kept, -gradient_step->step, g_kept, n);
+            if (NULL != gradient_step->projection)
+                gradient_step->projection(x, n);
+            memcpy(gx_kept, x, sizeof(double) * n);
+            continue;
+        }
+        if (r_norm != r_norm) {
+            status = NON_LINEAR_FUNCTION_NAN;
+            goto release;
+        }
+        memcpy(x_kept, x, sizeof(double) * n);
+        memcpy(gx_kept, gx, sizeof(double) * n);
+        r_kept = r_norm;
+        if (NULL != gradient_step) {
+            memcpy(g_kept, gradient_step->g, sizeof(double) * n);
+            f_kept = component->f;
+        }
+
+        if (observe_iteration(iter, r_norm, component)) {
+            status = NON_LINEAR_STOPPED;
+            goto release;
+        }
+
+        if (r_norm < parameter->tolerance) {
+            memcpy(x, gx, sizeof(double) * n);
+            status = NON_LINEAR_SATISFIED;
+            goto release;
+        }
+        /* an extrapolation to Not a Number is replaced by G(x); with an
+         * empty window the step is the plain (mixed) one */
+        if (MY_MATH_SATISFIED != anderson_accelerate(&accelerator, x, gx)) {
+            restart_anderson_accelerator(&accelerator);
+            memcpy(x, gx, sizeof(double) * n);
+        }
+        accelerated = accelerator.k > 0;
+    }
+    status = NON_LINEAR_NO_CONVERGENCE;
+release:
+    release_anderson_accelerator(&accelerator);
+    free(gx);
+result:
+    observe_result(status, iter, component);
+    return status;
+}
+
+static void
+restart_anderson_accelerator(
+    AndersonAccelerator *accelerator
+) {
+    accelerator->k = 0;
+    accelerator->iteration = 0;
+}
+
+static int
+fixed_point_map(
+    double *gx,
+    const double *x,
+    int n,
+    void *closure
+) {
+    int i;
+    FixedPointObject *fixed_point_object = (FixedPointObject *)closure;
+
+    fixed_point_object->map(gx, x, n, fixed_point_object->user);
+    for (i = 0; i < n; ++i) {
+        if (gx[i] != gx[i])
+            return NON_LINEAR_FUNCTION_OBJECT_NAN;
+    }
+    return NON_LINEAR_FUNCTION_OBJECT_SATISFIED;
+}
+
+static int
+gradient_step_map(
+    double *gx,
+    const double *x,
+    int n,
+    void *closure
+) {
+    /*
+     * G(x) = P(x - step * gf(x))
+     */
+    GradientStep *gradient_step = (GradientStep *)closure;
+
+    if (NON_LINEAR_FUNCTION_OBJECT_NAN
+            == gradient_step->evaluate_object->function_gradient(
+                gradient_step->g, x, n, gradient_step->component))
+        return NON_LINEAR_FUNCTION_OBJECT_NAN;
+    update_step_vector(gx, x, -gradient_step->step, gradient_step->g, n);
+    if (NULL != gradient_step->projection)
+        gradient_step->projection(gx, n);
+    gradient_step->component->alpha = gradient_step->step;
+    return NON_LINEAR_FUNCTION_OBJECT_SATISFIED;
+}
+
+static void
+append_column(
+    AndersonAccelerator *accelerator,
+    const double *df,
+    const double *dg
+) {
+    /*
+     * modified Gram-Schmidt: df = Q r + r_kk q_k
+     */
+    int j, n, m, k;
+    double r_kk, df_norm, *q_k;
+
+    n = accelerator->n;
+    m = accelerator->memory;
+    k = accelerator->k;
+    q_k = accelerator->q + k * n;
+    df_norm = euclidean_norm(df, n);
+    memcpy(q_k, df, sizeof(double) * n);
+    for (j = 0; j < k; ++j) {
+        accelerator->r[j * m + k] = dot_product(accelerator->q + j * n, q_k, n);
+        update_step_vector(q_k, q_k, -accelerator->r[j * m + k],
+                accelerator->q + j * n, n);
+    }
+    r_kk = euclidean_norm(q_k, n);
+    /* df is (nearly) dependent on the columns kept: drop it */
+    if (r_kk <= 1.e-12 * df_norm || 0. == r_kk)
+        return;
+    for (j = 0; j < n; ++j) {
+        q_k[j] /= r_kk;
+    }
+    accelerator->r[k * m + k] = r_kk;
+    memcpy(accelerator->dg + k * n, dg, sizeof(double) * n);
+    accelerator->k++;
+}
+
+static void
+delete_first_column(
+    AndersonAccelerator *accelerator
+) {
+    /*
+     * Removing the first column leaves R upper Hessenberg. The subdiagonal
+     * is annihilated by Givens rotations which are applied to Q as well.
+     */
+    int i, j, l, n, m, k;
+    double a, b, c, s, h, t1, t2, *q_i, *q_j, *r;
+
+    n = accelerator->n;
+    m = accelerator->memory;
+    k = accelerator->k;
+    r = accelerator->r;
+    for (i = 0; i < k - 1; ++i) {
+        a = r[i * m + i + 1];
+        b = r[(i + 1) * m + i + 1];
+        h = sqrt(a * a + b * b);
+        c = a / h;
+        s = b / h;
+        r[i * m + i + 1] = h;
+        r[(i + 1) * m + i + 1] = 0.;
+        for (j = i + 2; j < k; ++j) {
+            t1 = r[i * m + j];
+            t2 = r[(i + 1) * m + j];
+            r[i * m + j] = c * t1 + s * t2;
+            r[(i + 1) * m + j] = -s * t1 + c * t2;
+        }
+        q_i = accelerator->q + i * n;
+        q_j = q_i + n;
+        for (l = 0; l < n; ++l) {
+            t1 = q_i[l];
+            t2 = q_j[l];
+            q_i[l] = c * t1 + s * t2;
+            q_j[l] = -s * t1 + c * t2;
+        }
+    }
+    for (i = 0; i < k - 1; ++i) {
+        for (j = i; j < k - 1; ++j) {
+            r[i * m + j] = r[i * m + j + 1];
+        }
+    }
+    memmove(accelerator->dg, accelerator->dg + n, sizeof(double) * n * (k - 1));
+    accelerator->k--;
+}
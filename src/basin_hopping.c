@@ -0,0 +1,273 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        basin_hopping.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/basin_hopping.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/mymath.h"
+
+static void
+default_basin_hopping_parameter(
+    BasinHoppingParameter *parameter
+);
+
+static int
+local_solve(
+    double *x,
+    double **b,
+    int n,
+    FunctionObject *function_object,
+    BasinHoppingParameter *parameter
+);
+
+static int
+is_local_minimum(
+    int status
+);
+
+static double
+uniform_random(
+    unsigned int *state
+);
+
+int
+basin_hopping(
+    double *x,
+    double **b,
+    int n,
+    FunctionObject *function_object,
+    BasinHoppingParameter *basin_hopping_parameter,
+    BasinHoppingResult *basin_hopping_result
+) {
+    int i, hop, status, local_status, num_accepted, num_improved, stall;
+    long int memory_size;
+    double f_current, f_trial, f_best,
+           *storage, **storage_b, *x_current, *x_trial, *x_best, *b_accepted;
+    unsigned int state;
+
+    memory_size = sizeof(double) * n;
+    storage = NULL;
+    storage_b = NULL;
+    hop = num_accepted = num_improved = 0;
+    f_best = HUGE_VAL;
+
+    /* make sure that f of this problem exists (gf may be differenced) */
+    if (NULL == function_object->function) {
+        return NON_LINEAR_NO_FUNCTION;
+    }
+    if (NULL == basin_hopping_parameter
+            || NULL == basin_hopping_parameter->line_search
+            || NULL == basin_hopping_parameter->line_search_parameter) {
+        return NON_LINEAR_NO_PARAMETER;
+    }
+    default_basin_hopping_parameter(basin_hopping_parameter);
+
+    /*
+     * allocate memory to storage
+     *  vector: x_current, x_trial and x_best
+     *  matrix: b of the accepted minimum, and b itself if it is not given
+     */
+    if (NULL == (storage = (double *)malloc(memory_size * (3 + 2 * n)))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    x_current = storage;
+    x_trial = x_current + n;
+    x_best = x_trial + n;
+    b_accepted = x_best + n;
+    if ('q' == basin_hopping_parameter->solver && NULL == b) {
+        if (NULL == (storage_b = (double **)malloc(sizeof(double *) * n))) {
+            status = NON_LINEAR_OUT_OF_MEMORY;
+            goto result;
+        }
+        storage_b[0] = b_accepted + n * n;
+        for (i = 1; i < n; ++i) {
+            storage_b[i] = storage_b[i - 1] + n;
+        }
+        for (i = 0; i < n * n; ++i) {
+            storage_b[0][i] = 0.;
+        }
+        for (i = 0; i < n; ++i) {
+            storage_b[i][i] = 1.;
+        }
+        b = storage_b;
+    }
+
+    /* the first local solve is a cold one */
+    memcpy(x_current, x, memory_size);
+    local_status = local_solve(x_current, b, n, function_object,
+            basin_hopping_parameter);
+    f_current = function_object->function(
+            x_current, n, function_object->user);
+    if (!is_local_minimum(local_status) || f_current != f_current) {
+        status = is_local_minimum(local_status)
+            ? NON_LINEAR_FUNCTION_NAN : local_status;
+        goto result;
+    }
+    f_best = f_current;
+    memcpy(x_best, x_current, memory_size);
+    if (NULL != b) {
+        for (i = 0; i < n; ++i) {
+            memcpy(b_accepted + i * n, b[i], memory_size);
+        }
+    }
+
+    /*
+     * start to hop between minima
+     */
+    state = basin_hopping_parameter->seed;
+    stall = 0;
+    for (hop = 1; hop <= basin_hopping_parameter->num_hops; ++hop) {
+        for (i = 0; i < n; ++i) {
+            x_trial[i] = x_current[i] + basin_hopping_parameter->step
+                * (2. * uniform_random(&state) - 1.);
+        }
+        /* warm start: b still holds the matrix of the previous solve */
+        local_status = local_solve(x_trial, b, n, function_object,
+                basin_hopping_parameter);
+        f_trial = function_object->function(
+                x_trial, n, function_object->user);
+        if (!is_local_minimum(local_status) || f_trial != f_trial) {
+            /* the matrix of a broken solve is not reused */
+            if (NULL != b) {
+                for (i = 0; i < n; ++i) {
+                    memcpy(b[i], b_accepted + i * n, memory_size);
+                }
+            }
+            stall++;
+        } else {
+            if (f_trial < f_current || ('m' == basin_hopping_parameter->
+                        acceptance && uniform_random(&state) < exp(-(f_trial
+                                - f_current) / basin_hopping_parameter->
+                            temperature))) {
+                memcpy(x_current, x_trial, memory_size);
+                f_current = f_trial;
+                if (NULL != b) {
+                    for (i = 0; i < n; ++i) {
+                        memcpy(b_accepted + i * n, b[i], memory_size);
+                    }
+                }
+                num_accepted++;
+            }
+            if (f_trial < f_best) {
+                memcpy(x_best, x_trial, memory_size);
+                f_best = f_trial;
+                num_improved++;
+                stall = 0;
+            } else {
+                stall++;
+            }
+        }
+        if (basin_hopping_parameter->stall > 0
+                && stall >= basin_hopping_parameter->stall) {
+            break;
+        }
+    }
+    hop = hop > basin_hopping_parameter->num_hops
+        ? basin_hopping_parameter->num_hops : hop;
+    memcpy(x, x_best, memory_size);
+    status = NON_LINEAR_SATISFIED;
+result:
+    if (NULL != basin_hopping_result) {
+        basin_hopping_result->f = f_best;
+        basin_hopping_result->num_hops = hop;
+        basin_hopping_result->num_accepted = num_accepted;
+        basin_hopping_result->num_improved = num_improved;
+    }
+
+    /* release memory of storage and storage_b */
+    if (NULL != storage_b) {
+        free(storage_b);
+        storage_b = NULL;
+    }
+    if (NULL != storage) {
+        free(storage);
+        storage = NULL;
+    }
+
+    return status;
+}
+
+static void
+default_basin_hopping_parameter(
+    BasinHoppingParameter *parameter
+) {
+    parameter->acceptance =
+        'd' == parameter->acceptance || 'D' == parameter->acceptance
+        ? 'd' : 'm';
+    parameter->solver =
+        'c' == parameter->solver || 'C' == parameter->solver ? 'c' : 'q';
+    parameter->num_hops =
+        parameter->num_hops > 0 ? parameter->num_hops : 100;
+    parameter->stall = parameter->stall > 0 ? parameter->stall : 0;
+    parameter->step = parameter->step > 0. ? parameter->step : .5;
+    parameter->temperature =
+        parameter->temperature > 0. ? parameter->temperature : 1.;
+    parameter->seed = parameter->seed ? parameter->seed : 2463534242u;
+}
+
+static int
+local_solve(
+    double *x,
+    double **b,
+    int n,
+    FunctionObject *function_object,
+    BasinHoppingParameter *parameter
+) {
+    QuasiNewtonParameter quasi_newton_parameter;
+    ConjugateGradientParameter conjugate_gradient_parameter;
+    LineSearchParameter line_search_parameter;
+
+    /* solvers write the default values back into their parameter */
+    line_search_parameter = *parameter->line_search_parameter;
+    if ('c' == parameter->solver) {
+        if (NULL != parameter->conjugate_gradient_parameter) {
+            conjugate_gradient_parameter =
+                *parameter->conjugate_gradient_parameter;
+        } else {
+            memset(&conjugate_gradient_parameter, 0,
+                    sizeof(ConjugateGradientParameter));
+        }
+        return conjugate_gradient(x, n, function_object,
+                parameter->line_search, &line_search_parameter,
+                &conjugate_gradient_parameter);
+    }
+    if (NULL != parameter->quasi_newton_parameter) {
+        quasi_newton_parameter = *parameter->quasi_newton_parameter;
+    } else {
+        memset(&quasi_newton_parameter, 0, sizeof(QuasiNewtonParameter));
+    }
+    return quasi_newton(x, b, n, function_object, parameter->line_search,
+            &line_search_parameter, &quasi_newton_parameter);
+}
+
+static int
+is_local_minimum(
+    int status
+) {
+    return NON_LINEAR_SATISFIED == status
+        || NON_LINEAR_LINE_SEARCH_FAILED == status
+        || NON_LINEAR_NO_CONVERGENCE == status;
+}
+
+static double
+uniform_random(
+    unsigned int *state
+) {
+    /* xorshift32 in [0, 1) */
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return (double)*state / 4294967296.;
+}
@@ -0,0 +1,413 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        batch_quasi_newton.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/batch_quasi_newton.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Every vector is stored as structure-of-arrays: the i-th element of lane l
+ * is v[i * lanes + l], and the (i, j) element of H of lane l is
+ * h[(i * n + j) * lanes + l]. The arithmetic runs over the lanes in the
+ * innermost loop, so that it is vectorized; the lanes which must not change
+ * are masked by zero coefficients or by a select.
+ */
+
+enum BatchLaneState {
+    BATCH_LANE_IDLE = 0,
+    BATCH_LANE_LOAD,
+    BATCH_LANE_SEARCH,
+};
+
+static void
+default_batch_quasi_newton_parameter(
+    BatchQuasiNewtonParameter *parameter
+);
+
+static void
+load_lane(
+    double *xs,
+    double *x_temp,
+    double *h,
+    const double *x,
+    int l,
+    int n,
+    int lanes
+);
+
+static void
+reset_lane_matrix(
+    double *h,
+    int l,
+    int n,
+    int lanes
+);
+
+int
+batch_quasi_newton(
+    double *x,
+    int n,
+    int num_problems,
+    BatchFunctionObject *batch_function_object,
+    BatchQuasiNewtonParameter *batch_quasi_newton_parameter,
+    int *status,
+    int *iteration
+) {
+    int i, j, l, lanes, next, num_active, result_status, lane_status,
+        index[BATCH_LANES_MAX], state[BATCH_LANES_MAX],
+        active[BATCH_LANES_MAX], lane_iter[BATCH_LANES_MAX],
+        backtrack[BATCH_LANES_MAX], finish[BATCH_LANES_MAX],
+        lane_result[BATCH_LANES_MAX];
+    double f[BATCH_LANES_MAX], f_temp[BATCH_LANES_MAX],
+           alpha[BATCH_LANES_MAX], slope[BATCH_LANES_MAX],
+           update[BATCH_LANES_MAX], accept[BATCH_LANES_MAX],
+           direction[BATCH_LANES_MAX], search[BATCH_LANES_MAX],
+           sy[BATCH_LANES_MAX], yy[BATCH_LANES_MAX], yhy[BATCH_LANES_MAX],
+           rho[BATCH_LANES_MAX], scale[BATCH_LANES_MAX],
+           coefficient[BATCH_LANES_MAX], g_norm[BATCH_LANES_MAX],
+           *storage, *xs, *g, *d, *x_temp, *g_temp, *s, *y, *hy, *h;
+    BatchQuasiNewtonParameter _batch_quasi_newton_parameter;
+
+    storage = NULL;
+
+    /* make sure that f and gf of this problem exist */
+    if (NULL == batch_function_object
+            || NULL == batch_function_object->function_gradient) {
+        return NON_LINEAR_NO_FUNCTION;
+    }
+
+    /* set the parameter of batch Quasi-Newton method */
+    if (NULL == batch_quasi_newton_parameter) {
+        batch_quasi_newton_parameter = &_batch_quasi_newton_parameter;
+        memset(batch_quasi_newton_parameter, 0,
+                sizeof(BatchQuasiNewtonParameter));
+    }
+    default_batch_quasi_newton_parameter(batch_quasi_newton_parameter);
+    lanes = batch_quasi_newton_parameter->lanes;
+
+    /*
+     * allocate memory to storage
+     *  vector: x, g, d, x_temp, g_temp, s, y and Hy of all lanes
+     *  matrix: H of all lanes
+     */
+    if (NULL == (storage = (double *)malloc(sizeof(double)
+                    * lanes * n * (8 + n)))) {
+        return NON_LINEAR_OUT_OF_MEMORY;
+    }
+    xs = storage;
+    g = xs + n * lanes;
+    d = g + n * lanes;
+    x_temp = d + n * lanes;
+    g_temp = x_temp + n * lanes;
+    s = g_temp + n * lanes;
+    y = s + n * lanes;
+    hy = y + n * lanes;
+    h = hy + n * lanes;
+    for (i = 0; i < lanes * n * (8 + n); ++i) {
+        storage[i] = 0.;
+    }
+
+    /* fill the lanes with the first problems */
+    result_status = NON_LINEAR_SATISFIED;
+    for (l = 0, next = 0; l < lanes; ++l) {
+        if (next < num_problems) {
+            index[l] = next;
+            load_lane(xs, x_temp, h, x + next * n, l, n, lanes);
+            state[l] = BATCH_LANE_LOAD;
+            lane_iter[l] = 0;
+            next++;
+        } else {
+            state[l] = BATCH_LANE_IDLE;
+        }
+        f[l] = f_temp[l] = 0.;
+    }
+
+    /*
+     * start to compute for solving these problems
+     */
+    for (num_active = next; num_active > 0; ) {
+        for (l = 0; l < lanes; ++l) {
+            active[l] = BATCH_LANE_IDLE != state[l];
+        }
+        batch_function_object->function_gradient(
+                f_temp, g_temp, x_temp, active, n, lanes,
+                batch_function_object->user);
+
+        /* Armijo condition of each lane */
+        for (l = 0; l < lanes; ++l) {
+            finish[l] = 0;
+            update[l] = accept[l] = direction[l] = 0.;
+            if (BATCH_LANE_LOAD == state[l]) {
+                accept[l] = 1.;
+                f[l] = f_temp[l];
+            } else if (BATCH_LANE_SEARCH == state[l]) {
+                if (f_temp[l] == f_temp[l] && f_temp[l]
+                        <= f[l] + batch_quasi_newton_parameter->xi
+                        * alpha[l] * slope[l]) {
+                    update[l] = accept[l] = 1.;
+                    f[l] = f_temp[l];
+                } else if (++backtrack[l]
+                        > batch_quasi_newton_parameter->line_search_iter) {
+                    finish[l] = 1;
+                    lane_result[l] = NON_LINEAR_LINE_SEARCH_FAILED;
+                } else {
+                    alpha[l] *= batch_quasi_newton_parameter->decreasing;
+                }
+            }
+        }
+
+        /* s = x_temp - x and y = g_temp - g of the accepted lanes */
+        for (l = 0; l < lanes; ++l) {
+            sy[l] = yy[l] = yhy[l] = 0.;
+        }
+        for (i = 0; i < n; ++i) {
+#pragma omp simd
+            for (l = 0; l < lanes; ++l) {
+                s[i * lanes + l] = update[l] > 0.
+                    ? x_temp[i * lanes + l] - xs[i * lanes + l] : 0.;
+                y[i * lanes + l] = update[l] > 0.
+                    ? g_temp[i * lanes + l] - g[i * lanes + l] : 0.;
+                sy[l] += s[i * lanes + l] * y[i * lanes + l];
+                yy[l] += y[i * lanes + l] * y[i * lanes + l];
+            }
+        }
+        /* the update is skipped unless s^T y > 0; H_0 is scaled by
+         * s^T y / y^T y before the first update */
+        for (l = 0; l < lanes; ++l) {
+            if (update[l] > 0. && sy[l] > 1.e-12 * yy[l] && yy[l] > 0.) {
+                rho[l] = 1. / sy[l];
+                scale[l] = 0 == lane_iter[l] ? sy[l] / yy[l] : 1.;
+            } else {
+                rho[l] = 0.;
+                scale[l] = 1.;
+            }
+        }
+        /* Hy = scale * H y */
+        for (i = 0; i < n; ++i) {
+#pragma omp simd
+            for (l = 0; l < lanes; ++l) {
+                hy[i * lanes + l] = 0.;
+            }
+            for (j = 0; j < n; ++j) {
+#pragma omp simd
+                for (l = 0; l < lanes; ++l) {
+                    hy[i * lanes + l] += h[(i * n + j) * lanes + l]
+                        * y[j * lanes + l];
+                }
+            }
+#pragma omp simd
+            for (l = 0; l < lanes; ++l) {
+                hy[i * lanes + l] *= scale[l];
+                yhy[l] += y[i * lanes + l] * hy[i * lanes + l];
+            }
+        }
+        /* H = scale * H - rho (s Hy^T + Hy s^T) + (rho^2 y^T Hy + rho) s s^T
+         * which leaves H as it is where rho = 0 and scale = 1 */
+#pragma omp simd
+        for (l = 0; l < lanes; ++l) {
+            coefficient[l] = rho[l] * rho[l] * yhy[l] + rho[l];
+        }
+        for (i = 0; i < n; ++i) {
+            for (j = 0; j < n; ++j) {
+#pragma omp simd
+                for (l = 0; l < lanes; ++l) {
+                    h[(i * n + j) * lanes + l] =
+                        scale[l] * h[(i * n + j) * lanes + l]
+                        - rho[l] * (s[i * lanes + l] * hy[j * lanes + l]
+                                + hy[i * lanes + l] * s[j * lanes + l])
+                        + coefficient[l] * s[i * lanes + l]
+                        * s[j * lanes + l];
+                }
+            }
+        }
+
+        /* move the accepted lanes to x_temp and compute ||g||_infinity */
+        for (l = 0; l < lanes; ++l) {
+            g_norm[l] = 0.;
+        }
+        for (i = 0; i < n; ++i) {
+#pragma omp simd
+            for (l = 0; l < lanes; ++l) {
+                xs[i * lanes + l] = accept[l] > 0.
+                    ? x_temp[i * lanes + l] : xs[i * lanes + l];
+                g[i * lanes + l] = accept[l] > 0.
+                    ? g_temp[i * lanes + l] : g[i * lanes + l];
+                g_norm[l] = fabs(g[i * lanes + l]) > g_norm[l]
+                    || g[i * lanes + l] != g[i * lanes + l]
+                    ? fabs(g[i * lanes + l]) : g_norm[l];
+            }
+        }
+
+        /* stopping criteria of each lane */
+        for (l = 0; l < lanes; ++l) {
+            if (accept[l] <= 0.)
+                continue;
+            if (update[l] > 0.)
+                lane_iter[l]++;
+            if (f[l] != f[l] || g_norm[l] != g_norm[l]) {
+                finish[l] = 1;
+                lane_result[l] = NON_LINEAR_FUNCTION_NAN;
+            } else if (g_norm[l] < batch_quasi_newton_parameter->tolerance) {
+                finish[l] = 1;
+                lane_result[l] = NON_LINEAR_SATISFIED;
+            } else if (lane_iter[l]
+                    >= batch_quasi_newton_parameter->upper_iter) {
+                finish[l] = 1;
+                lane_result[l] = NON_LINEAR_NO_CONVERGENCE;
+            } else {
+                direction[l] = 1.;
+            }
+        }
+
+        /* d = -H g of the lanes which need a new direction */
+        for (l = 0; l < lanes; ++l) {
+            slope[l] = direction[l] > 0. ? 0. : slope[l];
+        }
+        for (i = 0; i < n; ++i) {
+#pragma omp simd
+            for (l = 0; l < lanes; ++l) {
+                hy[i * lanes + l] = 0.;
+            }
+            for (j = 0; j < n; ++j) {
+#pragma omp simd
+                for (l = 0; l < lanes; ++l) {
+                    hy[i * lanes + l] -= h[(i * n + j) * lanes + l]
+                        * g[j * lanes + l];
+                }
+            }
+#pragma omp simd
+            for (l = 0; l < lanes; ++l) {
+                d[i * lanes + l] = direction[l] > 0.
+                    ? hy[i * lanes + l] : d[i * lanes + l];
+                slope[l] += direction[l] > 0.
+                    ? g[i * lanes + l] * d[i * lanes + l] : 0.;
+            }
+        }
+        for (l = 0; l < lanes; ++l) {
+            if (direction[l] <= 0.)
+                continue;
+            /* H has lost positive definiteness: restart with d = -g */
+            if (!(slope[l] < 0.)) {
+                reset_lane_matrix(h, l, n, lanes);
+                for (i = 0, slope[l] = 0.; i < n; ++i) {
+                    d[i * lanes + l] = -g[i * lanes + l];
+                    slope[l] -= g[i * lanes + l] * g[i * lanes + l];
+                }
+            }
+            alpha[l] = 1.;
+            backtrack[l] = 0;
+            state[l] = BATCH_LANE_SEARCH;
+        }
+
+        /* x_temp = x + alpha * d of the searching lanes */
+        for (l = 0; l < lanes; ++l) {
+            search[l] = BATCH_LANE_SEARCH == state[l] ? 1. : 0.;
+        }
+        for (i = 0; i < n; ++i) {
+#pragma omp simd
+            for (l = 0; l < lanes; ++l) {
+                x_temp[i * lanes + l] = search[l] > 0.
+                    ? xs[i * lanes + l] + alpha[l] * d[i * lanes + l]
+                    : x_temp[i * lanes + l];
+            }
+        }
+
+        /* a finished lane exits and takes the next problem */
+        for (l = 0; l < lanes; ++l) {
+            if (!finish[l])
+                continue;
+            lane_status = lane_result[l];
+            for (i = 0; i < n; ++i) {
+                x[index[l] * n + i] = xs[i * lanes + l];
+            }
+            if (NULL != status)
+                status[index[l]] = lane_status;
+            if (NULL != iteration)
+                iteration[index[l]] = lane_iter[l];
+            if (NON_LINEAR_SATISFIED != lane_status)
+                result_status = NON_LINEAR_FAILED;
+            if (next < num_problems) {
+                index[l] = next;
+                load_lane(xs, x_temp, h, x + next * n, l, n, lanes);
+                state[l] = BATCH_LANE_LOAD;
+                lane_iter[l] = 0;
+                next++;
+            } else {
+                state[l] = BATCH_LANE_IDLE;
+                num_active--;
+            }
+        }
+    }
+
+    /* release memory of storage */
+    if (NULL != storage) {
+        free(storage);
+        storage = NULL;
+    }
+
+    return result_status;
+}
+
+static void
+default_batch_quasi_newton_parameter(
+    BatchQuasiNewtonParameter *parameter
+) {
+    parameter->lanes = parameter->lanes > 0
+        && parameter->lanes <= BATCH_LANES_MAX ? parameter->lanes : 8;
+    parameter->tolerance =
+        parameter->tolerance > lower_eps ? parameter->tolerance : lower_eps;
+    parameter->upper_iter = parameter->upper_iter > lower_iteration
+        && parameter->upper_iter < upper_iteration
+        ? parameter->upper_iter : upper_iteration;
+    parameter->xi = parameter->xi > 0. && parameter->xi < 1.
+        ? parameter->xi : 1.e-4;
+    parameter->decreasing =
+        parameter->decreasing > 0. && parameter->decreasing < 1.
+        ? parameter->decreasing : .5;
+    parameter->line_search_iter = parameter->line_search_iter > 0
+        ? parameter->line_search_iter : 30;
+}
+
+static void
+load_lane(
+    double *xs,
+    double *x_temp,
+    double *h,
+    const double *x,
+    int l,
+    int n,
+    int lanes
+) {
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        xs[i * lanes + l] = x_temp[i * lanes + l] = x[i];
+    }
+    reset_lane_matrix(h, l, n, lanes);
+}
+
+static void
+reset_lane_matrix(
+    double *h,
+    int l,
+    int n,
+    int lanes
+) {
+    int i, j;
+
+    for (i = 0; i < n; ++i) {
+        for (j = 0; j < n; ++j) {
+            h[(i * n + j) * lanes + l] = i == j ? 1. : 0.;
+        }
+    }
+}
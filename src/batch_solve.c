@@ -0,0 +1,477 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        batch_solve.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "include/batch_solve.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define BATCH_SOLVE_CACHE_LINE 64
+
+/*
+ * Each worker owns a range [begin, end) of job indices packed into one
+ * word, begin in the lower and end in the upper 32 bits. The owner takes
+ * jobs from the front and a thief takes the back half, both with CAS; a
+ * range only shrinks until its owner runs dry and installs a stolen one.
+ */
+typedef struct _BatchWorker {
+    unsigned long long range;
+    char padding[BATCH_SOLVE_CACHE_LINE - sizeof(unsigned long long)];
+    int id;
+    int cpu;
+    long int num_steals;
+    SolverContext context;
+    pthread_t thread;
+    struct _BatchShared *shared;
+} BatchWorker;
+
+typedef struct _BatchShared {
+    SolveJob *job;
+    int num_jobs;
+    int num_workers;
+    BatchWorker *worker;
+} BatchShared;
+
+static void
+default_batch_solve_parameter(
+    BatchSolveParameter *parameter
+);
+
+static void *
+batch_worker(
+    void *argument
+);
+
+static int
+pop_job(
+    BatchWorker *worker
+);
+
+static int
+steal_jobs(
+    BatchWorker *worker
+);
+
+static void
+run_job(
+    SolveJob *job,
+    BatchWorker *worker
+);
+
+static int
+reserve_context(
+    BatchWorker *worker,
+    char solver,
+    int n,
+    int m
+);
+
+static void
+pin_thread(
+    pthread_t thread,
+    int cpu
+);
+
+static int
+compare_double(
+    const void *a,
+    const void *b
+);
+
+static double
+elapsed_seconds(
+    const struct timespec *begin,
+    const struct timespec *end
+);
+
+int
+batch_solve(
+    SolveJob *job,
+    int num_jobs,
+    BatchSolveParameter *batch_solve_parameter,
+    BatchSolveStatistics *batch_solve_statistics
+) {
+    int i, status, num_workers, num_satisfied;
+    unsigned long long begin, end;
+    double seconds, *latency;
+    struct timespec time_begin, time_end;
+    BatchWorker *worker;
+    BatchShared shared;
+    BatchSolveParameter _batch_solve_parameter;
+#ifdef __linux__
+    int num_allowed;
+    cpu_set_t allowed, caller;
+#endif
+
+    worker = NULL;
+    latency = NULL;
+
+    if (NULL == job || num_jobs <= 0) {
+        return NON_LINEAR_NO_PARAMETER;
+    }
+    /* set the parameter of the batch */
+    if (NULL == batch_solve_parameter) {
+        batch_solve_parameter = &_batch_solve_parameter;
+        memset(batch_solve_parameter, 0, sizeof(BatchSolveParameter));
+    }
+    default_batch_solve_parameter(batch_solve_parameter);
+    num_workers = batch_solve_parameter->num_threads < num_jobs
+        ? batch_solve_parameter->num_threads : num_jobs;
+
+    /*
+     * allocate memory to storage
+     *  worker: the workers aligned to cache lines
+     *  latency: wall time of each job for the percentiles
+     */
+    if (0 != posix_memalign((void **)&worker, BATCH_SOLVE_CACHE_LINE,
+                sizeof(BatchWorker) * num_workers)) {
+        worker = NULL;
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    if (NULL == (latency = (double *)malloc(sizeof(double) * num_jobs))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    shared.job = job;
+    shared.num_jobs = num_jobs;
+    shared.num_workers = num_workers;
+    shared.worker = worker;
+
+    /* static partition as the start; the tail is balanced by stealing */
+    for (i = 0; i < num_workers; ++i) {
+        begin = (unsigned long long)num_jobs * i / num_workers;
+        end = (unsigned long long)num_jobs * (i + 1) / num_workers;
+        worker[i].range = begin | (end << 32);
+        worker[i].id = i;
+        worker[i].cpu = -1;
+        worker[i].num_steals = 0;
+        worker[i].context.arena = NULL;
+        worker[i].context.capacity = 0;
+        worker[i].shared = &shared;
+    }
+#ifdef __linux__
+    if (NULL != batch_solve_parameter->cpu) {
+        for (i = 0; i < num_workers; ++i) {
+            worker[i].cpu = batch_solve_parameter->cpu[i];
+        }
+    } else if ('c' == batch_solve_parameter->affinity
+            && 0 == sched_getaffinity(0, sizeof(cpu_set_t), &allowed)) {
+        num_allowed = 0;
+        for (i = 0; i < CPU_SETSIZE && num_allowed < num_workers; ++i) {
+            if (CPU_ISSET(i, &allowed))
+                worker[num_allowed++].cpu = i;
+        }
+    }
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &caller);
+#endif
+
+    /*
+     * start to solve the jobs; the calling thread is worker 0
+     */
+    clock_gettime(CLOCK_MONOTONIC, &time_begin);
+    worker[0].thread = pthread_self();
+    for (i = 1; i < num_workers; ++i) {
+        /* the range of a worker which fails to start is stolen */
+        if (0 != pthread_create(&worker[i].thread, NULL, batch_worker,
+                    &worker[i])) {
+            worker[i].thread = worker[0].thread;
+        }
+    }
+    batch_worker(&worker[0]);
+    for (i = 1; i < num_workers; ++i) {
+        if (!pthread_equal(worker[i].thread, worker[0].thread))
+            pthread_join(worker[i].thread, NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &time_end);
+    seconds = elapsed_seconds(&time_begin, &time_end);
+#ifdef __linux__
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &caller);
+#endif
+
+    for (i = 0, num_satisfied = 0; i < num_jobs; ++i) {
+        latency[i] = job[i].seconds;
+        if (NON_LINEAR_SATISFIED == job[i].status)
+            num_satisfied++;
+    }
+    qsort(latency, num_jobs, sizeof(double), compare_double);
+    if (NULL != batch_solve_statistics) {
+        batch_solve_statistics->num_jobs = num_jobs;
+        batch_solve_statistics->num_satisfied = num_satisfied;
+        batch_solve_statistics->num_threads = num_workers;
+        batch_solve_statistics->num_steals = 0;
+        for (i = 0; i < num_workers; ++i) {
+            batch_solve_statistics->num_steals += worker[i].num_steals;
+        }
+        batch_solve_statistics->seconds = seconds;
+        batch_solve_statistics->solves_per_second =
+            seconds > 0. ? num_jobs / seconds : 0.;
+        batch_solve_statistics->latency_p50 =
+            latency[(num_jobs - 1) / 2];
+        batch_solve_statistics->latency_p99 =
+            latency[(99 * num_jobs + 99) / 100 - 1];
+    }
+    status = num_satisfied == num_jobs
+        ? NON_LINEAR_SATISFIED : NON_LINEAR_FAILED;
+result:
+    /* release memory of workspaces, worker and latency */
+    if (NULL != worker) {
+        for (i = 0; i < num_workers; ++i) {
+            release_solver_context(&worker[i].context);
+        }
+        free(worker);
+        worker = NULL;
+    }
+    if (NULL != latency) {
+        free(latency);
+        latency = NULL;
+    }
+
+    return status;
+}
+
+static void
+default_batch_solve_parameter(
+    BatchSolveParameter *parameter
+) {
+    long int num_processors;
+
+    num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    parameter->num_threads = parameter->num_threads > 0
+        ? parameter->num_threads : num_processors > 0 ? num_processors : 1;
+    parameter->affinity =
+        'c' == parameter->affinity || 'C' == parameter->affinity ? 'c' : 'n';
+}
+
+static void *
+batch_worker(
+    void *argument
+) {
+    int index;
+    BatchWorker *worker = (BatchWorker *)argument;
+#ifdef _OPENMP
+    /* the calling thread is worker 0 and gets its own setting back */
+    int num_omp_threads = omp_get_max_threads();
+
+    /* the workers already occupy the processors; a solver's parallel
+     * region would only oversubscribe them */
+    omp_set_num_threads(1);
+#endif
+
+    if (worker->cpu >= 0)
+        pin_thread(pthread_self(), worker->cpu);
+    for ( ; ; ) {
+        while ((index = pop_job(worker)) >= 0) {
+            run_job(&worker->shared->job[index], worker);
+        }
+        /* jobs are never added, so no victim means that all are taken */
+        if (!steal_jobs(worker))
+            break;
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(num_omp_threads);
+#endif
+    return NULL;
+}
+
+static int
+pop_job(
+    BatchWorker *worker
+) {
+    unsigned long long range, begin, end;
+
+    range = __atomic_load_n(&worker->range, __ATOMIC_ACQUIRE);
+    do {
+        begin = range & 0xffffffffULL;
+        end = range >> 32;
+        if (begin >= end)
+            return -1;
+    } while (!__atomic_compare_exchange_n(&worker->range, &range,
+                (begin + 1) | (end << 32), 0,
+                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+    return (int)begin;
+}
+
+static int
+steal_jobs(
+    BatchWorker *worker
+) {
+    int i;
+    unsigned long long range, begin, end, middle;
+    BatchWorker *victim;
+    BatchShared *shared = worker->shared;
+
+    for (i = 1; i < shared->num_workers; ++i) {
+        victim = &shared->worker[(worker->id + i) % shared->num_workers];
+        range = __atomic_load_n(&victim->range, __ATOMIC_ACQUIRE);
+        for ( ; ; ) {
+            begin = range & 0xffffffffULL;
+            end = range >> 32;
+            if (begin >= end)
+                break;
+            /* take the back half, rounded up */
+            middle = begin + (end - begin) / 2;
+            if (__atomic_compare_exchange_n(&victim->range, &range,
+                        begin | (middle << 32), 0,
+                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                __atomic_store_n(&worker->range, middle | (end << 32),
+                        __ATOMIC_RELEASE);
+                worker->num_steals++;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static void
+run_job(
+    SolveJob *job,
+    BatchWorker *worker
+) {
+    struct timespec time_begin, time_end;
+    LineSearchParameter line_search_parameter;
+    QuasiNewtonParameter quasi_newton_parameter;
+    ConjugateGradientParameter conjugate_gradient_parameter;
+    TrustRegionParameter trust_region_parameter;
+    NelderMeadParameter nelder_mead_parameter;
+
+    clock_gettime(CLOCK_MONOTONIC, &time_begin);
+    /* solvers write the default values back into their parameter, so a
+     * job works on its own copy */
+    if (NULL != job->line_search_parameter)
+        line_search_parameter = *job->line_search_parameter;
+    if (NULL == job->function_object) {
+        job->status = NON_LINEAR_NO_FUNCTION;
+    } else if (('q' == job->solver || 'c' == job->solver)
+            && (NULL == job->line_search
+                || NULL == job->line_search_parameter)) {
+        job->status = NON_LINEAR_NO_PARAMETER;
+    } else if ('q' == job->solver) {
+        if (NULL != job->quasi_newton_parameter) {
+            quasi_newton_parameter = *job->quasi_newton_parameter;
+        } else {
+            memset(&quasi_newton_parameter, 0, sizeof(QuasiNewtonParameter));
+        }
+        job->status = reserve_context(worker, 'q', job->n, 0);
+        if (NON_LINEAR_SATISFIED == job->status) {
+            job->status = quasi_newton_with_context(&worker->context,
+                    job->x, NULL, job->n, job->function_object,
+                    job->line_search, &line_search_parameter,
+                    &quasi_newton_parameter);
+        }
+    } else if ('c' == job->solver) {
+        if (NULL != job->conjugate_gradient_parameter) {
+            conjugate_gradient_parameter = *job->conjugate_gradient_parameter;
+        } else {
+            memset(&conjugate_gradient_parameter, 0,
+                    sizeof(ConjugateGradientParameter));
+        }
+        job->status = reserve_context(worker, 'c', job->n, 0);
+        if (NON_LINEAR_SATISFIED == job->status) {
+            job->status = conjugate_gradient_with_context(&worker->context,
+                    job->x, job->n, job->function_object, job->line_search,
+                    &line_search_parameter, &conjugate_gradient_parameter);
+        }
+    } else if ('t' == job->solver) {
+        if (NULL != job->trust_region_parameter) {
+            trust_region_parameter = *job->trust_region_parameter;
+        } else {
+            memset(&trust_region_parameter, 0, sizeof(TrustRegionParameter));
+        }
+        /* 5 is the default memory of the limited memory formula */
+        job->status = reserve_context(worker, 't', job->n,
+                'l' == trust_region_parameter.formula
+                || 'L' == trust_region_parameter.formula
+                ? (trust_region_parameter.memory > 0
+                    ? trust_region_parameter.memory : 5) : 0);
+        if (NON_LINEAR_SATISFIED == job->status) {
+            job->status = trust_region_with_context(&worker->context,
+                    job->x, NULL, job->n, job->function_object,
+                    &trust_region_parameter);
+        }
+    } else if ('n' == job->solver) {
+        if (NULL != job->nelder_mead_parameter) {
+            nelder_mead_parameter = *job->nelder_mead_parameter;
+        } else {
+            memset(&nelder_mead_parameter, 0, sizeof(NelderMeadParameter));
+        }
+        job->status = nelder_mead(job->x, job->n, job->function_object,
+                &nelder_mead_parameter);
+    } else {
+        job->status = NON_LINEAR_NO_PARAMETER;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &time_end);
+    job->seconds = elapsed_seconds(&time_begin, &time_end);
+}
+
+static int
+reserve_context(
+    BatchWorker *worker,
+    char solver,
+    int n,
+    int m
+) {
+    /*
+     * The context of a worker is kept between jobs and is only made again
+     * when a job needs a larger arena.
+     */
+    if (solver_context_size(solver, n, m) <= worker->context.capacity)
+        return NON_LINEAR_SATISFIED;
+    release_solver_context(&worker->context);
+    return initialize_solver_context(&worker->context, solver, n, m);
+}
+
+static void
+pin_thread(
+    pthread_t thread,
+    int cpu
+) {
+#ifdef __linux__
+    cpu_set_t set;
+
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    /* pinning is a hint: a failure leaves the thread unpinned */
+    pthread_setaffinity_np(thread, sizeof(cpu_set_t), &set);
+#endif
+}
+
+static int
+compare_double(
+    const void *a,
+    const void *b
+) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+static double
+elapsed_seconds(
+    const struct timespec *begin,
+    const struct timespec *end
+) {
+    return (double)(end->tv_sec - begin->tv_sec)
+        + 1.e-9 * (end->tv_nsec - begin->tv_nsec);
+}
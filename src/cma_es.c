@@ -0,0 +1,633 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        cma_es.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/cma_es.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/mymath.h"
+
+#define CMA_ES_BLOCK 64
+
+static const char method_name[] = "CMA-ES";
+
+static void
+default_cma_es_parameter(
+    CMAESParameter *parameter,
+    int n
+);
+
+static double
+normal_random(
+    unsigned long long *state
+);
+
+static void
+evaluate_population(
+    double *f,
+    const double *x,
+    int n,
+    int lambda,
+    FunctionObject *function_object
+);
+
+static void
+sample_population(
+    double *y,
+    const double *dz,
+    double **b,
+    int n,
+    int lambda
+);
+
+static void
+update_covariance(
+    double **c,
+    const double *y,
+    const int *index,
+    const double *weight,
+    const double *pc,
+    double decay,
+    double c1,
+    double cmu,
+    int n,
+    int mu
+);
+
+static void
+symmetric_eigen(
+    double **v,
+    double *d,
+    double *e,
+    int n
+);
+
+int
+cma_es(
+    double *x,
+    int n,
+    FunctionObject *function_object,
+    CMAESParameter *cma_es_parameter
+) {
+    int i, j, k, iter, status, lambda, mu, eigen_interval, temp_index;
+    double sigma, mueff, cc, cs, c1, cmu, damps, chi_n, ps_norm, hsig,
+           decay, sum, max_d, f_best,
+           *storage, **storage_matrix, **c, **b,
+           *z, *y, *xs, *f, *weight, *mean, *mean_old, *pc, *ps, *d, *e,
+           *y_w, *temp, *x_best;
+    int *index;
+    unsigned long long state;
+    NonLinearComponent component;
+    CMAESParameter _cma_es_parameter;
+    EvaluateObject evaluate_object;
+
+    storage = NULL;
+    storage_matrix = NULL;
+    index = NULL;
+    iter = 0;
+    initialize_non_linear_component(
+            method_name, function_object, &evaluate_object, &component);
+
+    /* make sure that f of this problem exists: gf is not required */
+    if (NULL == function_object->function
+            && NULL == function_object->batch_function) {
+        status = NON_LINEAR_NO_FUNCTION;
+        goto result;
+    }
+
+    /* set the parameter of CMA-ES */
+    if (NULL == cma_es_parameter) {
+        cma_es_parameter = &_cma_es_parameter;
+        memset(cma_es_parameter, 0, sizeof(CMAESParameter));
+    }
+    default_cma_es_parameter(cma_es_parameter, n);
+    lambda = cma_es_parameter->lambda;
+    mu = lambda / 2;
+
+    /*
+     * allocate memory to storage
+     *  matrix: C and B (n * n each)
+     *  population: z, y and x (lambda * n each, one sample per row)
+     */
+    if (NULL == (storage_matrix = (double **)malloc(
+                    sizeof(double *) * 2 * n))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    if (NULL == (storage = (double *)malloc(sizeof(double)
+                    * (2 * n * n + 3 * lambda * n + 2 * lambda + 10 * n)))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    if (NULL == (index = (int *)malloc(sizeof(int) * lambda))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    c = storage_matrix;
+    b = c + n;
+    c[0] = storage;
+    b[0] = c[0] + n * n;
+    for (i = 1; i < n; ++i) {
+        c[i] = c[i - 1] + n;
+        b[i] = b[i - 1] + n;
+    }
+    z = b[0] + n * n;
+    y = z + lambda * n;
+    xs = y + lambda * n;
+    f = xs + lambda * n;
+    weight = f + lambda;
+    mean = weight + lambda;
+    mean_old = mean + n;
+    pc = mean_old + n;
+    ps = pc + n;
+    d = ps + n;
+    e = d + n;
+    y_w = e + n;
+    temp = y_w + n;
+    x_best = temp + n;
+
+    /* strategy parameters */
+    for (i = 0, sum = 0.; i < mu; ++i) {
+        weight[i] = log(mu + .5) - log(i + 1.);
+        sum += weight[i];
+    }
+    for (i = 0, mueff = 0.; i < mu; ++i) {
+        weight[i] /= sum;
+        mueff += weight[i] * weight[i];
+    }
+    mueff = 1. / mueff;
+    cc = (4. + mueff / n) / (n + 4. + 2. * mueff / n);
+    cs = (mueff + 2.) / (n + mueff + 5.);
+    c1 = 2. / ((n + 1.3) * (n + 1.3) + mueff);
+    cmu = 2. * (mueff - 2. + 1. / mueff) / ((n + 2.) * (n + 2.) + mueff);
+    cmu = cmu < 1. - c1 ? cmu : 1. - c1;
+    damps = 1. + cs + 2. * (sqrt((mueff - 1.) / (n + 1.)) > 1.
+            ? sqrt((mueff - 1.) / (n + 1.)) - 1. : 0.);
+    chi_n = sqrt((double)n) * (1. - 1. / (4. * n) + 1. / (21. * n * n));
+    eigen_interval = cma_es_parameter->eigen_interval > 0
+        ? cma_es_parameter->eigen_interval
+        : (int)(1. / (10. * n * (c1 + cmu)));
+    eigen_interval = eigen_interval > 0 ? eigen_interval : 1;
+
+    /* C = B = I, D = 1 */
+    for (i = 0; i < n; ++i) {
+        for (j = 0; j < n; ++j) {
+            c[i][j] = b[i][j] = 0.;
+        }
+        c[i][i] = b[i][i] = 1.;
+        d[i] = 1.;
+        pc[i] = ps[i] = 0.;
+        mean[i] = x_best[i] = x[i];
+    }
+    sigma = cma_es_parameter->sigma;
+    f_best = HUGE_VAL;
+    state = cma_es_parameter->seed;
+
+    /*
+     * start to compute for solving this problem
+     */
+    for (iter = 1; iter <= cma_es_parameter->upper_iter; ++iter) {
+        /* x_k = m + sigma * B D z_k */
+        for (k = 0; k < lambda * n; ++k) {
+            z[k] = normal_random(&state);
+            xs[k] = d[k % n] * z[k];
+        }
+        sample_population(y, xs, b, n, lambda);
+        for (k = 0; k < lambda; ++k) {
+            update_step_vector(xs + k * n, mean, sigma, y + k * n, n);
+        }
+        evaluate_population(f, xs, n, lambda, function_object);
+        component.iteration_f += lambda;
+
+        /* sort the population by f */
+        for (k = 0; k < lambda; ++k) {
+            index[k] = k;
+        }
+        for (k = 1; k < lambda; ++k) {
+            temp_index = index[k];
+            for (j = k - 1; j >= 0 && f[index[j]] > f[temp_index]; --j) {
+                index[j + 1] = index[j];
+            }
+            index[j + 1] = temp_index;
+        }
+        if (f[index[0]] < f_best) {
+            f_best = f[index[0]];
+            memcpy(x_best, xs + index[0] * n, sizeof(double) * n);
+        }
+
+        /* recombination: y_w = sum w_i y_i:lambda */
+        memcpy(mean_old, mean, sizeof(double) * n);
+        for (i = 0; i < n; ++i) {
+            y_w[i] = 0.;
+        }
+        for (k = 0; k < mu; ++k) {
+            update_step_vector(y_w, y_w, weight[k], y + index[k] * n, n);
+        }
+        update_step_vector(mean, mean_old, sigma, y_w, n);
+
+        /* cumulation: ps with C^-1/2 y_w = B D^-1 B^T y_w */
+        for (j = 0; j < n; ++j) {
+            for (i = 0, sum = 0.; i < n; ++i) {
+                sum += b[i][j] * y_w[i];
+            }
+            temp[j] = sum / d[j];
+        }
+        for (i = 0; i < n; ++i) {
+            sum = dot_product(b[i], temp, n);
+            ps[i] = (1. - cs) * ps[i] + sqrt(cs * (2. - cs) * mueff) * sum;
+        }
+        ps_norm = euclidean_norm(ps, n);
+        hsig = ps_norm / sqrt(1. - pow(1. - cs, 2. * iter)) / chi_n
+            < 1.4 + 2. / (n + 1.) ? 1. : 0.;
+        for (i = 0; i < n; ++i) {
+            pc[i] = (1. - cc) * pc[i]
+                + hsig * sqrt(cc * (2. - cc) * mueff) * y_w[i];
+        }
+
+        /* C = decay * C + c1 pc pc^T + cmu sum w_i y_i y_i^T */
+        decay = 1. - c1 - cmu + (1. - hsig) * c1 * cc * (2. - cc);
+        update_covariance(c, y, index, weight, pc, decay, c1, cmu, n, mu);
+
+        /* step size control */
+        sigma *= exp((cs / damps) * (ps_norm / chi_n - 1.));
+
+        /* lazy update of B and D from C = B D^2 B^T */
+        if (0 == iter % eigen_interval) {
+            for (i = 0; i < n; ++i) {
+                for (j = 0; j <= i; ++j) {
+                    b[i][j] = b[j][i] = c[i][j];
+                }
+            }
+            symmetric_eigen(b, d, e, n);
+            for (i = 0; i < n; ++i) {
+                d[i] = d[i] > 0. ? sqrt(d[i]) : sqrt(lower_eps * lower_eps);
+            }
+        }
+
+        for (i = 1, max_d = c[0][0]; i < n; ++i) {
+            if (c[i][i] > max_d)
+                max_d = c[i][i];
+        }
+        component.f = f_best;
+        component.alpha = sigma;
+
+        if (observe_iteration(iter, sigma * sqrt(max_d), &component)) {
+            status = NON_LINEAR_STOPPED;
+            goto result;
+        }
+
+        if (f_best != f_best) {
+            status = NON_LINEAR_FUNCTION_NAN;
+            goto result;
+        }
+        if (sigma * sqrt(max_d) < cma_es_parameter->tolerance) {
+            status = NON_LINEAR_SATISFIED;
+            goto result;
+        }
+    }
+    status = NON_LINEAR_NO_CONVERGENCE;
+result:
+    if (NULL != index) {
+        memcpy(x, x_best, sizeof(double) * n);
+    }
+    observe_result(status, iter, &component);
+
+    /* release memory of storage and index */
+    if (NULL != storage_matrix) {
+        free(storage_matrix);
+        storage_matrix = NULL;
+    }
+    if (NULL != storage) {
+        free(storage);
+        storage = NULL;
+    }
+    if (NULL != index) {
+        free(index);
+        index = NULL;
+    }
+
+    return status;
+}
+
+static void
+default_cma_es_parameter(
+    CMAESParameter *parameter,
+    int n
+) {
+    parameter->lambda = parameter->lambda > 3
+        ? parameter->lambda : 4 + (int)(3. * log((double)n));
+    parameter->sigma = parameter->sigma > 0. ? parameter->sigma : .5;
+    parameter->eigen_interval =
+        parameter->eigen_interval > 0 ? parameter->eigen_interval : 0;
+    parameter->tolerance =
+        parameter->tolerance > lower_eps ? parameter->tolerance : lower_eps;
+    parameter->upper_iter = parameter->upper_iter > lower_iteration
+        && parameter->upper_iter < upper_iteration
+        ? parameter->upper_iter : upper_iteration;
+    parameter->seed = parameter->seed ? parameter->seed : 2463534242u;
+}
+
+static double
+normal_random(
+    unsigned long long *state
+) {
+    /* xorshift64* and Box-Muller */
+    double u, v;
+
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    u = ((*state * 2685821657736338717ULL) >> 11) * (1. / 9007199254740992.);
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    v = ((*state * 2685821657736338717ULL) >> 11) * (1. / 9007199254740992.);
+    return sqrt(-2. * log(1. - u)) * cos(2. * 3.14159265358979323846 * v);
+}
+
+static void
+evaluate_population(
+    double *f,
+    const double *x,
+    int n,
+    int lambda,
+    FunctionObject *function_object
+) {
+    int k;
+
+    if (NULL != function_object->batch_function) {
+        function_object->batch_function(
+                f, x, n, lambda, function_object->user);
+    } else {
+#pragma omp parallel for schedule(dynamic, 1) \
+        if (function_object->thread_safe)
+        for (k = 0; k < lambda; ++k) {
+            f[k] = function_object->function(
+                    x + k * n, n, function_object->user);
+        }
+    }
+    /* Not a Number is regarded as +infinity */
+    for (k = 0; k < lambda; ++k) {
+        if (f[k] != f[k])
+            f[k] = HUGE_VAL;
+    }
+}
+
+static void
+sample_population(
+    double *y,
+    const double *dz,
+    double **b,
+    int n,
+    int lambda
+) {
+    /*
+     * y_k = B (D z_k) for all k as one blocked matrix product; a block of
+     * B is reused over the whole population while it stays in cache
+     */
+    int ii;
+
+    memset(y, 0, sizeof(double) * lambda * n);
+#pragma omp parallel for schedule(static)
+    for (ii = 0; ii < n; ii += CMA_ES_BLOCK) {
+        int i, j, jj, k, i_end, j_end;
+        double sum;
+        i_end = ii + CMA_ES_BLOCK < n ? ii + CMA_ES_BLOCK : n;
+        for (jj = 0; jj < n; jj += CMA_ES_BLOCK) {
+            j_end = jj + CMA_ES_BLOCK < n ? jj + CMA_ES_BLOCK : n;
+            for (k = 0; k < lambda; ++k) {
+                for (i = ii; i < i_end; ++i) {
+                    for (j = jj, sum = 0.; j < j_end; ++j) {
+                        sum += b[i][j] * dz[k * n + j];
+                    }
+                    y[k * n + i] += sum;
+                }
+            }
+        }
+    }
+}
+
+static void
+update_covariance(
+    double **c,
+    const double *y,
+    const int *index,
+    const double *weight,
+    const double *pc,
+    double decay,
+    double c1,
+    double cmu,
+    int n,
+    int mu
+) {
+    /*
+     * Blocked symmetric rank-(mu + 1) update of the lower triangle of C.
+     */
+    int ii;
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (ii = 0; ii < n; ii += CMA_ES_BLOCK) {
+        int i, j, jj, k, i_end, j_end;
+        double a;
+        const double *y_k;
+        i_end = ii + CMA_ES_BLOCK < n ? ii + CMA_ES_BLOCK : n;
+        for (jj = 0; jj <= ii; jj += CMA_ES_BLOCK) {
+            for (i = ii; i < i_end; ++i) {
+                j_end = jj + CMA_ES_BLOCK < i + 1 ? jj + CMA_ES_BLOCK : i + 1;
+                a = c1 * pc[i];
+                for (j = jj; j < j_end; ++j) {
+                    c[i][j] = decay * c[i][j] + a * pc[j];
+                }
+                for (k = 0; k < mu; ++k) {
+                    y_k = y + index[k] * n;
+                    a = cmu * weight[k] * y_k[i];
+                    for (j = jj; j < j_end; ++j) {
+                        c[i][j] += a * y_k[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void
+symmetric_eigen(
+    double **v,
+    double *d,
+    double *e,
+    int n
+) {
+    /*
+     * Householder tridiagonalization and the implicit QL method
+     * (tred2 and tql2 of EISPACK). On entry v is the symmetric matrix, on
+     * return the columns of v are the eigenvectors and d the eigenvalues.
+     */
+    int i, j, k, l, m;
+    double f, g, h, hh, p, r, s, s2, c, c2, c3, dl1, el1, tst1, scale, eps;
+
+    for (j = 0; j < n; ++j) {
+        d[j] = v[n - 1][j];
+    }
+    for (i = n - 1; i > 0; --i) {
+        scale = 0.;
+        h = 0.;
+        for (k = 0; k < i; ++k) {
+            scale += fabs(d[k]);
+        }
+        if (0. == scale) {
+            e[i] = d[i - 1];
+            for (j = 0; j < i; ++j) {
+                d[j] = v[i - 1][j];
+                v[i][j] = 0.;
+                v[j][i] = 0.;
+            }
+        } else {
+            for (k = 0; k < i; ++k) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            f = d[i - 1];
+            g = sqrt(h);
+            if (f > 0.)
+                g = -g;
+            e[i] = scale * g;
+            h -= f * g;
+            d[i - 1] = f - g;
+            for (j = 0; j < i; ++j) {
+                e[j] = 0.;
+            }
+            for (j = 0; j < i; ++j) {
+                f = d[j];
+                v[j][i] = f;
+                g = e[j] + v[j][j] * f;
+                for (k = j + 1; k <= i - 1; ++k) {
+                    g += v[k][j] * d[k];
+                    e[k] += v[k][j] * f;
+                }
+                e[j] = g;
+            }
+            f = 0.;
+            for (j = 0; j < i; ++j) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            hh = f / (h + h);
+            for (j = 0; j < i; ++j) {
+                e[j] -= hh * d[j];
+            }
+            for (j = 0; j < i; ++j) {
+                f = d[j];
+                g = e[j];
+                for (k = j; k <= i - 1; ++k) {
+                    v[k][j] -= (f * e[k] + g * d[k]);
+                }
+                d[j] = v[i - 1][j];
+                v[i][j] = 0.;
+            }
+        }
+        d[i] = h;
+    }
+    for (i = 0; i < n - 1; ++i) {
+        v[n - 1][i] = v[i][i];
+        v[i][i] = 1.;
+        h = d[i + 1];
+        if (0. != h) {
+            for (k = 0; k <= i; ++k) {
+                d[k] = v[k][i + 1] / h;
+            }
+            for (j = 0; j <= i; ++j) {
+                g = 0.;
+                for (k = 0; k <= i; ++k) {
+                    g += v[k][i + 1] * v[k][j];
+                }
+                for (k = 0; k <= i; ++k) {
+                    v[k][j] -= g * d[k];
+                }
+            }
+        }
+        for (k = 0; k <= i; ++k) {
+            v[k][i + 1] = 0.;
+        }
+    }
+    for (j = 0; j < n; ++j) {
+        d[j] = v[n - 1][j];
+        v[n - 1][j] = 0.;
+    }
+    v[n - 1][n - 1] = 1.;
+    e[0] = 0.;
+
+    for (i = 1; i < n; ++i) {
+        e[i - 1] = e[i];
+    }
+    e[n - 1] = 0.;
+    f = 0.;
+    tst1 = 0.;
+    eps = pow(2., -52.);
+    for (l = 0; l < n; ++l) {
+        if (tst1 < fabs(d[l]) + fabs(e[l]))
+            tst1 = fabs(d[l]) + fabs(e[l]);
+        for (m = l; m < n; ++m) {
+            if (fabs(e[m]) <= eps * tst1)
+                break;
+        }
+        if (m == n)
+            m = n - 1;
+        if (m > l) {
+            do {
+                g = d[l];
+                p = (d[l + 1] - g) / (2. * e[l]);
+                r = sqrt(p * p + 1.);
+                if (p < 0.)
+                    r = -r;
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                dl1 = d[l + 1];
+                h = g - d[l];
+                for (i = l + 2; i < n; ++i) {
+                    d[i] -= h;
+                }
+                f += h;
+                p = d[m];
+                c = 1.;
+                c2 = c;
+                c3 = c;
+                el1 = e[l + 1];
+                s = 0.;
+                s2 = 0.;
+                for (i = m - 1; i >= l; --i) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = sqrt(p * p + e[i] * e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+                    for (k = 0; k < n; ++k) {
+                        h = v[k][i + 1];
+                        v[k][i + 1] = s * v[k][i] + c * h;
+                        v[k][i] = c * v[k][i] - s * h;
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (fabs(e[l]) > eps * tst1);
+        }
+        d[l] += f;
+        e[l] = 0.;
+    }
+}
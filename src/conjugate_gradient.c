@@ -4,7 +4,7 @@
  * File:        conjugate_gradient.c
  * Version:     0.1.0
  * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
- * Last Change: 12-Jul-2012.
+ * Last Change: 19-Oct-2026.
  * TODO:
  */
 
@@ -15,9 +15,9 @@
 #include <string.h>
 
 #include "include/mymath.h"
-#include "include/print_message.h"
+#include "include/solver_context.h"
 
-static char method_name[64] = "Conjugate Gradient";
+static const char method_name[] = "Conjugate Gradient";
 
 static void
 default_conjugate_gradient_parameter(
@@ -40,37 +40,65 @@ conjugate_gradient(
     LineSearchParameter *line_search_parameter,
     ConjugateGradientParameter *conjugate_gradient_parameter
 ) {
-    int i, j, iter, status, storage_num;
+    int status;
+    SolverContext context;
+
+    status = initialize_solver_context(&context, 'c', n, 0);
+    if (NON_LINEAR_SATISFIED == status) {
+        status = conjugate_gradient_with_context(&context, x, n,
+                function_object, line_search, line_search_parameter,
+                conjugate_gradient_parameter);
+    }
+    release_solver_context(&context);
+    return status;
+}
+
+int
+conjugate_gradient_with_context(
+    SolverContext *context,
+    double *x,
+    int n,
+    FunctionObject *function_object,
+    line_search_t line_search,
+    LineSearchParameter *line_search_parameter,
+    ConjugateGradientParameter *conjugate_gradient_parameter
+) {
+    int i, iter, status, storage_num;
     long int memory_size;
     double g_norm, beta,
-           *storage, *storage_x,
+           *storage,
            *d, *g, *x_temp, *g_temp, *work;
     NonLinearComponent component;
+    PhaseTimer timer;
     ConjugateGradientParameter _conjugate_gradient_parameter;
     EvaluateObject evaluate_object;
 
     /* memory_size is for doing memcpy */
     memory_size = sizeof(double) * n;
-    /* prepare a number of vector for storage_b and storage */
+    /* prepare a number of vector for storage */
     storage_num = 6;
+    iter = 0;
+    /* set the component of Non-Linear Programming */
+    initialize_non_linear_component(
+            method_name, function_object, &evaluate_object, &component);
     /*
-     * allocate memory to storage
+     * take memory of storage from the arena of the context
      */
+    reset_solver_context(context);
     if (NULL == x) {
-        /* allocate memory to storage_x */
-        if (NULL == (storage_x = (double *)malloc(memory_size))) {
+        /* x as a vector */
+        if (NULL == (x = (double *)solver_context_allocate(
+                        context, memory_size))) {
             status = NON_LINEAR_OUT_OF_MEMORY;
             goto result;
         }
         for (i = 0; i < n; ++i) {
-            storage_x[i] = 0.;
+            x[i] = 0.;
         }
-        x = storage_x;
-    } else {
-        storage_x = NULL;
     }
-    /* allocate memory to storage for d, g, x_temp, g_temp and work */
-    if (NULL == (storage = (double *)malloc(memory_size * storage_num))) {
+    /* storage for d, g, x_temp, g_temp and work */
+    if (NULL == (storage = (double *)solver_context_allocate(
+                    context, memory_size * storage_num))) {
         status = NON_LINEAR_OUT_OF_MEMORY;
         goto result;
     }
@@ -80,20 +108,17 @@ conjugate_gradient(
     g_temp = x_temp + n;
     work = g_temp + n;
 
-    /* make sure that f and gf of this problem exist */
-    if (NULL == function_object->function
-            || NULL == function_object->gradient) {
+    /* make sure that f of this problem exists (gf may be differenced) */
+    if (NULL == function_object->function) {
         status = NON_LINEAR_NO_FUNCTION;
         goto result;
     }
 
-    /* set the component of Non-Linear Programming */
-    initialize_non_linear_component(
-            method_name, function_object, &evaluate_object, &component);
-
     /* set the parameter of Conjugate Gradient method */
     if (NULL == conjugate_gradient_parameter) {
         conjugate_gradient_parameter = &_conjugate_gradient_parameter;
+        memset(conjugate_gradient_parameter, 0,
+                sizeof(ConjugateGradientParameter));
     }
     default_conjugate_gradient_parameter(conjugate_gradient_parameter);
 
@@ -117,8 +142,13 @@ conjugate_gradient(
     }
     for (iter = 1; iter <= conjugate_gradient_parameter->upper_iter; ++iter) {
         /* compute step width with a line search algorithm */
-        switch (line_search(work, x, g, d, n,
-                    &evaluate_object, line_search_parameter, &component)) {
+        start_phase(&timer, &component);
+        status = line_search(work, x, g, d, n,
+                &evaluate_object, line_search_parameter, &component);
+        stop_phase(&timer, SOLVER_PHASE_LINE_SEARCH,
+                (long long int)sizeof(double) * 3 * n * component.trials,
+                &component);
+        switch (status) {
             case LINE_SEARCH_FUNCTION_NAN:
                 status = NON_LINEAR_FUNCTION_NAN;
                 goto result;
@@ -129,6 +159,7 @@ conjugate_gradient(
                 break;
         }
         /* update x_temp = x + alpha * d */
+        start_phase(&timer, &component);
         for (i = 0; i < n; ++i) {
             x_temp[i] = x[i] + component.alpha * d[i];
         }
@@ -140,41 +171,43 @@ conjugate_gradient(
         }
         /* compute infinity-norm of gradient */
         g_norm = infinity_norm(g_temp, n);
+        stop_phase(&timer, SOLVER_PHASE_VECTOR, 4 * memory_size, &component);
 
-        print_iteration_info(iter, g_norm, &component);
+        if (observe_iteration(iter, g_norm, &component)) {
+            status = NON_LINEAR_STOPPED;
+            goto result;
+        }
 
         if (g_norm < conjugate_gradient_parameter->tolerance) {
+            /* return the iterate which satisfied the test */
+            memcpy(x, x_temp, memory_size);
+            memcpy(g, g_temp, memory_size);
             status = NON_LINEAR_SATISFIED;
             goto result;
         }
 
         /* compute beta */
+        start_phase(&timer, &component);
         beta = beta_fletcher_reeves_formula(g, g_temp, n);
         /* update direction of descent */
         for (i = 0; i < n; ++i) {
             d[i] = -g_temp[i] + beta * d[i];
         }
+        stop_phase(&timer, SOLVER_PHASE_DIRECTION,
+                (long long int)sizeof(double) * 4 * n, &component);
 
         /* INFO:
          *  If you'd like to update vector, use memcpy from string.h.
          *  Don't use For statement. It's slow.
          * update x and g to new step */
+        start_phase(&timer, &component);
         memcpy(x, x_temp, memory_size);
         memcpy(g, g_temp, memory_size);
+        stop_phase(&timer, SOLVER_PHASE_VECTOR, 4 * memory_size, &component);
     }
     status = NON_LINEAR_NO_CONVERGENCE;
 result:
-    print_result_info(status, iter, &component);
-
-    /* release memory of storage_x, and storage */
-    if (NULL != storage_x) {
-        free(storage_x);
-        storage_x = NULL;
-    }
-    if (NULL != storage) {
-        free(storage);
-        storage = NULL;
-    }
+    observe_result(status, iter, &component);
 
     return status;
 }
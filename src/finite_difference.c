@@ -0,0 +1,167 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        finite_difference.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/finite_difference.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * the point k of the stencil: x itself, or x with the coordinate
+ * returned perturbed by *step (-1 for x itself)
+ */
+static int
+stencil_point(
+    int k,
+    int n,
+    int central,
+    const double *h,
+    double *step
+);
+
+static void
+evaluate_stencil(
+    double *f,
+    const double *x,
+    const double *h,
+    int n,
+    int m,
+    int central,
+    double *work,
+    FunctionObject *function_object
+);
+
+int
+finite_difference_gradient(
+    double *g,
+    double *f,
+    const double *x,
+    int n,
+    FunctionObject *function_object
+) {
+    int i, m, central;
+    double h_i, temp, *h, *f_stencil, *work;
+
+    central = 'f' != function_object->finite_difference;
+    /* forward: x, x + h_i e_i;  central: x + h_i e_i, x - h_i e_i (, x) */
+    m = central ? 2 * n + (NULL != f ? 1 : 0) : n + 1;
+    work = (double *)malloc(sizeof(double) * (n + m
+                + (NULL != function_object->batch_function
+                    ? FINITE_DIFFERENCE_BATCH * n : 0)));
+    if (NULL == work)
+        return -1;
+    h = work;
+    f_stencil = h + n;
+
+    h_i = central ? cbrt(DBL_EPSILON) : sqrt(DBL_EPSILON);
+    for (i = 0; i < n; ++i) {
+        temp = x[i] + h_i * (fabs(x[i]) > 1. ? fabs(x[i]) : 1.);
+        h[i] = temp - x[i];
+    }
+    evaluate_stencil(f_stencil, x, h, n, m, central, f_stencil + m,
+            function_object);
+    if (central) {
+        for (i = 0; i < n; ++i)
+            g[i] = (f_stencil[2 * i] - f_stencil[2 * i + 1]) / (2. * h[i]);
+        if (NULL != f)
+            *f = f_stencil[2 * n];
+    } else {
+        for (i = 0; i < n; ++i)
+            g[i] = (f_stencil[i + 1] - f_stencil[0]) / h[i];
+        if (NULL != f)
+            *f = f_stencil[0];
+    }
+    free(work);
+    return m;
+}
+
+static int
+stencil_point(
+    int k,
+    int n,
+    int central,
+    const double *h,
+    double *step
+) {
+    int i;
+
+    if (central) {
+        if (k >= 2 * n)
+            return -1;
+        i = k / 2;
+        *step = k % 2 ? -h[i] : h[i];
+    } else {
+        if (0 == k)
+            return -1;
+        i = k - 1;
+        *step = h[i];
+    }
+    return i;
+}
+
+/*
+ * f[k] = function(point k) for k = 0, ..., m - 1, in blocks of
+ * FINITE_DIFFERENCE_BATCH points built in work for batch_function, or one
+ * point at a time, per thread when function is thread safe
+ */
+static void
+evaluate_stencil(
+    double *f,
+    const double *x,
+    const double *h,
+    int n,
+    int m,
+    int central,
+    double *work,
+    FunctionObject *function_object
+) {
+    int k, i, block, size;
+    double step;
+
+    if (NULL != function_object->batch_function) {
+        for (block = 0; block < m; block += FINITE_DIFFERENCE_BATCH) {
+            size = m - block < FINITE_DIFFERENCE_BATCH
+                ? m - block : FINITE_DIFFERENCE_BATCH;
+            for (k = 0; k < size; ++k) {
+                memcpy(work + k * n, x, sizeof(double) * n);
+                i = stencil_point(block + k, n, central, h, &step);
+                if (i >= 0)
+                    work[k * n + i] += step;
+            }
+            function_object->batch_function(
+                    f + block, work, n, size, function_object->user);
+        }
+        return;
+    }
+#pragma omp parallel private(k, i, step) if (function_object->thread_safe)
+    {
+        double *x_local = (double *)malloc(sizeof(double) * n);
+
+        if (NULL != x_local)
+            memcpy(x_local, x, sizeof(double) * n);
+#pragma omp for schedule(dynamic, 16)
+        for (k = 0; k < m; ++k) {
+            if (NULL == x_local) {
+                f[k] = NAN;
+                continue;
+            }
+            i = stencil_point(k, n, central, h, &step);
+            if (i >= 0)
+                x_local[i] = x[i] + step;
+            f[k] = function_object->function(
+                    x_local, n, function_object->user);
+            if (i >= 0)
+                x_local[i] = x[i];
+        }
+        free(x_local);
+    }
+}
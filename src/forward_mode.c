@@ -0,0 +1,94 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        forward_mode.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/forward_mode.h"
+
+#include <stdlib.h>
+
+void
+initialize_forward_mode(
+    FunctionObject *function_object,
+    ForwardModeObject *forward_mode_object
+) {
+    function_object->function = forward_mode_function;
+    function_object->gradient = forward_mode_gradient;
+    function_object->user = forward_mode_object;
+}
+
+/*
+ * x as dual numbers with zero tangents; NULL when out of memory
+ */
+static Dual *
+allocate_dual_vector(
+    const double *x,
+    int n
+) {
+    int i;
+    Dual *z;
+
+    if (NULL == (z = (Dual *)malloc(sizeof(Dual) * (n > 0 ? n : 1))))
+        return NULL;
+    for (i = 0; i < n; ++i)
+        z[i] = dual_constant(x[i]);
+    return z;
+}
+
+double
+forward_mode_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    ForwardModeObject *forward_mode_object = (ForwardModeObject *)user;
+    Dual *z, f;
+
+    if (NULL != forward_mode_object->function)
+        return forward_mode_object->function(x, n, forward_mode_object->user);
+    if (NULL == (z = allocate_dual_vector(x, n)))
+        return NAN;
+    f = forward_mode_object->dual_function(z, n, forward_mode_object->user);
+    free(z);
+    return f.v;
+}
+
+/*
+ * Seeds the lanes with the unit vectors e_k, ..., e_k+DUAL_LANES-1 and
+ * reads the partial derivatives off the tangents of f, block by block.
+ * A NaN gradient is returned when out of memory.
+ */
+void
+forward_mode_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    ForwardModeObject *forward_mode_object = (ForwardModeObject *)user;
+    int i, k, lanes;
+    Dual *z, f;
+
+    if (NULL == (z = allocate_dual_vector(x, n))) {
+        for (i = 0; i < n; ++i)
+            g[i] = NAN;
+        return;
+    }
+    for (k = 0; k < n; k += DUAL_LANES) {
+        lanes = n - k < DUAL_LANES ? n - k : DUAL_LANES;
+        for (i = 0; i < lanes; ++i)
+            z[k + i].d[i] = 1.;
+        f = forward_mode_object->dual_function(z, n,
+                forward_mode_object->user);
+        for (i = 0; i < lanes; ++i) {
+            g[k + i] = f.d[i];
+            z[k + i].d[i] = 0.;
+        }
+    }
+    free(z);
+}
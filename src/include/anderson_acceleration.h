@@ -0,0 +1,104 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        anderson_acceleration.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_ANDERSON_ACCELERATION_H
+#define OPTIMIZATION_ANDERSON_ACCELERATION_H
+
+#include "non_linear_component.h"
+
+/*
+ * fixed-point map: gx = G(x), called as map(gx, x, n, user)
+ * observer (optional): receives the progress of the iteration
+ */
+typedef struct _FixedPointObject {
+    void    (*map)(double *, const double *, int, void *);
+    void    *user;
+    SolverObserver *observer;
+} FixedPointObject;
+
+/*
+ * memory:      window size m of the least squares
+ * beta:        mixing parameter (1 is the undamped type-II method)
+ * step:        initial step width of the gradient step x - step * gf(x)
+ *              (1 by default), halved whenever that step increases f
+ * projection:  projection onto the feasible set applied after the
+ *              gradient step (NULL means unconstrained)
+ */
+typedef struct _AndersonParameter {
+    int memory;
+    double beta;
+    double step;
+    double tolerance;
+    int upper_iter;
+    void    (*projection)(double *, int);
+} AndersonParameter;
+
+/*
+ * The state of the accelerator. The differences of the residuals
+ * dF = [df_0, ..., df_k-1] are kept as the thin QR factors dF = QR, and
+ * the factors are updated when a column is added or the oldest column is
+ * dropped.
+ */
+typedef struct _AndersonAccelerator {
+    int n;
+    int memory;
+    int k;
+    int iteration;
+    double beta;
+    double *q;
+    double *r;
+    double *dg;
+    double *f_old;
+    double *g_old;
+    double *gamma;
+    double *work;
+} AndersonAccelerator;
+
+int
+initialize_anderson_accelerator(
+    AndersonAccelerator *accelerator,
+    int n,
+    int memory,
+    double beta
+);
+
+int
+anderson_accelerate(
+    AndersonAccelerator *accelerator,
+    double *x,
+    const double *gx
+);
+
+void
+release_anderson_accelerator(
+    AndersonAccelerator *accelerator
+);
+
+/*
+ * An accelerated iterate which increases f (anderson_gradient_descent) or
+ * the residual (anderson_fixed_point) over the last iterate kept is
+ * rejected: the window restarts from the plain G(x) of that iterate.
+ */
+int
+anderson_fixed_point(
+    double *x,
+    int n,
+    FixedPointObject *fixed_point_object,
+    AndersonParameter *anderson_parameter
+);
+
+int
+anderson_gradient_descent(
+    double *x,
+    int n,
+    FunctionObject *function_object,
+    AndersonParameter *anderson_parameter
+);
+
+#endif // OPTIMIZATION_ANDERSON_ACCELERATION_H
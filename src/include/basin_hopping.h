@@ -0,0 +1,68 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        basin_hopping.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_BASIN_HOPPING_H
+#define OPTIMIZATION_BASIN_HOPPING_H
+
+#include "non_linear_component.h"
+#include "line_search_component.h"
+#include "quasi_newton.h"
+#include "conjugate_gradient.h"
+
+/*
+ * acceptance:
+ *  'm' - Metropolis rule with temperature
+ *  'd' - only a lower minimum is accepted (monotonic basin hopping)
+ * solver:
+ *  'q' - quasi_newton; the matrix of the previous local solve is the
+ *        initial matrix of the next one
+ *  'c' - conjugate_gradient
+ * step:
+ *  each coordinate of the current minimum is perturbed uniformly in
+ *  [-step, step]
+ * stall:
+ *  stop after this number of hops without a new best minimum
+ *  (0 means that all num_hops are done)
+ */
+typedef struct _BasinHoppingParameter {
+    char acceptance;
+    char solver;
+    int num_hops;
+    int stall;
+    double step;
+    double temperature;
+    unsigned int seed;
+    line_search_t line_search;
+    LineSearchParameter *line_search_parameter;
+    QuasiNewtonParameter *quasi_newton_parameter;
+    ConjugateGradientParameter *conjugate_gradient_parameter;
+} BasinHoppingParameter;
+
+typedef struct _BasinHoppingResult {
+    double f;
+    int num_hops;
+    int num_accepted;
+    int num_improved;
+} BasinHoppingResult;
+
+/*
+ * b is the initial matrix of the quasi-Newton local solves and holds the
+ * matrix of the last local solve on return; NULL means identity.
+ */
+int
+basin_hopping(
+    double *x,
+    double **b,
+    int n,
+    FunctionObject *function_object,
+    BasinHoppingParameter *basin_hopping_parameter,
+    BasinHoppingResult *basin_hopping_result
+);
+
+#endif // OPTIMIZATION_BASIN_HOPPING_H
@@ -0,0 +1,68 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        batch_quasi_newton.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_BATCH_QUASI_NEWTON_H
+#define OPTIMIZATION_BATCH_QUASI_NEWTON_H
+
+#include "non_linear_component.h"
+
+#define BATCH_LANES_MAX 16
+
+/*
+ * function_gradient:
+ *  computes f[l] and g[i * lanes + l] at x[i * lanes + l] for every lane l
+ *  with active[l] != 0; the other lanes may be left untouched
+ *  called as function_gradient(f, g, x, active, n, lanes, user)
+ */
+typedef struct _BatchFunctionObject {
+    void (*function_gradient)(
+            double *,
+            double *,
+            const double *,
+            const int *,
+            int,
+            int,
+            void *
+        );
+    void *user;
+} BatchFunctionObject;
+
+/*
+ * lanes:               number of problems solved side by side
+ *                      (1 to BATCH_LANES_MAX)
+ * xi, decreasing:      Armijo condition and factor of the backtracking
+ * line_search_iter:    upper bound of backtracking steps
+ */
+typedef struct _BatchQuasiNewtonParameter {
+    int lanes;
+    double tolerance;
+    int upper_iter;
+    double xi;
+    double decreasing;
+    int line_search_iter;
+} BatchQuasiNewtonParameter;
+
+/*
+ * Solves num_problems problems of dimension n with BFGS. x holds one
+ * problem per n doubles and is overwritten with the solutions. status and
+ * iteration receive the NonLinearStatus and the number of iterations of
+ * each problem; either may be NULL.
+ */
+int
+batch_quasi_newton(
+    double *x,
+    int n,
+    int num_problems,
+    BatchFunctionObject *batch_function_object,
+    BatchQuasiNewtonParameter *batch_quasi_newton_parameter,
+    int *status,
+    int *iteration
+);
+
+#endif // OPTIMIZATION_BATCH_QUASI_NEWTON_H
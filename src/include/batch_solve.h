@@ -0,0 +1,85 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        batch_solve.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_BATCH_SOLVE_H
+#define OPTIMIZATION_BATCH_SOLVE_H
+
+#include "non_linear_component.h"
+#include "line_search_component.h"
+#include "quasi_newton.h"
+#include "conjugate_gradient.h"
+#include "trust_region.h"
+#include "nelder_mead.h"
+
+/*
+ * solver:
+ *  'q' - quasi_newton with line_search and quasi_newton_parameter
+ *  'c' - conjugate_gradient with line_search and
+ *        conjugate_gradient_parameter
+ *  't' - trust_region with trust_region_parameter
+ *  'n' - nelder_mead with nelder_mead_parameter
+ * x is the starting point and receives the solution; status and seconds
+ * receive the NonLinearStatus and the wall time of the solve. The
+ * parameters may be shared between jobs, they are copied per solve.
+ */
+typedef struct _SolveJob {
+    char solver;
+    double *x;
+    int n;
+    FunctionObject *function_object;
+    line_search_t line_search;
+    LineSearchParameter *line_search_parameter;
+    QuasiNewtonParameter *quasi_newton_parameter;
+    ConjugateGradientParameter *conjugate_gradient_parameter;
+    TrustRegionParameter *trust_region_parameter;
+    NelderMeadParameter *nelder_mead_parameter;
+    int status;
+    double seconds;
+} SolveJob;
+
+/*
+ * num_threads:     0 means the number of online processors
+ * affinity:
+ *  'n' - threads are not pinned
+ *  'c' - compact: thread i is pinned to the i-th allowed processor
+ * cpu:             processor of each thread (num_threads entries), which
+ *                  overrides affinity if it is given
+ */
+typedef struct _BatchSolveParameter {
+    int num_threads;
+    char affinity;
+    const int *cpu;
+} BatchSolveParameter;
+
+typedef struct _BatchSolveStatistics {
+    int num_jobs;
+    int num_satisfied;
+    int num_threads;
+    long int num_steals;
+    double seconds;
+    double solves_per_second;
+    double latency_p50;
+    double latency_p99;
+} BatchSolveStatistics;
+
+/*
+ * Every worker solves its jobs with OpenMP limited to one thread, so the
+ * parallel regions of a solver (Nelder-Mead vertices, finite differences
+ * and the like) run serially inside batch_solve instead of
+ * oversubscribing the processors the workers occupy.
+ */
+int
+batch_solve(
+    SolveJob *job,
+    int num_jobs,
+    BatchSolveParameter *batch_solve_parameter,
+    BatchSolveStatistics *batch_solve_statistics
+);
+
+#endif // OPTIMIZATION_BATCH_SOLVE_H
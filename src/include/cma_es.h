@@ -0,0 +1,42 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        cma_es.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_CMA_ES_H
+#define OPTIMIZATION_CMA_ES_H
+
+#include "non_linear_component.h"
+
+/*
+ * lambda:          population size (0 means 4 + 3 ln n)
+ * sigma:           initial step size
+ * eigen_interval:  generations between eigendecompositions of C
+ *                  (0 means 1 / (10 n (c1 + cmu)))
+ *
+ * The population is evaluated with FunctionObject::batch_function if it
+ * is given. Otherwise FunctionObject::function is called in parallel when
+ * FunctionObject::thread_safe is set, and one point after another when not.
+ */
+typedef struct _CMAESParameter {
+    int lambda;
+    double sigma;
+    int eigen_interval;
+    double tolerance;
+    int upper_iter;
+    unsigned int seed;
+} CMAESParameter;
+
+int
+cma_es(
+    double *x,
+    int n,
+    FunctionObject *function_object,
+    CMAESParameter *cma_es_parameter
+);
+
+#endif // OPTIMIZATION_CMA_ES_H
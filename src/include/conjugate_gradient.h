@@ -12,6 +12,7 @@
 
 #include "non_linear_component.h"
 #include "line_search_component.h"
+#include "solver_context.h"
 
 typedef int (*line_search_t)(
     double *,
@@ -39,5 +40,20 @@ conjugate_gradient(
     ConjugateGradientParameter *conjugate_gradient_parameter
 );
 
+/*
+ * same as conjugate_gradient, but the storage is taken from the arena of
+ * a context made with initialize_solver_context(context, 'c', n, 0)
+ */
+int
+conjugate_gradient_with_context(
+    SolverContext *context,
+    double *x,
+    int n,
+    FunctionObject *function_object,
+    line_search_t line_search,
+    LineSearchParameter *line_search_parameter,
+    ConjugateGradientParameter *conjugate_gradient_parameter
+);
+
 #endif //  OPTIMIZATION_CONJUGATE_GRADIENT_H
 
@@ -0,0 +1,38 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        finite_difference.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_FINITE_DIFFERENCE_H
+#define OPTIMIZATION_FINITE_DIFFERENCE_H
+
+#include "non_linear_component.h"
+
+/* points per call of batch_function */
+#define FINITE_DIFFERENCE_BATCH 64
+
+/*
+ * gf at x by differences of function_object->function:
+ *  'f' - forward,  h_i = eps^(1/2) max(|x_i|, 1), n + 1 evaluations
+ *  'c' - central,  h_i = eps^(1/3) max(|x_i|, 1), 2n (+ 1) evaluations
+ * as chosen by function_object->finite_difference. h_i is rounded so
+ * that x_i + h_i - x_i is exact. f (optional) receives f(x).
+ * The evaluations go to batch_function when it is given. Otherwise they
+ * run in parallel, every thread on its own copy of x, when
+ * function_object->thread_safe is set, and one after another when not.
+ * Returns the number of evaluations, or -1 when out of memory.
+ */
+int
+finite_difference_gradient(
+    double *g,
+    double *f,
+    const double *x,
+    int n,
+    FunctionObject *function_object
+);
+
+#endif // OPTIMIZATION_FINITE_DIFFERENCE_H
@@ -0,0 +1,236 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        forward_mode.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_FORWARD_MODE_H
+#define OPTIMIZATION_FORWARD_MODE_H
+
+#include <math.h>
+
+#include "non_linear_component.h"
+
+#define DUAL_LANES 8
+
+/*
+ * A dual number with DUAL_LANES tangents: v + d[0] e_0 + ... where the
+ * e_l are independent infinitesimals. An objective written with the
+ * operations below gives DUAL_LANES directional derivatives per call;
+ * the loops over the lanes have a fixed length, so that the compiler
+ * vectorizes them.
+ */
+typedef struct _Dual {
+    double v;
+    double d[DUAL_LANES];
+} Dual;
+
+/*
+ * function (optional):  the objective on doubles; without it the value
+ *                       is computed by dual_function with zero tangents
+ * dual_function:        the same objective on dual numbers
+ * user:                 passed to both as the last argument
+ */
+typedef struct _ForwardModeObject {
+    double  (*function)(const double *, int, void *);
+    Dual    (*dual_function)(const Dual *, int, void *);
+    void    *user;
+} ForwardModeObject;
+
+/*
+ * Sets function, gradient and user of function_object so that the
+ * gradient is computed in ceil(n / DUAL_LANES) calls of dual_function.
+ * The other fields (observer, ...) are left as they are.
+ */
+void
+initialize_forward_mode(
+    FunctionObject *function_object,
+    ForwardModeObject *forward_mode_object
+);
+
+double
+forward_mode_function(
+    const double *x,
+    int n,
+    void *user
+);
+
+void
+forward_mode_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+);
+
+/*
+ * the arithmetic of dual numbers
+ */
+static inline Dual
+dual_constant(
+    double c
+) {
+    int l;
+    Dual z;
+
+    z.v = c;
+    for (l = 0; l < DUAL_LANES; ++l)
+        z.d[l] = 0.;
+    return z;
+}
+
+/*
+ * f(a) from f(a.v) and f'(a.v)
+ */
+static inline Dual
+dual_chain(
+    Dual a,
+    double value,
+    double derivative
+) {
+    int l;
+    Dual z;
+
+    z.v = value;
+    for (l = 0; l < DUAL_LANES; ++l)
+        z.d[l] = derivative * a.d[l];
+    return z;
+}
+
+static inline Dual
+dual_add(
+    Dual a,
+    Dual b
+) {
+    int l;
+    Dual z;
+
+    z.v = a.v + b.v;
+    for (l = 0; l < DUAL_LANES; ++l)
+        z.d[l] = a.d[l] + b.d[l];
+    return z;
+}
+
+static inline Dual
+dual_sub(
+    Dual a,
+    Dual b
+) {
+    int l;
+    Dual z;
+
+    z.v = a.v - b.v;
+    for (l = 0; l < DUAL_LANES; ++l)
+        z.d[l] = a.d[l] - b.d[l];
+    return z;
+}
+
+static inline Dual
+dual_mul(
+    Dual a,
+    Dual b
+) {
+    int l;
+    Dual z;
+
+    z.v = a.v * b.v;
+    for (l = 0; l < DUAL_LANES; ++l)
+        z.d[l] = a.d[l] * b.v + a.v * b.d[l];
+    return z;
+}
+
+static inline Dual
+dual_div(
+    Dual a,
+    Dual b
+) {
+    int l;
+    Dual z;
+
+    z.v = a.v / b.v;
+    for (l = 0; l < DUAL_LANES; ++l)
+        z.d[l] = (a.d[l] - z.v * b.d[l]) / b.v;
+    return z;
+}
+
+static inline Dual
+dual_add_constant(
+    Dual a,
+    double c
+) {
+    a.v += c;
+    return a;
+}
+
+static inline Dual
+dual_scale(
+    Dual a,
+    double c
+) {
+    return dual_chain(a, c * a.v, c);
+}
+
+static inline Dual
+dual_sqr(
+    Dual a
+) {
+    return dual_chain(a, a.v * a.v, 2. * a.v);
+}
+
+static inline Dual
+dual_sqrt(
+    Dual a
+) {
+    double s = sqrt(a.v);
+    return dual_chain(a, s, .5 / s);
+}
+
+static inline Dual
+dual_pow(
+    Dual a,
+    double p
+) {
+    double s = pow(a.v, p - 1.);
+    return dual_chain(a, s * a.v, p * s);
+}
+
+static inline Dual
+dual_exp(
+    Dual a
+) {
+    double s = exp(a.v);
+    return dual_chain(a, s, s);
+}
+
+static inline Dual
+dual_log(
+    Dual a
+) {
+    return dual_chain(a, log(a.v), 1. / a.v);
+}
+
+static inline Dual
+dual_sin(
+    Dual a
+) {
+    return dual_chain(a, sin(a.v), cos(a.v));
+}
+
+static inline Dual
+dual_cos(
+    Dual a
+) {
+    return dual_chain(a, cos(a.v), -sin(a.v));
+}
+
+static inline Dual
+dual_fabs(
+    Dual a
+) {
+    return dual_chain(a, fabs(a.v), a.v < 0. ? -1. : 1.);
+}
+
+#endif // OPTIMIZATION_FORWARD_MODE_H
@@ -0,0 +1,68 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        multistart.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_MULTISTART_H
+#define OPTIMIZATION_MULTISTART_H
+
+#include "non_linear_component.h"
+#include "line_search_component.h"
+#include "quasi_newton.h"
+#include "conjugate_gradient.h"
+
+/*
+ * sampling:
+ *  's' - Sobol sequence (n <= 16, Latin hypercube is used beyond)
+ *  'l' - Latin hypercube
+ * solver:
+ *  'q' - quasi_newton with quasi_newton_parameter
+ *  'c' - conjugate_gradient with conjugate_gradient_parameter
+ * budget:
+ *  upper bound of evaluations of f and gf over all local solves
+ *  (0 means no bound)
+ * basin_radius:
+ *  a local solve is pruned when its iterate comes within basin_radius of
+ *  a minimizer which has already been found
+ */
+typedef struct _MultistartParameter {
+    char sampling;
+    char solver;
+    int num_starts;
+    long int budget;
+    double basin_radius;
+    unsigned int seed;
+    const double *lower;
+    const double *upper;
+    line_search_t line_search;
+    LineSearchParameter *line_search_parameter;
+    QuasiNewtonParameter *quasi_newton_parameter;
+    ConjugateGradientParameter *conjugate_gradient_parameter;
+} MultistartParameter;
+
+typedef struct _MultistartResult {
+    double f;
+    int num_solves;
+    int num_pruned;
+    int num_minima;
+    long int evaluations;
+} MultistartResult;
+
+/*
+ * The local solves run in parallel, all of them on function_object, when
+ * function_object->thread_safe is set, and one after another when not.
+ */
+int
+multistart(
+    double *x,
+    int n,
+    FunctionObject *function_object,
+    MultistartParameter *multistart_parameter,
+    MultistartResult *multistart_result
+);
+
+#endif // OPTIMIZATION_MULTISTART_H
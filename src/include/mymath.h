@@ -4,7 +4,7 @@
  * File:        mymath.h
  * Version:     0.1.0
  * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
- * Last Change: 12-Jul-2012.
+ * Last Change: 19-Oct-2026.
  */
 
 #ifndef OPTIMIZATION_MYMATH_H
@@ -19,6 +19,50 @@ enum MyMathStatus {
     MY_MATH_NOT_UPDATE,
 };
 
+enum PreconditionerType {
+    PRECONDITIONER_NONE = 0,
+    PRECONDITIONER_JACOBI,
+    PRECONDITIONER_SSOR,
+    PRECONDITIONER_INCOMPLETE_CHOLESKY,
+};
+
+/*
+ * A matrix of n_rows x n_cols in compressed sparse row (CSR) format: the
+ * entries of row i are value[k] at column[k] for
+ * k = row_start[i], ..., row_start[i + 1] - 1, with the columns of a row
+ * in increasing order.
+ */
+typedef struct _SparseMatrix {
+    int n_rows;
+    int n_cols;
+    int nnz;
+    int *row_start;
+    int *column;
+    double *value;
+} SparseMatrix;
+
+/*
+ * Rows grouped by color: the rows of color c are
+ * row[color_start[c]], ..., row[color_start[c + 1] - 1].
+ */
+typedef struct _MulticolorOrdering {
+    int num_colors;
+    int *color_start;
+    int *row;
+} MulticolorOrdering;
+
+/*
+ * M ~ A for the conjugate gradient; diagonal holds a_ii, and factor the
+ * lower triangle by rows with the diagonal last in each row: that of A
+ * for SSOR, and L of L L^T ~ A with the pattern of A for IC(0).
+ */
+typedef struct _Preconditioner {
+    int type;
+    double omega;
+    double *diagonal;
+    SparseMatrix factor;
+} Preconditioner;
+
 double
 dot_product(
     const double *x,
@@ -53,7 +97,8 @@ infinity_norm(
     int n
 );
 
-int gauss_seidel(
+int
+gauss_seidel(
     double **a,
     double *x,
     const double *b,
@@ -61,7 +106,8 @@ int gauss_seidel(
     double epsilon
 );
 
-int successive_over_relaxation(
+int
+successive_over_relaxation(
     double **a,
     double *x,
     const double *b,
@@ -70,5 +116,317 @@ int successive_over_relaxation(
     double omega
 );
 
+/*
+ * same as successive_over_relaxation, and the number of sweeps over a is
+ * stored to sweeps
+ */
+int
+successive_over_relaxation_sweeps(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    double epsilon,
+    double omega,
+    int *sweeps
+);
+
+/*
+ * SOR with the relaxation estimated from the observed rate of convergence
+ * (Hageman and Young): omega gives the initial value, at least 1, and
+ * receives the last estimate, which may start the next solve with a
+ * similar a. The estimate assumes a consistently ordered a (tridiagonal,
+ * or red-black ordered as by sparse_multicolor_ordering); for others an
+ * omega slower than the initial one is taken back.
+ */
+int
+adaptive_successive_over_relaxation(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    double epsilon,
+    double *omega,
+    int *sweeps
+);
+
+/*
+ * Symmetric SOR (a forward and a backward sweep count as one) accelerated
+ * by Chebyshev polynomials once the spectral radius of the sweeps has been
+ * estimated; a symmetric positive definite. work holds 2n doubles, so that
+ * repeated solves allocate nothing. MY_MATH_NOT_UPDATE when the change is
+ * still above epsilon after upper_sweeps sweeps.
+ */
+int
+chebyshev_symmetric_successive_over_relaxation(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    double epsilon,
+    double omega,
+    int upper_sweeps,
+    double *work,
+    int *sweeps
+);
+
+/*
+ * Libraries of Sparse Matrix
+ * allocate_sparse_matrix allocates row_start, column and value for nnz
+ * entries (row_start[0] = 0); release_sparse_matrix frees them.
+ */
+int
+allocate_sparse_matrix(
+    SparseMatrix *a,
+    int n_rows,
+    int n_cols,
+    int nnz
+);
+
+void
+release_sparse_matrix(
+    SparseMatrix *a
+);
+
+/*
+ * y = A x
+ */
+void
+sparse_matrix_vector(
+    double *y,
+    const SparseMatrix *a,
+    const double *x
+);
+
+/*
+ * One sweep of SOR over the rows of a square A in increasing (forward) or
+ * decreasing (backward) order; change receives max |x_new - x_old|.
+ * MY_MATH_FAILED when a diagonal entry is zero or missing.
+ */
+int
+sparse_sor_forward_sweep(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double omega,
+    double *change
+);
+
+int
+sparse_sor_backward_sweep(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double omega,
+    double *change
+);
+
+/*
+ * Solve A x = b by sweeps until max |x_new - x_old| <= epsilon, from the
+ * x given; the number of sweeps is stored to sweeps (a symmetric sweep is
+ * a forward and a backward one and counts as one)
+ */
+int
+sparse_gauss_seidel(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double epsilon,
+    int *sweeps
+);
+
+int
+sparse_successive_over_relaxation(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double epsilon,
+    double omega,
+    int *sweeps
+);
+
+int
+sparse_symmetric_successive_over_relaxation(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double epsilon,
+    double omega,
+    int *sweeps
+);
+
+/*
+ * Libraries of Parallel Relaxation
+ * The rows of one color are relaxed in parallel and the convergence test
+ * max |x_new - x_old| <= epsilon is a parallel max-reduction.
+ *
+ * sparse_multicolor_ordering: greedy coloring of the graph of A + A^T,
+ *  so that rows of one color do not read each other
+ * sparse_multicolor_successive_over_relaxation: SOR in the order of the
+ *  colors (Gauss-Seidel with omega = 1)
+ * multicolor_successive_over_relaxation: dense A in blocks of block rows
+ *  colored red and black alternately; a block is relaxed in order, and
+ *  reads the other blocks of its color as they were when the color began
+ *  (Jacobi between them)
+ * weighted_jacobi, sparse_weighted_jacobi:
+ *  x = x + omega D^-1 (b - A x)
+ */
+int
+sparse_multicolor_ordering(
+    MulticolorOrdering *ordering,
+    const SparseMatrix *a
+);
+
+void
+release_multicolor_ordering(
+    MulticolorOrdering *ordering
+);
+
+int
+sparse_multicolor_successive_over_relaxation(
+    const SparseMatrix *a,
+    const MulticolorOrdering *ordering,
+    double *x,
+    const double *b,
+    double epsilon,
+    double omega,
+    int *sweeps
+);
+
+int
+multicolor_successive_over_relaxation(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    int block,
+    double epsilon,
+    double omega,
+    int *sweeps
+);
+
+int
+weighted_jacobi(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    double epsilon,
+    double omega,
+    int *sweeps
+);
+
+int
+sparse_weighted_jacobi(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double epsilon,
+    double omega,
+    int *sweeps
+);
+
+/*
+ * Libraries of Conjugate Gradient
+ * A symmetric positive definite, dense, packed (the lower triangle by
+ * rows: a_ij, j <= i, at a[i (i + 1) / 2 + j]), CSR or given by
+ * matrix_vector(y, x, n, user) for y = A x.
+ *
+ * initialize_*preconditioner: M from A of type PreconditionerType; omega
+ *  is for SSOR. IC(0) shifts the diagonal of A when a pivot breaks down.
+ *  MY_MATH_FAILED when a diagonal entry is not positive.
+ * apply_preconditioner: z = M^-1 r (z = r for PRECONDITIONER_NONE)
+ * *preconditioned_conjugate_gradient: from the x given until
+ *  ||b - A x|| <= tolerance ||b||; preconditioner may be NULL. The number
+ *  of iterations is stored to iterations. MY_MATH_NOT_UPDATE when
+ *  upper_iter is reached first, MY_MATH_FAILED when p^T A p <= 0.
+ */
+int
+initialize_preconditioner(
+    Preconditioner *preconditioner,
+    double **a,
+    int n,
+    int type,
+    double omega
+);
+
+int
+initialize_packed_preconditioner(
+    Preconditioner *preconditioner,
+    const double *a,
+    int n,
+    int type,
+    double omega
+);
+
+int
+initialize_sparse_preconditioner(
+    Preconditioner *preconditioner,
+    const SparseMatrix *a,
+    int type,
+    double omega
+);
+
+void
+release_preconditioner(
+    Preconditioner *preconditioner
+);
+
+void
+apply_preconditioner(
+    double *z,
+    const Preconditioner *preconditioner,
+    const double *r,
+    int n
+);
+
+int
+linear_operator_conjugate_gradient(
+    void (*matrix_vector)(double *, const double *, int, void *),
+    void *user,
+    const Preconditioner *preconditioner,
+    double *x,
+    const double *b,
+    int n,
+    double tolerance,
+    int upper_iter,
+    int *iterations
+);
+
+int
+preconditioned_conjugate_gradient(
+    double **a,
+    const Preconditioner *preconditioner,
+    double *x,
+    const double *b,
+    int n,
+    double tolerance,
+    int upper_iter,
+    int *iterations
+);
+
+int
+packed_preconditioned_conjugate_gradient(
+    const double *a,
+    const Preconditioner *preconditioner,
+    double *x,
+    const double *b,
+    int n,
+    double tolerance,
+    int upper_iter,
+    int *iterations
+);
+
+int
+sparse_preconditioned_conjugate_gradient(
+    const SparseMatrix *a,
+    const Preconditioner *preconditioner,
+    double *x,
+    const double *b,
+    double tolerance,
+    int upper_iter,
+    int *iterations
+);
+
 #endif // OPTIMIZATION_MYMATH_H
 
@@ -0,0 +1,41 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        nelder_mead.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_NELDER_MEAD_H
+#define OPTIMIZATION_NELDER_MEAD_H
+
+#include "non_linear_component.h"
+
+/*
+ * coefficient:
+ *  'a' - adaptive coefficients depending on n (Gao and Han)
+ *  's' - standard coefficients (1, 2, 1/2, 1/2)
+ */
+typedef struct _NelderMeadParameter {
+    char coefficient;
+    double initial_step;
+    double tolerance;
+    int upper_iter;
+} NelderMeadParameter;
+
+/*
+ * The vertices of the initial simplex, the four candidates of an iteration
+ * (reflection, expansion and both contractions) and the vertices after a
+ * shrink are evaluated in parallel when function_object->thread_safe is
+ * set, and one after another when not.
+ */
+int
+nelder_mead(
+    double *x,
+    int n,
+    FunctionObject *function_object,
+    NelderMeadParameter *nelder_mead_parameter
+);
+
+#endif // OPTIMIZATION_NELDER_MEAD_H
@@ -4,15 +4,19 @@
  * File:        non_linear_component.h
  * Version:     0.1.0
  * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
- * Last Change: 09-Jul-2012.
+ * Last Change: 19-Oct-2026.
  */
 
 #ifndef OPTIMIZATION_NON_LINEAR_COMPONENT_H
 #define OPTIMIZATION_NON_LINEAR_COMPONENT_H
 
+#include "perf_counter.h"
+#include "telemetry.h"
+
 extern const double lower_eps;
 extern const int lower_iteration;
 extern const int upper_iteration;
+extern const double sr1_skipping_ratio;
 
 enum NonLinearFunctionStatus {
     NON_LINEAR_FUNCTION_OBJECT_NAN = -1,
@@ -29,22 +33,155 @@ enum NonLinearStatus {
     NON_LINEAR_NO_CONVERGENCE,
     NON_LINEAR_LINE_SEARCH_FAILED,
     NON_LINEAR_NOT_UPDATE,
+    NON_LINEAR_STOPPED,
+};
+
+enum SolverVerbosity {
+    SOLVER_VERBOSITY_SILENT = 0,
+    SOLVER_VERBOSITY_RESULT,
+    SOLVER_VERBOSITY_ITERATION,
+    SOLVER_VERBOSITY_DEBUG,
+};
+
+enum SolverPhase {
+    SOLVER_PHASE_EVALUATION = 0,
+    SOLVER_PHASE_LINE_SEARCH,
+    SOLVER_PHASE_DIRECTION,
+    SOLVER_PHASE_UPDATE,
+    SOLVER_PHASE_VECTOR,
+    SOLVER_PHASE_NUM,
 };
 
+#define SOLVER_TRIAL_BINS 16
+
+/*
+ * Accounting of a solve, measured with the monotonic clock.
+ * phase_seconds:   time in each SolverPhase; the other phases exclude the
+ *                  evaluations of f and gf made inside them
+ * phase_bytes:     estimated memory traffic of the kernels of each phase
+ *                  (one pass over their operands per call)
+ * trials:          trials[k] is the number of iterations with k trials
+ *                  of the line search (the last bin counts k or more)
+ * sor_sweeps:      sweeps of SOR in the direction search of B formula
+ *                  (a symmetric sweep counts as two)
+ * counters:        mask of the PerfCounterEvent counted in phase_counters
+ *                  when the observer has perf_counters (0 otherwise)
+ */
+typedef struct _SolverStatistics {
+    double seconds;
+    double phase_seconds[SOLVER_PHASE_NUM];
+    long int phase_calls[SOLVER_PHASE_NUM];
+    long long int phase_bytes[SOLVER_PHASE_NUM];
+    int iterations;
+    int iteration_f;
+    int iteration_g;
+    int skipped_updates;
+    long int sor_sweeps;
+    int trials[SOLVER_TRIAL_BINS];
+    int counters;
+    unsigned long long phase_counters[SOLVER_PHASE_NUM][PERF_COUNTER_NUM];
+} SolverStatistics;
+
+/*
+ * The state of a solver passed to an observer. g_norm is the measure of
+ * convergence of the method (||gf||_infinity for the gradient methods).
+ */
+typedef struct _SolverIteration {
+    const char *method_name;
+    int iteration;
+    double f;
+    double g_norm;
+    double alpha;
+    int iteration_f;
+    int iteration_g;
+    const SolverStatistics *statistics;
+} SolverIteration;
+
+/*
+ * verbosity:   SOLVER_VERBOSITY_RESULT calls result,
+ *              SOLVER_VERBOSITY_ITERATION calls iteration and message for
+ *              events such as a skipped update as well and
+ *              SOLVER_VERBOSITY_DEBUG calls message for any event
+ * iteration:   called after every iteration; a nonzero return stops the
+ *              solver with NON_LINEAR_STOPPED
+ * result:      called once with the status of the solver
+ * message:     events of the solver such as a skipped update
+ * telemetry:   (optional) receives binary events of the solver regardless
+ *              of verbosity
+ * statistics:  (optional) filled with the SolverStatistics of the solve
+ *              (of the last one when a driver solves several times) and
+ *              passed to result
+ * perf_counters: (optional) hardware counters read around every phase
+ *              when statistics is given
+ * Any callback may be NULL. A solver without an observer is silent.
+ */
+typedef struct _SolverObserver {
+    int verbosity;
+    int     (*iteration)(const SolverIteration *, void *);
+    void    (*result)(int, const SolverIteration *, void *);
+    void    (*message)(const char *, const SolverIteration *, void *);
+    void    *user;
+    TelemetryBuffer *telemetry;
+    SolverStatistics *statistics;
+    PerfCounters *perf_counters;
+} SolverObserver;
+
+/*
+ * user is passed to the callbacks as the last argument, so that an
+ * objective needs no global variable
+ * gradient (optional):
+ *  without it gf is taken from function_gradient, or by finite
+ *  differences of function without either (see finite_difference.h):
+ *  finite_difference is 'c' for central (default) or 'f' for forward
+ *  differences
+ * function_gradient (optional):
+ *  returns f and writes gf into g at the same x, for objectives that share
+ *  the work of both; the solvers use it instead of function and gradient
+ *  when they need both at one point
+ * observer (optional): receives the progress of a solver of this problem
+ * batch_function (optional):
+ *  f[k] = function(x + k * n, n, user) for k = 0, ..., m - 1
+ *  called as batch_function(f, x, n, m, user)
+ * thread_safe:
+ *  nonzero when function may be called from several threads at once, so
+ *  that the solvers evaluate independent points (finite differences, the
+ *  vertices of Nelder-Mead, the population of CMA-ES, the local solves of
+ *  multistart) in parallel; 0 (default) keeps them serial
+ */
 typedef struct _FunctionObject {
-    double  (*function)(const double *, int);
-    void    (*gradient)(double *, const double *, int);
+    double  (*function)(const double *, int, void *);
+    void    (*gradient)(double *, const double *, int, void *);
+    double  (*function_gradient)(double *, const double *, int, void *);
+    void    (*batch_function)(double *, const double *, int, int, void *);
+    void    *user;
+    SolverObserver *observer;
+    char finite_difference;
+    int thread_safe;
 } FunctionObject;
 
 typedef struct _NonLinearComponent {
-    char *method_name;
+    const char *method_name;
+    int iteration;
     int iteration_f;
     int iteration_g;
     double f;
     double alpha;
     FunctionObject *function_object;
+    SolverObserver *observer;
+    TelemetryBuffer *telemetry;
+    SolverStatistics *statistics;
+    PerfCounters *perf_counters;
+    int trials;
+    double started;
 } NonLinearComponent;
 
+typedef struct _PhaseTimer {
+    double started;
+    double evaluation;
+    unsigned long long counter[PERF_COUNTER_NUM];
+    unsigned long long evaluation_counter[PERF_COUNTER_NUM];
+} PhaseTimer;
+
 typedef struct _EvaluateObject {
     int (*function)(
             const double *,
@@ -66,13 +203,75 @@ typedef struct _EvaluateObject {
     FunctionObject *function_object;
 } EvaluateObject;
 
+void
+default_function_object(
+    FunctionObject *function_object
+);
+
 void
 initialize_non_linear_component(
-    char *method_name,
+    const char *method_name,
     FunctionObject *function_object,
     EvaluateObject *evaluate_object,
     NonLinearComponent *component
 );
 
+void
+attach_observer(
+    SolverObserver *observer,
+    NonLinearComponent *component
+);
+
+int
+observe_iteration(
+    int iteration,
+    double g_norm,
+    NonLinearComponent *component
+);
+
+void
+observe_result(
+    int status,
+    int iteration,
+    NonLinearComponent *component
+);
+
+/*
+ * message goes to the observer when its verbosity is at least verbosity
+ */
+void
+observe_message(
+    const char *message,
+    int verbosity,
+    NonLinearComponent *component
+);
+
+void
+observe_update_skipped(
+    NonLinearComponent *component
+);
+
+void
+observe_event(
+    int type,
+    double value0,
+    double value1,
+    NonLinearComponent *component
+);
+
+void
+start_phase(
+    PhaseTimer *timer,
+    NonLinearComponent *component
+);
+
+void
+stop_phase(
+    PhaseTimer *timer,
+    int phase,
+    long long int bytes,
+    NonLinearComponent *component
+);
+
 #endif // OPTIMIZATION_NON_LINEAR_COMPONENT_H
 
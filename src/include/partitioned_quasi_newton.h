@@ -0,0 +1,69 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        partitioned_quasi_newton.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_PARTITIONED_QUASI_NEWTON_H
+#define OPTIMIZATION_PARTITIONED_QUASI_NEWTON_H
+
+#include "non_linear_component.h"
+#include "line_search_component.h"
+#include "quasi_newton.h"
+
+/*
+ * Problem:
+ *  minimize f(x) = f_0(x_[0]) + f_1(x_[1]) + ... + f_E-1(x_[E-1])
+ * where the element variables x_[e] are x[index[k]] for
+ * k = element_start[e], ..., element_start[e + 1] - 1 (E = num_elements).
+ *
+ * function: f_e, called as function(x_e, n_e, e, user) with the n_e
+ *           element variables gathered in x_e
+ * gradient: gf_e written into g_e, called as gradient(g_e, x_e, n_e, e,
+ *           user)
+ * observer: receives the progress of the solver (optional)
+ *
+ * Both callbacks may be called concurrently for different elements.
+ */
+typedef struct _PartiallySeparableObject {
+    int num_elements;
+    const int *element_start;
+    const int *index;
+    double  (*function)(const double *, int, int, void *);
+    void    (*gradient)(double *, const double *, int, int, void *);
+    void    *user;
+    SolverObserver *observer;
+} PartiallySeparableObject;
+
+/*
+ * formula:         'b' - BFGS (default), 's' - SR1 update of every
+ *                  element matrix B_e
+ * cg_upper_iter:   upper bound of the iterations of conjugate gradient
+ *                  solving (sum of U_e^T B_e U_e) d = -g
+ */
+typedef struct _PartitionedQuasiNewtonParameter {
+    char formula;
+    double tolerance;
+    int upper_iter;
+    int cg_upper_iter;
+} PartitionedQuasiNewtonParameter;
+
+/*
+ * Quasi-Newton method keeping a dense n_e x n_e matrix per element
+ * instead of one n x n matrix: memory and the cost of an update are
+ * those of the sum of n_e^2.
+ */
+int
+partitioned_quasi_newton(
+    double *x,
+    int n,
+    PartiallySeparableObject *partially_separable_object,
+    line_search_t line_search,
+    LineSearchParameter *line_search_parameter,
+    PartitionedQuasiNewtonParameter *partitioned_quasi_newton_parameter
+);
+
+#endif // OPTIMIZATION_PARTITIONED_QUASI_NEWTON_H
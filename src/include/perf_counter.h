@@ -0,0 +1,56 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        perf_counter.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_PERF_COUNTER_H
+#define OPTIMIZATION_PERF_COUNTER_H
+
+enum PerfCounterEvent {
+    PERF_COUNTER_CYCLES = 0,
+    PERF_COUNTER_INSTRUCTIONS,
+    PERF_COUNTER_LLC_MISSES,
+    PERF_COUNTER_BRANCH_MISSES,
+    PERF_COUNTER_NUM,
+};
+
+/*
+ * Hardware counters of the calling thread (user space only) opened as one
+ * group with perf_event_open on Linux. An event the machine or the
+ * kernel refuses is left out; when no event can be opened (no Linux,
+ * perf_event_paranoid, seccomp of a container) leader is -1 and reading
+ * gives zeros, so the counters may be attached to an observer anyway.
+ * mask has bit k set for every event k which is counted.
+ * Only the thread which opened the counters is counted: the work of other
+ * threads, such as the OpenMP workers of a parallel phase, is missing
+ * from the counts.
+ */
+typedef struct _PerfCounters {
+    int leader;
+    int num;
+    int mask;
+    int fd[PERF_COUNTER_NUM];
+    int index[PERF_COUNTER_NUM];
+} PerfCounters;
+
+int
+initialize_perf_counters(
+    PerfCounters *counters
+);
+
+void
+release_perf_counters(
+    PerfCounters *counters
+);
+
+int
+read_perf_counters(
+    const PerfCounters *counters,
+    unsigned long long *value
+);
+
+#endif // OPTIMIZATION_PERF_COUNTER_H
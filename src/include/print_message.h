@@ -4,27 +4,53 @@
  * File:        print_message.h
  * Version:     0.1.0
  * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
- * Last Change: 08-Jul-2012.
+ * Last Change: 19-Oct-2026.
  */
 
 #ifndef OPTIMIZATION_PRINT_MESSAGE_H
 #define OPTIMIZATION_PRINT_MESSAGE_H
 
+#include <stdio.h>
+
 #include "non_linear_component.h"
 
+/*
+ * The text output of the solvers as an observer. user of the observer is
+ * the FILE * to write to (NULL means stdout).
+ */
 void
+initialize_print_observer(
+    SolverObserver *observer,
+    int verbosity
+);
+
+int
 print_iteration_info(
-    int iteration,
-    double g_norm,
-    NonLinearComponent *component
+    const SolverIteration *iteration,
+    void *user
 );
 
 void
 print_result_info(
     int status,
-    int iteration,
-    NonLinearComponent *component
+    const SolverIteration *iteration,
+    void *user
 );
 
-#endif // OPTIMIZATION_PRINT_MESSAGE_H
+void
+print_message_info(
+    const char *message,
+    const SolverIteration *iteration,
+    void *user
+);
 
+/*
+ * called by print_result_info when the observer collects statistics
+ */
+void
+print_statistics_info(
+    const SolverStatistics *statistics,
+    FILE *stream
+);
+
+#endif // OPTIMIZATION_PRINT_MESSAGE_H
@@ -12,6 +12,7 @@
 
 #include "non_linear_component.h"
 #include "line_search_component.h"
+#include "solver_context.h"
 
 typedef int (*line_search_t)(
     double *,
@@ -41,5 +42,22 @@ quasi_newton(
     QuasiNewtonParameter *quasi_newton_parameter
 );
 
+/*
+ * same as quasi_newton, but the storage is taken from the arena of a
+ * context made with initialize_solver_context(context, 'q', n, 0), or with
+ * m = 1 when b is given
+ */
+int
+quasi_newton_with_context(
+    SolverContext *context,
+    double *x,
+    double **b,
+    int n,
+    FunctionObject *function_object,
+    line_search_t line_search,
+    LineSearchParameter *line_search_parameter,
+    QuasiNewtonParameter *quasi_newton_parameter
+);
+
 #endif // OPTIMIZATION_QUASI_NEWTON_H
 
@@ -0,0 +1,54 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        quasi_newton_kernels.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_QUASI_NEWTON_KERNELS_H
+#define OPTIMIZATION_QUASI_NEWTON_KERNELS_H
+
+#include "non_linear_component.h"
+
+/*
+ * The BFGS kernels of quasi_newton.c, internal to the library; they are
+ * declared here so that the microbenchmark measures the code the solver
+ * runs.
+ * direction_search_bfgs_H_formula: d = -H g (work is not used)
+ * update_matrix_bfgs_H_formula:    H of the next iteration from s and y,
+ *                                  Hy receives H y
+ * update_matrix_bfgs_B_formula:    B of the next iteration from s and y,
+ *                                  Bs receives B s
+ * The updates return NON_LINEAR_NOT_UPDATE when s'y <= 0.
+ */
+int
+direction_search_bfgs_H_formula(
+    double *d,
+    double **H,
+    double *g,
+    double *work,
+    int n,
+    NonLinearComponent *component
+);
+
+int
+update_matrix_bfgs_H_formula(
+    double **H,
+    const double *s,
+    const double *y,
+    double *Hy,
+    int n
+);
+
+int
+update_matrix_bfgs_B_formula(
+    double **B,
+    const double *s,
+    const double *y,
+    double *Bs,
+    int n
+);
+
+#endif // OPTIMIZATION_QUASI_NEWTON_KERNELS_H
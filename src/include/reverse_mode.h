@@ -0,0 +1,269 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        reverse_mode.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_REVERSE_MODE_H
+#define OPTIMIZATION_REVERSE_MODE_H
+
+#include "non_linear_component.h"
+
+enum TapeOperation {
+    TAPE_INPUT = 0,
+    TAPE_CONSTANT,
+    TAPE_ADD,
+    TAPE_SUB,
+    TAPE_MUL,
+    TAPE_DIV,
+    TAPE_ADD_CONSTANT,
+    TAPE_SCALE,
+    TAPE_SQR,
+    TAPE_SQRT,
+    TAPE_POW,
+    TAPE_EXP,
+    TAPE_LOG,
+    TAPE_SIN,
+    TAPE_COS,
+    TAPE_FABS,
+};
+
+/*
+ * The part of a node the reverse sweep reads: its operands a and b
+ * (indices of earlier nodes, -1 for none) and the partial derivatives of
+ * its value with respect to them. The operation, the constant and the
+ * value of a node are kept in arrays of their own, so that the sweep
+ * streams 24 bytes per node.
+ */
+typedef struct _TapeNode {
+    int a;
+    int b;
+    double da;
+    double db;
+} TapeNode;
+
+typedef struct _TapeVariable {
+    int index;
+} TapeVariable;
+
+/*
+ * The nodes live in arenas that grow by doubling and are kept between
+ * recordings, so that recording allocates nothing once it is warm.
+ * failed is set when the arenas cannot grow; the tape then evaluates to
+ * NaN.
+ */
+typedef struct _Tape {
+    TapeNode *node;
+    int *operation;
+    double *constant;
+    double *value;
+    double *adjoint;
+    int num_nodes;
+    int capacity;
+    int failed;
+} Tape;
+
+/*
+ * function:        (optional) the objective on doubles, for the
+ *                  evaluations of f alone; without it they are taken on
+ *                  the tape, whose forward pass a gradient at the same x
+ *                  then reuses
+ * tape_function:   the objective written with the tape_* operations; it
+ *                  returns the variable of f
+ * user:            passed to both as the last argument
+ * static_control:  nonzero when the operations tape_function records do
+ *                  not depend on x, so that the tape is recorded once and
+ *                  replayed for every later x
+ * The other fields are the state of the adapter: call
+ * release_reverse_mode when done. The adapter is not reentrant, so
+ * concurrent solves need one ReverseModeObject each.
+ */
+typedef struct _ReverseModeObject {
+    double  (*function)(const double *, int, void *);
+    TapeVariable (*tape_function)(Tape *, const TapeVariable *, int,
+            void *);
+    void *user;
+    int static_control;
+    Tape tape;
+    TapeVariable output;
+    TapeVariable *input;
+    double *x;
+    int n;
+    int recorded;
+} ReverseModeObject;
+
+void
+initialize_tape(
+    Tape *tape
+);
+
+void
+release_tape(
+    Tape *tape
+);
+
+/*
+ * Sets function, gradient, function_gradient and user of function_object
+ * so that f is recorded on (or replayed from) the tape of
+ * reverse_mode_object and gf takes one reverse sweep over it.
+ */
+void
+initialize_reverse_mode(
+    FunctionObject *function_object,
+    ReverseModeObject *reverse_mode_object
+);
+
+void
+release_reverse_mode(
+    ReverseModeObject *reverse_mode_object
+);
+
+double
+reverse_mode_function(
+    const double *x,
+    int n,
+    void *user
+);
+
+void
+reverse_mode_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+);
+
+double
+reverse_mode_function_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+);
+
+/*
+ * the operations recorded on the tape
+ */
+TapeVariable
+tape_input(
+    Tape *tape,
+    double value
+);
+
+TapeVariable
+tape_constant(
+    Tape *tape,
+    double c
+);
+
+double
+tape_value(
+    const Tape *tape,
+    TapeVariable a
+);
+
+TapeVariable
+tape_add(
+    Tape *tape,
+    TapeVariable a,
+    TapeVariable b
+);
+
+TapeVariable
+tape_sub(
+    Tape *tape,
+    TapeVariable a,
+    TapeVariable b
+);
+
+TapeVariable
+tape_mul(
+    Tape *tape,
+    TapeVariable a,
+    TapeVariable b
+);
+
+TapeVariable
+tape_div(
+    Tape *tape,
+    TapeVariable a,
+    TapeVariable b
+);
+
+TapeVariable
+tape_add_constant(
+    Tape *tape,
+    TapeVariable a,
+    double c
+);
+
+TapeVariable
+tape_scale(
+    Tape *tape,
+    TapeVariable a,
+    double c
+);
+
+TapeVariable
+tape_sqr(
+    Tape *tape,
+    TapeVariable a
+);
+
+TapeVariable
+tape_sqrt(
+    Tape *tape,
+    TapeVariable a
+);
+
+TapeVariable
+tape_pow(
+    Tape *tape,
+    TapeVariable a,
+    double p
+);
+
+TapeVariable
+tape_exp(
+    Tape *tape,
+    TapeVariable a
+);
+
+TapeVariable
+tape_log(
+    Tape *tape,
+    TapeVariable a
+);
+
+TapeVariable
+tape_sin(
+    Tape *tape,
+    TapeVariable a
+);
+
+TapeVariable
+tape_cos(
+    Tape *tape,
+    TapeVariable a
+);
+
+TapeVariable
+tape_fabs(
+    Tape *tape,
+    TapeVariable a
+);
+
+/*
+ * the adjoints of every node, i.e. the derivatives of output with respect
+ * to them, after one reverse sweep (inputs come first on the tape)
+ */
+void
+tape_reverse_sweep(
+    Tape *tape,
+    TapeVariable output
+);
+
+#endif // OPTIMIZATION_REVERSE_MODE_H
@@ -0,0 +1,65 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        solver_context.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_SOLVER_CONTEXT_H
+#define OPTIMIZATION_SOLVER_CONTEXT_H
+
+/*
+ * A solver context owns one arena which is sized once for (solver, n, m)
+ * and is reused by every solve run with it, so that a solve allocates
+ * nothing. A context must not be used by two solves at the same time.
+ *
+ * solver:
+ *  'q' - quasi_newton_with_context
+ *  'c' - conjugate_gradient_with_context
+ *  't' - trust_region_with_context
+ * m:   memory of the limited memory formula of trust region, or 1 for
+ *      quasi newton whose b is given by the caller (0 for the others)
+ */
+typedef struct _SolverContext {
+    char solver;
+    int n;
+    int m;
+    long int capacity;
+    long int offset;
+    char *arena;
+} SolverContext;
+
+long int
+solver_context_size(
+    char solver,
+    int n,
+    int m
+);
+
+int
+initialize_solver_context(
+    SolverContext *context,
+    char solver,
+    int n,
+    int m
+);
+
+void *
+solver_context_allocate(
+    SolverContext *context,
+    long int size
+);
+
+void
+reset_solver_context(
+    SolverContext *context
+);
+
+void
+release_solver_context(
+    SolverContext *context
+);
+
+#endif // OPTIMIZATION_SOLVER_CONTEXT_H
@@ -0,0 +1,90 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        sparse_difference.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_SPARSE_DIFFERENCE_H
+#define OPTIMIZATION_SPARSE_DIFFERENCE_H
+
+#include "mymath.h"
+#include "non_linear_component.h"
+
+/*
+ * Sparse Jacobians and Hessians by differences along grouped columns.
+ * The sparsity pattern is given as a SparseMatrix whose values are
+ * ignored; the estimates are written into its values, so that the result
+ * is a CSR matrix for the sparse solvers of mymath.h.
+ *
+ * column_coloring:  Curtis-Powell-Reid; columns sharing a row get
+ *                   different colors (distance-2 coloring)
+ * star_coloring:    for a symmetric pattern; a distance-1 coloring in
+ *                   which every path on four vertices uses three colors,
+ *                   so that each H_ij is recovered directly from H d_c of
+ *                   color(j) or, by symmetry, of color(i)
+ * Both write color[j] in 0, ..., num_colors - 1 for every column j and
+ * return num_colors, or MY_MATH_OUT_OF_MEMORY.
+ */
+int
+column_coloring(
+    const SparseMatrix *pattern,
+    int *color
+);
+
+int
+star_coloring(
+    const SparseMatrix *pattern,
+    int *color
+);
+
+/*
+ * residual:    r = residual(x) in R^m for x in R^n,
+ *              called as residual(r, x, n, m, user)
+ * thread_safe: nonzero when residual may be called from several threads
+ *              at once, so that the colors are differenced in parallel;
+ *              0 keeps them serial
+ */
+typedef struct _ResidualObject {
+    void    (*residual)(double *, const double *, int, int, void *);
+    int     m;
+    void    *user;
+    int     thread_safe;
+} ResidualObject;
+
+/*
+ * J (pattern m x n) at x from num_colors + 1 residuals; color from
+ * column_coloring of the same pattern
+ */
+int
+sparse_jacobian(
+    SparseMatrix *jacobian,
+    const double *x,
+    int n,
+    ResidualObject *residual_object,
+    const int *color,
+    int num_colors
+);
+
+/*
+ * H (symmetric pattern n x n) at x from num_colors + 1 gradients of
+ * function_object; color from star_coloring or column_coloring of the
+ * same pattern. The estimate is symmetric.
+ * With a gradient the error is about eps^(1/2) (eps = DBL_EPSILON).
+ * Without one, H takes 2 num_colors central differences of gradients
+ * which are finite differences of f, and the error is about
+ * eps^(4/9) |f|, that is about 1e-7 |f|.
+ */
+int
+sparse_hessian(
+    SparseMatrix *hessian,
+    const double *x,
+    int n,
+    FunctionObject *function_object,
+    const int *color,
+    int num_colors
+);
+
+#endif // OPTIMIZATION_SPARSE_DIFFERENCE_H
@@ -0,0 +1,63 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        stochastic_gradient.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_STOCHASTIC_GRADIENT_H
+#define OPTIMIZATION_STOCHASTIC_GRADIENT_H
+
+#include "non_linear_component.h"
+
+/*
+ * Problem:
+ *  minimize F(x) = (f_0(x) + f_1(x) + ... + f_N-1(x)) / N
+ *
+ * function: sum of f_i(x) over the terms of index[0], ..., index[batch - 1]
+ * gradient: sum of gf_i(x) over the same terms, written into g
+ * user:     passed to both callbacks as the last argument
+ * observer: receives the progress of the solver (optional)
+ *
+ * Both callbacks may be called concurrently from several threads with
+ * disjoint batches.
+ */
+typedef struct _FiniteSumObject {
+    int num_terms;
+    double  (*function)(const double *, int, const int *, int, void *);
+    void    (*gradient)(double *, const double *, int, const int *, int,
+                void *);
+    void    *user;
+    SolverObserver *observer;
+} FiniteSumObject;
+
+/*
+ * method:
+ *  's' - mini-batch SGD with step / (1 + decay * epoch)
+ *  'a' - Adam
+ *  'v' - SVRG (the snapshot is taken at the beginning of each epoch)
+ */
+typedef struct _StochasticGradientParameter {
+    char method;
+    int batch_size;
+    double step;
+    double decay;
+    double beta1;
+    double beta2;
+    double epsilon;
+    double tolerance;
+    int upper_iter;
+    unsigned int seed;
+} StochasticGradientParameter;
+
+int
+stochastic_gradient(
+    double *x,
+    int n,
+    FiniteSumObject *finite_sum_object,
+    StochasticGradientParameter *stochastic_gradient_parameter
+);
+
+#endif // OPTIMIZATION_STOCHASTIC_GRADIENT_H
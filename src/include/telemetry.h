@@ -0,0 +1,116 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        telemetry.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_TELEMETRY_H
+#define OPTIMIZATION_TELEMETRY_H
+
+#include <stdio.h>
+
+#define TELEMETRY_MAGIC "OPTTLM01"
+
+enum TelemetryEventType {
+    TELEMETRY_SOLVE_BEGIN = 1,
+    TELEMETRY_SOLVE_END,
+    TELEMETRY_ITERATION_BEGIN,
+    TELEMETRY_ITERATION_END,
+    TELEMETRY_LINE_SEARCH_TRIAL,
+    TELEMETRY_UPDATE_SKIPPED,
+    TELEMETRY_EVALUATION_BEGIN,
+    TELEMETRY_EVALUATION_END,
+};
+
+enum TelemetryEvaluation {
+    TELEMETRY_EVALUATION_FUNCTION = 0,
+    TELEMETRY_EVALUATION_GRADIENT,
+    TELEMETRY_EVALUATION_FUNCTION_GRADIENT,
+};
+
+/*
+ * One event of 32 bytes. timestamp is in ticks of the time stamp counter
+ * (nanoseconds where there is no counter).
+ *  SOLVE_END:          value = status, iterations
+ *  ITERATION_END:      value = f, ||gf||
+ *  LINE_SEARCH_TRIAL:  value = beta, f(x + beta * d)
+ *  EVALUATION_*:       value = TelemetryEvaluation, 0
+ */
+typedef struct _TelemetryEvent {
+    unsigned long long timestamp;
+    int type;
+    int iteration;
+    double value[2];
+} TelemetryEvent;
+
+/*
+ * A ring buffer with one writer, the solver. head counts the events ever
+ * written and is published with a release store after each event, so
+ * that another thread can take a snapshot while the solver runs.
+ */
+typedef struct _TelemetryBuffer {
+    unsigned long long head;
+    unsigned long long capacity;
+    unsigned long long tick_origin;
+    long long int nanosecond_origin;
+    TelemetryEvent *event;
+} TelemetryBuffer;
+
+/*
+ * Header of a dumped buffer, followed by num_events events from the
+ * oldest one.
+ */
+typedef struct _TelemetryHeader {
+    char magic[8];
+    unsigned long long num_events;
+    unsigned long long num_lost;
+    double ticks_per_second;
+} TelemetryHeader;
+
+int
+initialize_telemetry_buffer(
+    TelemetryBuffer *buffer,
+    long int capacity
+);
+
+void
+reset_telemetry_buffer(
+    TelemetryBuffer *buffer
+);
+
+void
+release_telemetry_buffer(
+    TelemetryBuffer *buffer
+);
+
+unsigned long long
+telemetry_timestamp(
+    void
+);
+
+void
+record_telemetry_event(
+    TelemetryBuffer *buffer,
+    int type,
+    int iteration,
+    double value0,
+    double value1
+);
+
+long int
+read_telemetry_events(
+    const TelemetryBuffer *buffer,
+    TelemetryEvent *event,
+    long int num
+);
+
+int
+dump_telemetry_buffer(
+    const TelemetryBuffer *buffer,
+    FILE *stream
+);
+
+#endif // OPTIMIZATION_TELEMETRY_H
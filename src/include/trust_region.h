@@ -0,0 +1,55 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        trust_region.h
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ */
+
+#ifndef OPTIMIZATION_TRUST_REGION_H
+#define OPTIMIZATION_TRUST_REGION_H
+
+#include "non_linear_component.h"
+#include "solver_context.h"
+
+/*
+ * formula:
+ *  's' - SR1 with a dense matrix B (b is used if it is given)
+ *  'l' - limited memory SR1 in the compact form (b is not used)
+ */
+typedef struct _TrustRegionParameter {
+    char formula;
+    int memory;
+    double tolerance;
+    int upper_iter;
+    double initial_radius;
+    double max_radius;
+    double eta;
+} TrustRegionParameter;
+
+int
+trust_region(
+    double *x,
+    double **b,
+    int n,
+    FunctionObject *function_object,
+    TrustRegionParameter *trust_region_parameter
+);
+
+/*
+ * same as trust_region, but the storage is taken from the arena of a
+ * context made with initialize_solver_context(context, 't', n, m), where
+ * m is the memory of the formula 'l' (0 for 's')
+ */
+int
+trust_region_with_context(
+    SolverContext *context,
+    double *x,
+    double **b,
+    int n,
+    FunctionObject *function_object,
+    TrustRegionParameter *trust_region_parameter
+);
+
+#endif // OPTIMIZATION_TRUST_REGION_H
@@ -0,0 +1,510 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        multistart.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/multistart.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "include/finite_difference.h"
+#include "include/mymath.h"
+
+#define SOBOL_DIMENSION 16
+#define SOBOL_BITS 32
+
+/*
+ * primitive polynomials (degree s and coefficients a) and initial
+ * direction numbers m_1, ..., m_s of Joe and Kuo for dimensions 2 to 16;
+ * the first dimension is the van der Corput sequence
+ */
+static const int sobol_s[SOBOL_DIMENSION - 1] = {
+    1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6
+};
+static const int sobol_a[SOBOL_DIMENSION - 1] = {
+    0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16
+};
+static const unsigned int sobol_m[SOBOL_DIMENSION - 1][6] = {
+    {1}, {1, 3}, {1, 3, 1}, {1, 1, 1}, {1, 1, 3, 3}, {1, 3, 5, 13},
+    {1, 1, 5, 5, 17}, {1, 1, 5, 5, 5}, {1, 1, 7, 11, 19}, {1, 1, 5, 1, 1},
+    {1, 1, 1, 3, 11}, {1, 3, 5, 5, 31}, {1, 3, 3, 9, 7, 49},
+    {1, 1, 1, 15, 21, 21}, {1, 3, 1, 13, 27, 49}
+};
+
+/*
+ * The state shared by all threads. Minimizers are published into slots
+ * reserved with an atomic counter; a slot is readable once its flag is set.
+ * The incumbent is the index of the best slot and is replaced with CAS.
+ */
+typedef struct _MultistartShared {
+    int n;
+    long int budget;
+    double radius;
+    long int evaluations;
+    int num_reserved;
+    int incumbent;
+    int *ready;
+    double *minimizer;
+    double *f_minimizer;
+    FunctionObject *function_object;
+} MultistartShared;
+
+/*
+ * The state of one local solve, which is the user data of the wrapped
+ * FunctionObject of the thread.
+ */
+typedef struct _LocalSolve {
+    int pruned;
+    int exhausted;
+    MultistartShared *shared;
+} LocalSolve;
+
+static void
+default_multistart_parameter(
+    MultistartParameter *parameter
+);
+
+static void
+sobol_points(
+    double *point,
+    int num,
+    int n
+);
+
+static void
+latin_hypercube_points(
+    double *point,
+    int num,
+    int n,
+    unsigned int seed
+);
+
+static int
+near_minimizer(
+    const double *x,
+    MultistartShared *shared
+);
+
+static void
+publish_minimizer(
+    const double *x,
+    double f,
+    MultistartShared *shared
+);
+
+static double
+budget_function(
+    const double *x,
+    int n,
+    void *user
+);
+
+static void
+budget_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+);
+
+int
+multistart(
+    double *x,
+    int n,
+    FunctionObject *function_object,
+    MultistartParameter *multistart_parameter,
+    MultistartResult *multistart_result
+) {
+    int i, status, num_threads, num_solves, num_pruned, num_starts;
+    double *point, *work;
+    MultistartShared shared;
+
+    point = work = NULL;
+    shared.ready = NULL;
+    shared.minimizer = NULL;
+    num_solves = num_pruned = 0;
+
+    /* make sure that f of this problem exists (gf may be differenced) */
+    if (NULL == function_object->function) {
+        return NON_LINEAR_NO_FUNCTION;
+    }
+    if (NULL == multistart_parameter
+            || NULL == multistart_parameter->lower
+            || NULL == multistart_parameter->upper
+            || NULL == multistart_parameter->line_search
+            || NULL == multistart_parameter->line_search_parameter) {
+        return NON_LINEAR_NO_PARAMETER;
+    }
+    default_multistart_parameter(multistart_parameter);
+    num_starts = multistart_parameter->num_starts;
+
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#else
+    num_threads = 1;
+#endif
+    /*
+     * allocate memory to storage
+     *  point:  starting points (num_starts * n)
+     *  work:   iterate of each thread (num_threads * n)
+     */
+    if (NULL == (point = (double *)malloc(sizeof(double)
+                    * (num_starts + num_threads) * n))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    work = point + num_starts * n;
+    if (NULL == (shared.minimizer = (double *)malloc(sizeof(double)
+                    * num_starts * (n + 1)))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    shared.f_minimizer = shared.minimizer + num_starts * n;
+    if (NULL == (shared.ready = (int *)malloc(sizeof(int) * num_starts))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    for (i = 0; i < num_starts; ++i) {
+        shared.ready[i] = 0;
+    }
+    shared.n = n;
+    shared.budget = multistart_parameter->budget;
+    shared.radius = multistart_parameter->basin_radius;
+    shared.evaluations = 0;
+    shared.num_reserved = 0;
+    shared.incumbent = -1;
+    shared.function_object = function_object;
+
+    /* starting points in [0, 1)^n scaled into [lower, upper] */
+    if ('s' == multistart_parameter->sampling && n <= SOBOL_DIMENSION) {
+        sobol_points(point, num_starts, n);
+    } else {
+        latin_hypercube_points(point, num_starts, n,
+                multistart_parameter->seed);
+    }
+    for (i = 0; i < num_starts * n; ++i) {
+        point[i] = multistart_parameter->lower[i % n] + point[i]
+            * (multistart_parameter->upper[i % n]
+                    - multistart_parameter->lower[i % n]);
+    }
+
+    /*
+     * start to compute local solves, in parallel when function_object
+     * may be called from several threads at once
+     */
+#pragma omp parallel for schedule(dynamic, 1) \
+    reduction(+:num_solves, num_pruned) if (function_object->thread_safe)
+    for (i = 0; i < num_starts; ++i) {
+        int id, local_status;
+        double f, *x_local;
+        LocalSolve solve;
+        FunctionObject budget_function_object;
+        QuasiNewtonParameter quasi_newton_parameter;
+        ConjugateGradientParameter conjugate_gradient_parameter;
+        LineSearchParameter line_search_parameter;
+
+        if (shared.budget > 0 && __atomic_load_n(
+                    &shared.evaluations, __ATOMIC_RELAXED) >= shared.budget)
+            continue;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+#else
+        id = 0;
+#endif
+        x_local = work + id * n;
+        memcpy(x_local, point + i * n, sizeof(double) * n);
+        /* a start already lying in a known basin is not solved at all */
+        if (near_minimizer(x_local, &shared)) {
+            num_pruned++;
+            continue;
+        }
+        solve.pruned = 0;
+        solve.exhausted = 0;
+        solve.shared = &shared;
+        default_function_object(&budget_function_object);
+        budget_function_object.function = budget_function;
+        budget_function_object.gradient = budget_gradient;
+        budget_function_object.user = &solve;
+        /* solvers write the default values back into their parameter, so
+         * each thread works on its own copy */
+        line_search_parameter = *multistart_parameter->line_search_parameter;
+        if ('c' == multistart_parameter->solver) {
+            if (NULL != multistart_parameter->conjugate_gradient_parameter) {
+                conjugate_gradient_parameter =
+                    *multistart_parameter->conjugate_gradient_parameter;
+            } else {
+                memset(&conjugate_gradient_parameter, 0,
+                        sizeof(ConjugateGradientParameter));
+            }
+            local_status = conjugate_gradient(x_local, n,
+                    &budget_function_object, multistart_parameter->line_search,
+                    &line_search_parameter, &conjugate_gradient_parameter);
+        } else {
+            if (NULL != multistart_parameter->quasi_newton_parameter) {
+                quasi_newton_parameter =
+                    *multistart_parameter->quasi_newton_parameter;
+            } else {
+                memset(&quasi_newton_parameter, 0,
+                        sizeof(QuasiNewtonParameter));
+            }
+            local_status = quasi_newton(x_local, NULL, n,
+                    &budget_function_object, multistart_parameter->line_search,
+                    &line_search_parameter, &quasi_newton_parameter);
+        }
+        if (solve.pruned) {
+            num_pruned++;
+            continue;
+        }
+        if (solve.exhausted)
+            continue;
+        num_solves++;
+        if (NON_LINEAR_SATISFIED != local_status
+                && NON_LINEAR_LINE_SEARCH_FAILED != local_status
+                && NON_LINEAR_NO_CONVERGENCE != local_status)
+            continue;
+        f = function_object->function(x_local, n, function_object->user);
+        __atomic_add_fetch(&shared.evaluations, 1, __ATOMIC_RELAXED);
+        if (f == f && !near_minimizer(x_local, &shared))
+            publish_minimizer(x_local, f, &shared);
+    }
+
+    if (shared.incumbent >= 0) {
+        memcpy(x, shared.minimizer + shared.incumbent * n,
+                sizeof(double) * n);
+        status = NON_LINEAR_SATISFIED;
+    } else {
+        status = NON_LINEAR_NO_CONVERGENCE;
+    }
+    if (NULL != multistart_result) {
+        multistart_result->f = shared.incumbent >= 0
+            ? shared.f_minimizer[shared.incumbent] : HUGE_VAL;
+        multistart_result->num_solves = num_solves;
+        multistart_result->num_pruned = num_pruned;
+        multistart_result->num_minima = shared.num_reserved;
+        multistart_result->evaluations = shared.evaluations;
+    }
+result:
+    /* release memory of point, minimizer and ready */
+    if (NULL != point) {
+        free(point);
+        point = NULL;
+    }
+    if (NULL != shared.minimizer) {
+        free(shared.minimizer);
+        shared.minimizer = NULL;
+    }
+    if (NULL != shared.ready) {
+        free(shared.ready);
+        shared.ready = NULL;
+    }
+
+    return status;
+}
+
+static void
+default_multistart_parameter(
+    MultistartParameter *parameter
+) {
+    parameter->sampling =
+        'l' == parameter->sampling || 'L' == parameter->sampling ? 'l' : 's';
+    parameter->solver =
+        'c' == parameter->solver || 'C' == parameter->solver ? 'c' : 'q';
+    parameter->num_starts =
+        parameter->num_starts > 0 ? parameter->num_starts : 64;
+    parameter->budget = parameter->budget > 0 ? parameter->budget : 0;
+    parameter->basin_radius =
+        parameter->basin_radius > 0. ? parameter->basin_radius : 1.e-2;
+    parameter->seed = parameter->seed ? parameter->seed : 2463534242u;
+}
+
+static void
+sobol_points(
+    double *point,
+    int num,
+    int n
+) {
+    /*
+     * Gray code construction of Antonov and Saleev. The first point (the
+     * origin) is skipped.
+     */
+    int i, j, k, s, c;
+    unsigned int v[SOBOL_DIMENSION][SOBOL_BITS], x[SOBOL_DIMENSION], index;
+
+    for (k = 0; k < SOBOL_BITS; ++k) {
+        v[0][k] = 1u << (SOBOL_BITS - 1 - k);
+    }
+    for (j = 1; j < n; ++j) {
+        s = sobol_s[j - 1];
+        for (k = 0; k < s; ++k) {
+            v[j][k] = sobol_m[j - 1][k] << (SOBOL_BITS - 1 - k);
+        }
+        for (k = s; k < SOBOL_BITS; ++k) {
+            v[j][k] = v[j][k - s] ^ (v[j][k - s] >> s);
+            for (i = 1; i < s; ++i) {
+                if ((sobol_a[j - 1] >> (s - 1 - i)) & 1)
+                    v[j][k] ^= v[j][k - i];
+            }
+        }
+    }
+    for (j = 0; j < n; ++j) {
+        x[j] = 0;
+    }
+    for (i = 0, index = 0; i < num; ++i, ++index) {
+        /* c is the position of the lowest zero bit of index */
+        for (c = 0; (index >> c) & 1; ++c)
+            ;
+        for (j = 0; j < n; ++j) {
+            x[j] ^= v[j][c];
+            point[i * n + j] = (double)x[j] / 4294967296.;
+        }
+    }
+}
+
+static void
+latin_hypercube_points(
+    double *point,
+    int num,
+    int n,
+    unsigned int seed
+) {
+    /*
+     * Each coordinate takes one point from every stratum [k / num,
+     * (k + 1) / num); the strata are shuffled with xorshift32.
+     */
+    int i, j, k;
+    unsigned int state;
+    double temp;
+
+    state = seed;
+    for (j = 0; j < n; ++j) {
+        for (i = 0; i < num; ++i) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            point[i * n + j] = (i + (double)state / 4294967296.) / num;
+        }
+        for (i = num - 1; i > 0; --i) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            k = (int)(state % (unsigned int)(i + 1));
+            temp = point[i * n + j];
+            point[i * n + j] = point[k * n + j];
+            point[k * n + j] = temp;
+        }
+    }
+}
+
+static int
+near_minimizer(
+    const double *x,
+    MultistartShared *shared
+) {
+    int i, j, num, n;
+    double d, temp, *minimizer;
+
+    n = shared->n;
+    num = __atomic_load_n(&shared->num_reserved, __ATOMIC_ACQUIRE);
+    for (i = 0; i < num; ++i) {
+        if (!__atomic_load_n(&shared->ready[i], __ATOMIC_ACQUIRE))
+            continue;
+        minimizer = shared->minimizer + i * n;
+        for (j = 0, d = 0.; j < n; ++j) {
+            temp = x[j] - minimizer[j];
+            d += temp * temp;
+        }
+        if (d < shared->radius * shared->radius)
+            return 1;
+    }
+    return 0;
+}
+
+static void
+publish_minimizer(
+    const double *x,
+    double f,
+    MultistartShared *shared
+) {
+    int slot, incumbent;
+
+    slot = __atomic_fetch_add(&shared->num_reserved, 1, __ATOMIC_ACQ_REL);
+    memcpy(shared->minimizer + slot * shared->n, x,
+            sizeof(double) * shared->n);
+    shared->f_minimizer[slot] = f;
+    __atomic_store_n(&shared->ready[slot], 1, __ATOMIC_RELEASE);
+    /* replace the incumbent while this minimizer is better */
+    incumbent = __atomic_load_n(&shared->incumbent, __ATOMIC_ACQUIRE);
+    while (incumbent < 0 || f < shared->f_minimizer[incumbent]) {
+        if (__atomic_compare_exchange_n(&shared->incumbent, &incumbent, slot,
+                    0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            break;
+    }
+}
+
+static double
+budget_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    LocalSolve *solve = (LocalSolve *)user;
+    MultistartShared *shared = solve->shared;
+
+    if (__atomic_add_fetch(&shared->evaluations, 1, __ATOMIC_RELAXED)
+            > shared->budget && shared->budget > 0) {
+        /* Not a Number stops the local solver */
+        solve->exhausted = 1;
+        return NAN;
+    }
+    return shared->function_object->function(
+            x, n, shared->function_object->user);
+}
+
+static void
+budget_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    int count;
+    LocalSolve *solve = (LocalSolve *)user;
+    MultistartShared *shared = solve->shared;
+
+    if (__atomic_add_fetch(&shared->evaluations, 1, __ATOMIC_RELAXED)
+            > shared->budget && shared->budget > 0) {
+        solve->exhausted = 1;
+        g[0] = NAN;
+        return;
+    }
+    /* the iterate has drifted into a basin which is already known */
+    if (near_minimizer(x, shared)) {
+        solve->pruned = 1;
+        g[0] = NAN;
+        return;
+    }
+    if (NULL != shared->function_object->gradient) {
+        shared->function_object->gradient(
+                g, x, n, shared->function_object->user);
+    } else if (NULL != shared->function_object->function_gradient) {
+        shared->function_object->function_gradient(
+                g, x, n, shared->function_object->user);
+    } else if (0 > (count = finite_difference_gradient(
+                    g, NULL, x, n, shared->function_object))) {
+        g[0] = NAN;
+    } else {
+        /* the differences are charged to the budget as well */
+        __atomic_add_fetch(&shared->evaluations, count, __ATOMIC_RELAXED);
+    }
+}
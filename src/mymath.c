@@ -4,12 +4,14 @@
  * File:        mymath.c
  * Version:     0.1.0
  * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
- * Last Change: 12-Jul-2012.
+ * Last Change: 19-Oct-2026.
  */
 
 #include "include/mymath.h"
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 /*
  * Libraries of Vector
@@ -93,10 +95,56 @@ infinity_norm(
     return norm;
 }
 
+/* sweeps after a change of the relaxation within which its rate is judged */
+#define SOR_CHECK_SWEEPS 25
+
+/*
+ * One sweep of SOR over the rows of a in increasing order, or decreasing
+ * when backward; delta receives ||x_new - x_old||_2^2.
+ * returns max |x_new - x_old|, Not a Number as soon as a change is, or -1
+ * when a diagonal entry is zero
+ */
+static double
+sor_sweep(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    double omega,
+    int backward,
+    double *delta
+) {
+    int i, j, k;
+    double norm, temp, x_old;
+
+    for (k = 0, norm = *delta = 0.; k < n; ++k) {
+        i = backward ? n - 1 - k : k;
+        x_old = x[i];
+        temp = b[i];
+        for (j = 0; j < i; ++j)
+            temp -= a[i][j] * x[j];
+        for (j = i + 1; j < n; ++j)
+            temp -= a[i][j] * x[j];
+        if (0. == a[i][i])
+            return -1.;
+        x[i] = x_old + omega * (temp / a[i][i] - x_old);
+        temp = fabs(x[i] - x_old);
+        if (temp != temp)
+            return temp;
+        *delta += temp * temp;
+        if (norm < temp)
+            norm = temp;
+    }
+    return norm;
+}
+
 /*
  * Libraries of Methematical Analysis
  *  - gauss_seidel
  *  - successive_over_relaxation
+ *  - successive_over_relaxation_sweeps
+ *  - adaptive_successive_over_relaxation
+ *  - chebyshev_symmetric_successive_over_relaxation
  */
 int
 gauss_seidel(
@@ -122,30 +170,1141 @@ successive_over_relaxation(
     int n,
     double epsilon,
     double omega
+) {
+    int sweeps;
+    return successive_over_relaxation_sweeps(
+            a, x, b, n, epsilon, omega, &sweeps);
+}
+
+int
+successive_over_relaxation_sweeps(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    double epsilon,
+    double omega,
+    int *sweeps
+) {
+    double norm, delta;
+    *sweeps = 0;
+    do {
+        ++*sweeps;
+        if (0. > (norm = sor_sweep(a, x, b, n, omega, 0, &delta)))
+            return MY_MATH_FAILED;
+        if (norm != norm)
+            return MY_MATH_FUNCTION_NAN;
+    } while(norm > epsilon);
+    return MY_MATH_SATISFIED;
+}
+
+int
+adaptive_successive_over_relaxation(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    double epsilon,
+    double *omega,
+    int *sweeps
 ) {
     /*
-     * TODO:
-     *  Error Handling if you get a value of singular as Zero.
+     * The observed ratio of ||x_new - x_old||_2 of two sweeps with the same
+     * omega estimates the spectral radius lambda of the SOR iteration; when
+     * lambda > (omega - 1)^0.75, omega is below the optimum, and
+     *  mu^2 = (lambda + omega - 1)^2 / (lambda omega^2)
+     * estimates the spectral radius of Jacobi, giving
+     *  omega = 2 / (1 + sqrt(1 - mu^2))
+     * The estimate holds for consistently ordered a; for others it may
+     * overshoot, so an omega that converges slower than the initial one is
+     * taken back to the previous one and kept.
      */
-    int i, j;
-    double norm, temp, x_old;
+    int count, stable, frozen;
+    double norm, delta, delta_old, delta_first, ratio, ratio_old, rate,
+           measured, omega_first, omega_old, mu2, estimate;
+
+    *omega = 1. <= *omega && 2. > *omega ? *omega : 1.;
+    omega_first = omega_old = *omega;
+    *sweeps = count = frozen = 0;
+    delta_old = delta_first = ratio_old = 0.;
+    rate = 1.;
     do {
-        for (i = 0, norm = 0.; i < n; ++i) {
-            x_old = x[i];
-            temp = b[i];
-            for (j = 0; j < i; ++j)
-                temp -= a[i][j] * x[j];
-            for (j = i + 1; j < n; ++j)
+        ++*sweeps;
+        if (0. > (norm = sor_sweep(a, x, b, n, *omega, 0, &delta)))
+            return MY_MATH_FAILED;
+        if (norm != norm)
+            return MY_MATH_FUNCTION_NAN;
+        delta = sqrt(delta);
+        ratio = 0. < delta_old ? delta / delta_old : 0.;
+        if (1 == ++count)
+            delta_first = delta;
+        stable = count >= 3 && 1. > ratio
+            && fabs(ratio - ratio_old) < 0.01 * (1. - ratio);
+        if (!frozen && omega_first != *omega) {
+            measured = stable ? ratio : 0 == count % SOR_CHECK_SWEEPS
+                ? pow(delta / delta_first, 1. / (count - 1)) : 0.;
+            if (measured >= rate) {
+                *omega = omega_old;
+                frozen = 1;
+            }
+        }
+        if (!frozen && stable && ratio > pow(*omega - 1., 0.75)) {
+            mu2 = (ratio + *omega - 1.) * (ratio + *omega - 1.)
+                / (ratio * *omega * *omega);
+            estimate = 1. > mu2 ? 2. / (1. + sqrt(1. - mu2)) : *omega;
+            if (estimate > *omega + 1.e-3) {
+                if (omega_first == *omega)
+                    rate = ratio;
+                omega_old = *omega;
+                *omega = estimate;
+                count = 0;
+            }
+        }
+        delta_old = delta;
+        ratio_old = ratio;
+    } while (norm > epsilon);
+    return MY_MATH_SATISFIED;
+}
+
+int
+chebyshev_symmetric_successive_over_relaxation(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    double epsilon,
+    double omega,
+    int upper_sweeps,
+    double *work,
+    int *sweeps
+) {
+    /*
+     * The eigenvalues of SSOR lie in [0, rho] for a symmetric positive
+     * definite a. The step is extrapolated by gamma = 2 / (2 - rho) onto
+     * [-sigma, sigma], sigma = rho / (2 - rho), and accelerated by
+     *  x_k+1 = x_k-1 + w_k+1 (gamma (SSOR(x_k) - x_k) + x_k - x_k-1)
+     *  w_1 = 1, w_2 = 1 / (1 - sigma^2 / 2), w_k+1 = 1 / (1 - sigma^2 w_k / 4)
+     * rho is first the ratio of the changes of plain sweeps. While it is
+     * too small, the changes shrink by a ratio q above that of Chebyshev,
+     *  r = sigma / (1 + sqrt(1 - sigma^2)),
+     * and the eigenvalue that q belongs to is
+     *  sigma' = sigma (c + 1 / c) / 2, c = q (1 + sqrt(1 - sigma^2)) / sigma
+     * from which rho is taken again and the acceleration starts over.
+     */
+    int i, k, status;
+    double norm, temp, delta, delta_old, ratio, ratio_old, rho, gamma,
+           sigma, w, c;
+    double *previous, *current;
+
+    previous = work;
+    current = previous + n;
+    *sweeps = k = 0;
+    delta_old = ratio_old = sigma = w = gamma = 0.;
+    status = MY_MATH_SATISFIED;
+    do {
+        ++*sweeps;
+        memcpy(current, x, sizeof(double) * n);
+        if (0. > sor_sweep(a, x, b, n, omega, 0, &delta)
+                || 0. > sor_sweep(a, x, b, n, omega, 1, &delta)) {
+            status = MY_MATH_FAILED;
+            goto result;
+        }
+        if (0 < k) {
+            w = 1 == k ? 1. : 2 == k ? 1. / (1. - 0.5 * sigma * sigma)
+                : 1. / (1. - 0.25 * sigma * sigma * w);
+            for (i = 0; i < n; ++i) {
+                temp = current[i] + gamma * (x[i] - current[i]);
+                if (1 < k)
+                    temp = previous[i] + w * (temp - previous[i]);
+                previous[i] = current[i];
+                x[i] = temp;
+            }
+        }
+        for (i = 0, norm = delta = 0.; i < n; ++i) {
+            temp = x[i] - current[i];
+            delta += temp * temp;
+            if (norm < fabs(temp))
+                norm = fabs(temp);
+        }
+        /* the sum keeps a Not a Number which the maximum drops */
+        if (delta != delta) {
+            status = MY_MATH_FUNCTION_NAN;
+            goto result;
+        }
+        delta = sqrt(delta);
+        ratio = 0. < delta_old ? delta / delta_old : 0.;
+        if (0 == k) {
+            /* plain sweeps until the ratio of the changes settles */
+            if (*sweeps >= 3 && 1. > ratio
+                    && fabs(ratio - ratio_old) < 0.1 * (1. - ratio)) {
+                rho = ratio;
+                gamma = 2. / (2. - rho);
+                sigma = rho / (2. - rho);
+                k = 1;
+                ratio = 0.;
+            }
+        } else if (++k > SOR_CHECK_SWEEPS && 0. < sigma && 1. > ratio
+                && fabs(ratio - ratio_old) < 0.1 * (1. - ratio)
+                && ratio > 1.1 * sigma / (1. + sqrt(1. - sigma * sigma))) {
+            c = ratio * (1. + sqrt(1. - sigma * sigma)) / sigma;
+            temp = sigma * 0.5 * (c + 1. / c);
+            /* the eigenvalue of SSOR at the edge of the new interval */
+            rho = (temp - 1. + gamma) / gamma;
+            rho = rho < 1. - 1.e-12 ? rho : 1. - 1.e-12;
+            gamma = 2. / (2. - rho);
+            sigma = rho / (2. - rho);
+            k = 1;
+            ratio = 0.;
+        }
+        delta_old = delta;
+        ratio_old = ratio;
+    } while (norm > epsilon && *sweeps < upper_sweeps);
+    if (norm > epsilon)
+        status = MY_MATH_NOT_UPDATE;
+
+result:
+    return status;
+}
+
+/*
+ * Libraries of Sparse Matrix
+ *  - allocate_sparse_matrix
+ *  - release_sparse_matrix
+ *  - sparse_matrix_vector
+ *  - sparse_sor_forward_sweep
+ *  - sparse_sor_backward_sweep
+ *  - sparse_gauss_seidel
+ *  - sparse_successive_over_relaxation
+ *  - sparse_symmetric_successive_over_relaxation
+ */
+int
+allocate_sparse_matrix(
+    SparseMatrix *a,
+    int n_rows,
+    int n_cols,
+    int nnz
+) {
+    a->n_rows = n_rows;
+    a->n_cols = n_cols;
+    a->nnz = nnz;
+    a->row_start = (int *)malloc(sizeof(int) * (n_rows + 1));
+    a->column = (int *)malloc(sizeof(int) * (nnz > 0 ? nnz : 1));
+    a->value = (double *)malloc(sizeof(double) * (nnz > 0 ? nnz : 1));
+    if (NULL == a->row_start || NULL == a->column || NULL == a->value) {
+        release_sparse_matrix(a);
+        return MY_MATH_OUT_OF_MEMORY;
+    }
+    a->row_start[0] = 0;
+    return MY_MATH_SATISFIED;
+}
+
+void
+release_sparse_matrix(
+    SparseMatrix *a
+) {
+    free(a->row_start);
+    free(a->column);
+    free(a->value);
+    a->row_start = NULL;
+    a->column = NULL;
+    a->value = NULL;
+}
+
+void
+sparse_matrix_vector(
+    double *y,
+    const SparseMatrix *a,
+    const double *x
+) {
+    int i, k;
+    double temp;
+
+#pragma omp parallel for private(k, temp) schedule(static)
+    for (i = 0; i < a->n_rows; ++i) {
+        for (k = a->row_start[i], temp = 0.; k < a->row_start[i + 1]; ++k)
+            temp += a->value[k] * x[a->column[k]];
+        y[i] = temp;
+    }
+}
+
+/*
+ * x_i = x_i + omega ((b_i - sum of a_ij x_j over j != i) / a_ii - x_i)
+ * returns |x_new - x_old|, or -1 when a_ii is zero or missing
+ */
+static double
+sparse_sor_row(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double omega,
+    int i
+) {
+    int k;
+    double temp = b[i], diagonal = 0., x_old = x[i];
+
+    for (k = a->row_start[i]; k < a->row_start[i + 1]; ++k) {
+        if (a->column[k] == i)
+            diagonal = a->value[k];
+        else
+            temp -= a->value[k] * x[a->column[k]];
+    }
+    if (0. == diagonal)
+        return -1.;
+    x[i] = x_old + omega * (temp / diagonal - x_old);
+    return fabs(x[i] - x_old);
+}
+
+int
+sparse_sor_forward_sweep(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double omega,
+    double *change
+) {
+    int i;
+    double temp;
+
+    for (i = 0, *change = 0.; i < a->n_rows; ++i) {
+        if (0. > (temp = sparse_sor_row(a, x, b, omega, i)))
+            return MY_MATH_FAILED;
+        if (temp != temp) {
+            *change = temp;
+            return MY_MATH_FUNCTION_NAN;
+        }
+        if (*change < temp)
+            *change = temp;
+    }
+    return MY_MATH_SATISFIED;
+}
+
+int
+sparse_sor_backward_sweep(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double omega,
+    double *change
+) {
+    int i;
+    double temp;
+
+    for (i = a->n_rows - 1, *change = 0.; i >= 0; --i) {
+        if (0. > (temp = sparse_sor_row(a, x, b, omega, i)))
+            return MY_MATH_FAILED;
+        if (temp != temp) {
+            *change = temp;
+            return MY_MATH_FUNCTION_NAN;
+        }
+        if (*change < temp)
+            *change = temp;
+    }
+    return MY_MATH_SATISFIED;
+}
+
+int
+sparse_gauss_seidel(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double epsilon,
+    int *sweeps
+) {
+    return sparse_successive_over_relaxation(a, x, b, epsilon, 1., sweeps);
+}
+
+int
+sparse_successive_over_relaxation(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double epsilon,
+    double omega,
+    int *sweeps
+) {
+    int status;
+    double change;
+
+    *sweeps = 0;
+    do {
+        ++*sweeps;
+        status = sparse_sor_forward_sweep(a, x, b, omega, &change);
+        if (MY_MATH_SATISFIED != status)
+            return status;
+    } while (change > epsilon);
+    return MY_MATH_SATISFIED;
+}
+
+int
+sparse_symmetric_successive_over_relaxation(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double epsilon,
+    double omega,
+    int *sweeps
+) {
+    int status;
+    double change, change_backward;
+
+    *sweeps = 0;
+    do {
+        ++*sweeps;
+        status = sparse_sor_forward_sweep(a, x, b, omega, &change);
+        if (MY_MATH_SATISFIED != status)
+            return status;
+        status = sparse_sor_backward_sweep(a, x, b, omega, &change_backward);
+        if (MY_MATH_SATISFIED != status)
+            return status;
+        if (change < change_backward)
+            change = change_backward;
+    } while (change > epsilon);
+    return MY_MATH_SATISFIED;
+}
+
+/*
+ * Libraries of Parallel Relaxation
+ *  - sparse_multicolor_ordering
+ *  - release_multicolor_ordering
+ *  - sparse_multicolor_successive_over_relaxation
+ *  - multicolor_successive_over_relaxation
+ *  - weighted_jacobi
+ *  - sparse_weighted_jacobi
+ */
+int
+sparse_multicolor_ordering(
+    MulticolorOrdering *ordering,
+    const SparseMatrix *a
+) {
+    int i, j, k, c, n = a->n_rows, *col_start, *transpose, *forbidden,
+        *color;
+
+    ordering->color_start = NULL;
+    ordering->row = (int *)malloc(sizeof(int) * (n > 0 ? n : 1));
+    col_start = (int *)malloc(sizeof(int)
+            * (3 * n + 2 + (a->nnz > 0 ? a->nnz : 1)));
+    if (NULL == ordering->row || NULL == col_start) {
+        free(col_start);
+        release_multicolor_ordering(ordering);
+        return MY_MATH_OUT_OF_MEMORY;
+    }
+    forbidden = col_start + n + 1;
+    color = forbidden + n + 1;
+    transpose = color + n;
+
+    /* the rows of every column, for the graph of A + A^T */
+    memset(col_start, 0, sizeof(int) * (n + 1));
+    for (k = 0; k < a->nnz; ++k)
+        col_start[a->column[k] + 1]++;
+    for (j = 0; j < n; ++j)
+        col_start[j + 1] += col_start[j];
+    for (i = 0; i < n; ++i) {
+        for (k = a->row_start[i]; k < a->row_start[i + 1]; ++k)
+            transpose[col_start[a->column[k]]++] = i;
+    }
+    for (j = n; j > 0; --j)
+        col_start[j] = col_start[j - 1];
+    col_start[0] = 0;
+
+    ordering->num_colors = 0;
+    for (i = 0; i <= n; ++i)
+        forbidden[i] = -1;
+    for (i = 0; i < n; ++i) {
+        for (k = a->row_start[i]; k < a->row_start[i + 1]; ++k) {
+            if (a->column[k] < i)
+                forbidden[color[a->column[k]]] = i;
+        }
+        for (k = col_start[i]; k < col_start[i + 1]; ++k) {
+            if (transpose[k] < i)
+                forbidden[color[transpose[k]]] = i;
+        }
+        for (c = 0; forbidden[c] == i; ++c)
+            ;
+        color[i] = c;
+        if (c >= ordering->num_colors)
+            ordering->num_colors = c + 1;
+    }
+
+    /* the rows sorted by color (counting sort, stable) */
+    ordering->color_start = (int *)malloc(sizeof(int)
+            * (ordering->num_colors + 1));
+    if (NULL == ordering->color_start) {
+        free(col_start);
+        release_multicolor_ordering(ordering);
+        return MY_MATH_OUT_OF_MEMORY;
+    }
+    memset(ordering->color_start, 0,
+            sizeof(int) * (ordering->num_colors + 1));
+    for (i = 0; i < n; ++i)
+        ordering->color_start[color[i] + 1]++;
+    for (c = 0; c < ordering->num_colors; ++c)
+        ordering->color_start[c + 1] += ordering->color_start[c];
+    for (i = 0; i < n; ++i)
+        ordering->row[ordering->color_start[color[i]]++] = i;
+    for (c = ordering->num_colors; c > 0; --c)
+        ordering->color_start[c] = ordering->color_start[c - 1];
+    ordering->color_start[0] = 0;
+    free(col_start);
+    return MY_MATH_SATISFIED;
+}
+
+void
+release_multicolor_ordering(
+    MulticolorOrdering *ordering
+) {
+    free(ordering->color_start);
+    free(ordering->row);
+    ordering->color_start = NULL;
+    ordering->row = NULL;
+    ordering->num_colors = 0;
+}
+
+int
+sparse_multicolor_successive_over_relaxation(
+    const SparseMatrix *a,
+    const MulticolorOrdering *ordering,
+    double *x,
+    const double *b,
+    double epsilon,
+    double omega,
+    int *sweeps
+) {
+    int c, k, failed, not_a_number;
+    double change, temp;
+
+    *sweeps = 0;
+    do {
+        ++*sweeps;
+        change = 0.;
+        failed = not_a_number = 0;
+        for (c = 0; c < ordering->num_colors; ++c) {
+#pragma omp parallel for private(temp) reduction(max:change) \
+    reduction(+:failed, not_a_number) schedule(static)
+            for (k = ordering->color_start[c];
+                    k < ordering->color_start[c + 1]; ++k) {
+                temp = sparse_sor_row(a, x, b, omega, ordering->row[k]);
+                if (0. > temp)
+                    failed++;
+                else if (temp != temp)
+                    not_a_number++;
+                else if (change < temp)
+                    change = temp;
+            }
+        }
+        if (failed)
+            return MY_MATH_FAILED;
+        if (not_a_number)
+            return MY_MATH_FUNCTION_NAN;
+    } while (change > epsilon);
+    return MY_MATH_SATISFIED;
+}
+
+int
+multicolor_successive_over_relaxation(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    int block,
+    double epsilon,
+    double omega,
+    int *sweeps
+) {
+    int c, i, j, lo, hi, num_blocks, blk, failed, not_a_number;
+    double change, temp, x_old, *snapshot;
+
+    block = block > 0 ? block : 1;
+    num_blocks = (n + block - 1) / block;
+    if (NULL == (snapshot = (double *)malloc(sizeof(double)
+                    * (n > 0 ? n : 1))))
+        return MY_MATH_OUT_OF_MEMORY;
+    *sweeps = 0;
+    do {
+        ++*sweeps;
+        change = 0.;
+        failed = not_a_number = 0;
+        for (c = 0; c < 2; ++c) {
+            memcpy(snapshot, x, sizeof(double) * n);
+#pragma omp parallel for private(i, j, lo, hi, temp, x_old) \
+    reduction(max:change) reduction(+:failed, not_a_number) \
+    schedule(dynamic, 1)
+            for (blk = c; blk < num_blocks; blk += 2) {
+                lo = blk * block;
+                hi = lo + block < n ? lo + block : n;
+                for (i = lo; i < hi; ++i) {
+                    temp = b[i];
+                    for (j = 0; j < lo; ++j)
+                        temp -= a[i][j] * snapshot[j];
+                    for (j = lo; j < hi; ++j) {
+                        if (j != i)
+                            temp -= a[i][j] * x[j];
+                    }
+                    for (j = hi; j < n; ++j)
+                        temp -= a[i][j] * snapshot[j];
+                    if (0. == a[i][i]) {
+                        failed++;
+                        break;
+                    }
+                    x_old = x[i];
+                    x[i] = x_old + omega * (temp / a[i][i] - x_old);
+                    temp = fabs(x[i] - x_old);
+                    if (temp != temp)
+                        not_a_number++;
+                    else if (change < temp)
+                        change = temp;
+                }
+            }
+        }
+        if (failed || not_a_number) {
+            free(snapshot);
+            return failed ? MY_MATH_FAILED : MY_MATH_FUNCTION_NAN;
+        }
+    } while (change > epsilon);
+    free(snapshot);
+    return MY_MATH_SATISFIED;
+}
+
+int
+weighted_jacobi(
+    double **a,
+    double *x,
+    const double *b,
+    int n,
+    double epsilon,
+    double omega,
+    int *sweeps
+) {
+    int i, j, failed, not_a_number;
+    double change, temp, *x_new;
+
+    if (NULL == (x_new = (double *)malloc(sizeof(double) * (n > 0 ? n : 1))))
+        return MY_MATH_OUT_OF_MEMORY;
+    *sweeps = 0;
+    do {
+        ++*sweeps;
+        change = 0.;
+        failed = not_a_number = 0;
+#pragma omp parallel for private(j, temp) reduction(max:change) \
+    reduction(+:failed, not_a_number) schedule(static)
+        for (i = 0; i < n; ++i) {
+            for (j = 0, temp = b[i]; j < n; ++j)
                 temp -= a[i][j] * x[j];
-            if (0. != a[i][i])
-                x[i] = x_old + omega * (temp / a[i][i] - x_old);
-            else
-                return MY_MATH_FAILED;
-            temp = fabs(x[i] - x_old);
-            if(norm < temp)
-                norm = temp;
+            if (0. == a[i][i]) {
+                failed++;
+                continue;
+            }
+            x_new[i] = x[i] + omega * temp / a[i][i];
+            temp = fabs(x_new[i] - x[i]);
+            if (temp != temp)
+                not_a_number++;
+            else if (change < temp)
+                change = temp;
         }
-    } while(norm > epsilon);
+        if (failed || not_a_number) {
+            free(x_new);
+            return failed ? MY_MATH_FAILED : MY_MATH_FUNCTION_NAN;
+        }
+        memcpy(x, x_new, sizeof(double) * n);
+    } while (change > epsilon);
+    free(x_new);
+    return MY_MATH_SATISFIED;
+}
+
+int
+sparse_weighted_jacobi(
+    const SparseMatrix *a,
+    double *x,
+    const double *b,
+    double epsilon,
+    double omega,
+    int *sweeps
+) {
+    int i, k, n = a->n_rows, failed, not_a_number;
+    double change, temp, diagonal, *x_new;
+
+    if (NULL == (x_new = (double *)malloc(sizeof(double) * (n > 0 ? n : 1))))
+        return MY_MATH_OUT_OF_MEMORY;
+    *sweeps = 0;
+    do {
+        ++*sweeps;
+        change = 0.;
+        failed = not_a_number = 0;
+#pragma omp parallel for private(k, temp, diagonal) reduction(max:change) \
+    reduction(+:failed, not_a_number) schedule(static)
+        for (i = 0; i < n; ++i) {
+            temp = b[i];
+            diagonal = 0.;
+            for (k = a->row_start[i]; k < a->row_start[i + 1]; ++k) {
+                temp -= a->value[k] * x[a->column[k]];
+                if (a->column[k] == i)
+                    diagonal = a->value[k];
+            }
+            if (0. == diagonal) {
+                failed++;
+                continue;
+            }
+            x_new[i] = x[i] + omega * temp / diagonal;
+            temp = fabs(x_new[i] - x[i]);
+            if (temp != temp)
+                not_a_number++;
+            else if (change < temp)
+                change = temp;
+        }
+        if (failed || not_a_number) {
+            free(x_new);
+            return failed ? MY_MATH_FAILED : MY_MATH_FUNCTION_NAN;
+        }
+        memcpy(x, x_new, sizeof(double) * n);
+    } while (change > epsilon);
+    free(x_new);
     return MY_MATH_SATISFIED;
 }
 
+/*
+ * Libraries of Conjugate Gradient
+ *  - initialize_preconditioner
+ *  - initialize_packed_preconditioner
+ *  - initialize_sparse_preconditioner
+ *  - release_preconditioner
+ *  - apply_preconditioner
+ *  - linear_operator_conjugate_gradient
+ *  - preconditioned_conjugate_gradient
+ *  - packed_preconditioned_conjugate_gradient
+ *  - sparse_preconditioned_conjugate_gradient
+ */
+#define PACKED_INDEX(i, j) ((size_t)(i) * ((i) + 1) / 2 + (j))
+
+/*
+ * IC(0) of the lower triangle l of A in place; the rows of l are merged
+ * with the earlier rows over the columns they share.
+ * returns MY_MATH_FAILED when a pivot is not positive
+ */
+static int
+incomplete_cholesky(
+    SparseMatrix *l
+) {
+    int i, j, k, m, p, end_i, end_j;
+    double temp;
+
+    for (i = 0; i < l->n_rows; ++i) {
+        end_i = l->row_start[i + 1] - 1;
+        for (k = l->row_start[i]; k < end_i; ++k) {
+            j = l->column[k];
+            end_j = l->row_start[j + 1] - 1;
+            temp = l->value[k];
+            for (m = l->row_start[i], p = l->row_start[j];
+                    m < k && p < end_j; ) {
+                if (l->column[m] == l->column[p])
+                    temp -= l->value[m++] * l->value[p++];
+                else if (l->column[m] < l->column[p])
+                    ++m;
+                else
+                    ++p;
+            }
+            l->value[k] = temp / l->value[end_j];
+        }
+        for (k = l->row_start[i], temp = l->value[end_i]; k < end_i; ++k)
+            temp -= l->value[k] * l->value[k];
+        if (!(0. < temp))
+            return MY_MATH_FAILED;
+        l->value[end_i] = sqrt(temp);
+    }
+    return MY_MATH_SATISFIED;
+}
+
+/*
+ * completes a preconditioner whose factor holds the lower triangle of A
+ */
+static int
+factorize_preconditioner(
+    Preconditioner *preconditioner
+) {
+    int i, k, status;
+    double shift, *value;
+    SparseMatrix *l = &preconditioner->factor;
+
+    for (i = 0; i < l->n_rows; ++i) {
+        k = l->row_start[i + 1] - 1;
+        if (k < l->row_start[i] || l->column[k] != i || !(0. < l->value[k]))
+            return MY_MATH_FAILED;
+        preconditioner->diagonal[i] = l->value[k];
+    }
+    if (PRECONDITIONER_JACOBI == preconditioner->type) {
+        release_sparse_matrix(l);
+        return MY_MATH_SATISFIED;
+    }
+    if (PRECONDITIONER_INCOMPLETE_CHOLESKY != preconditioner->type)
+        return MY_MATH_SATISFIED;
+
+    /* a pivot breaks down: retry on A + shift diag(A) */
+    value = (double *)malloc(sizeof(double) * (l->nnz > 0 ? l->nnz : 1));
+    if (NULL == value)
+        return MY_MATH_OUT_OF_MEMORY;
+    memcpy(value, l->value, sizeof(double) * l->nnz);
+    for (shift = 1.e-3; ; shift *= 10.) {
+        if (MY_MATH_SATISFIED == (status = incomplete_cholesky(l))
+                || 1.e+3 < shift)
+            break;
+        memcpy(l->value, value, sizeof(double) * l->nnz);
+        for (i = 0; i < l->n_rows; ++i)
+            l->value[l->row_start[i + 1] - 1] *= 1. + shift;
+    }
+    free(value);
+    return status;
+}
+
+static int
+allocate_preconditioner(
+    Preconditioner *preconditioner,
+    int n,
+    int nnz,
+    int type,
+    double omega
+) {
+    preconditioner->type = type;
+    preconditioner->omega = omega;
+    preconditioner->diagonal = NULL;
+    preconditioner->factor.row_start = NULL;
+    preconditioner->factor.column = NULL;
+    preconditioner->factor.value = NULL;
+    if (PRECONDITIONER_NONE == type)
+        return MY_MATH_SATISFIED;
+    preconditioner->diagonal = (double *)malloc(sizeof(double)
+            * (n > 0 ? n : 1));
+    if (NULL == preconditioner->diagonal || MY_MATH_SATISFIED
+            != allocate_sparse_matrix(&preconditioner->factor, n, n, nnz)) {
+        release_preconditioner(preconditioner);
+        return MY_MATH_OUT_OF_MEMORY;
+    }
+    return MY_MATH_SATISFIED;
+}
+
+int
+initialize_preconditioner(
+    Preconditioner *preconditioner,
+    double **a,
+    int n,
+    int type,
+    double omega
+) {
+    int i, j, nnz, status;
+    SparseMatrix *l = &preconditioner->factor;
+
+    for (i = 0, nnz = 0; i < n; ++i) {
+        for (j = 0; j <= i; ++j)
+            nnz += (0. != a[i][j] || j == i);
+    }
+    status = allocate_preconditioner(preconditioner, n, nnz, type, omega);
+    if (MY_MATH_SATISFIED != status || PRECONDITIONER_NONE == type)
+        return status;
+    for (i = 0, nnz = 0; i < n; ++i) {
+        for (j = 0; j <= i; ++j) {
+            if (0. != a[i][j] || j == i) {
+                l->column[nnz] = j;
+                l->value[nnz++] = a[i][j];
+            }
+        }
+        l->row_start[i + 1] = nnz;
+    }
+    status = factorize_preconditioner(preconditioner);
+    if (MY_MATH_SATISFIED != status)
+        release_preconditioner(preconditioner);
+    return status;
+}
+
+int
+initialize_packed_preconditioner(
+    Preconditioner *preconditioner,
+    const double *a,
+    int n,
+    int type,
+    double omega
+) {
+    int i, j, nnz, status;
+    SparseMatrix *l = &preconditioner->factor;
+
+    for (i = 0, nnz = 0; i < n; ++i) {
+        for (j = 0; j <= i; ++j)
+            nnz += (0. != a[PACKED_INDEX(i, j)] || j == i);
+    }
+    status = allocate_preconditioner(preconditioner, n, nnz, type, omega);
+    if (MY_MATH_SATISFIED != status || PRECONDITIONER_NONE == type)
+        return status;
+    for (i = 0, nnz = 0; i < n; ++i) {
+        for (j = 0; j <= i; ++j) {
+            if (0. != a[PACKED_INDEX(i, j)] || j == i) {
+                l->column[nnz] = j;
+                l->value[nnz++] = a[PACKED_INDEX(i, j)];
+            }
+        }
+        l->row_start[i + 1] = nnz;
+    }
+    status = factorize_preconditioner(preconditioner);
+    if (MY_MATH_SATISFIED != status)
+        release_preconditioner(preconditioner);
+    return status;
+}
+
+int
+initialize_sparse_preconditioner(
+    Preconditioner *preconditioner,
+    const SparseMatrix *a,
+    int type,
+    double omega
+) {
+    int i, k, nnz, status, n = a->n_rows;
+    SparseMatrix *l = &preconditioner->factor;
+
+    for (i = 0, nnz = 0; i < n; ++i) {
+        for (k = a->row_start[i]; k < a->row_start[i + 1]; ++k)
+            nnz += (a->column[k] <= i);
+    }
+    status = allocate_preconditioner(preconditioner, n, nnz, type, omega);
+    if (MY_MATH_SATISFIED != status || PRECONDITIONER_NONE == type)
+        return status;
+    for (i = 0, nnz = 0; i < n; ++i) {
+        for (k = a->row_start[i]; k < a->row_start[i + 1]; ++k) {
+            if (a->column[k] <= i) {
+                l->column[nnz] = a->column[k];
+                l->value[nnz++] = a->value[k];
+            }
+        }
+        l->row_start[i + 1] = nnz;
+    }
+    status = factorize_preconditioner(preconditioner);
+    if (MY_MATH_SATISFIED != status)
+        release_preconditioner(preconditioner);
+    return status;
+}
+
+void
+release_preconditioner(
+    Preconditioner *preconditioner
+) {
+    free(preconditioner->diagonal);
+    preconditioner->diagonal = NULL;
+    release_sparse_matrix(&preconditioner->factor);
+}
+
+void
+apply_preconditioner(
+    double *z,
+    const Preconditioner *preconditioner,
+    const double *r,
+    int n
+) {
+    int i, k, end;
+    double temp, omega;
+    const SparseMatrix *l;
+
+    if (NULL == preconditioner || PRECONDITIONER_NONE == preconditioner->type) {
+        memcpy(z, r, sizeof(double) * n);
+        return;
+    }
+    if (PRECONDITIONER_JACOBI == preconditioner->type) {
+#pragma omp parallel for schedule(static)
+        for (i = 0; i < n; ++i)
+            z[i] = r[i] / preconditioner->diagonal[i];
+        return;
+    }
+
+    /*
+     * SSOR: M = (D + omega L) D^-1 (D + omega L^T)
+     * IC(0): M = L L^T (omega = 1, the diagonal of the factor)
+     */
+    l = &preconditioner->factor;
+    omega = PRECONDITIONER_SSOR == preconditioner->type
+        ? preconditioner->omega : 1.;
+    for (i = 0; i < n; ++i) {
+        end = l->row_start[i + 1] - 1;
+        for (k = l->row_start[i], temp = 0.; k < end; ++k)
+            temp += l->value[k] * z[l->column[k]];
+        z[i] = (r[i] - omega * temp) / l->value[end];
+    }
+    if (PRECONDITIONER_SSOR == preconditioner->type) {
+        for (i = 0; i < n; ++i)
+            z[i] *= preconditioner->diagonal[i];
+    }
+    for (i = n - 1; i >= 0; --i) {
+        end = l->row_start[i + 1] - 1;
+        z[i] /= l->value[end];
+        for (k = l->row_start[i]; k < end; ++k)
+            z[l->column[k]] -= omega * l->value[k] * z[i];
+    }
+}
+
+int
+linear_operator_conjugate_gradient(
+    void (*matrix_vector)(double *, const double *, int, void *),
+    void *user,
+    const Preconditioner *preconditioner,
+    double *x,
+    const double *b,
+    int n,
+    double tolerance,
+    int upper_iter,
+    int *iterations
+) {
+    int i, status;
+    double b_norm, r_norm, rz, rz_old, pq, alpha, beta;
+    double *r, *z, *p, *q;
+
+    *iterations = 0;
+    if (NULL == (r = (double *)malloc(sizeof(double) * 4 * (n > 0 ? n : 1))))
+        return MY_MATH_OUT_OF_MEMORY;
+    z = r + n;
+    p = z + n;
+    q = p + n;
+
+    matrix_vector(q, x, n, user);
+    b_norm = r_norm = 0.;
+#pragma omp parallel for reduction(+:b_norm, r_norm) schedule(static)
+    for (i = 0; i < n; ++i) {
+        r[i] = b[i] - q[i];
+        b_norm += b[i] * b[i];
+        r_norm += r[i] * r[i];
+    }
+    b_norm = sqrt(b_norm);
+    apply_preconditioner(z, preconditioner, r, n);
+    rz = 0.;
+#pragma omp parallel for reduction(+:rz) schedule(static)
+    for (i = 0; i < n; ++i) {
+        p[i] = z[i];
+        rz += r[i] * z[i];
+    }
+
+    status = MY_MATH_NOT_UPDATE;
+    while (sqrt(r_norm) > tolerance * b_norm) {
+        if (*iterations >= upper_iter)
+            goto result;
+        ++*iterations;
+        matrix_vector(q, p, n, user);
+        pq = 0.;
+#pragma omp parallel for reduction(+:pq) schedule(static)
+        for (i = 0; i < n; ++i)
+            pq += p[i] * q[i];
+        if (!(0. < pq)) {
+            status = pq != pq ? MY_MATH_FUNCTION_NAN : MY_MATH_FAILED;
+            goto result;
+        }
+        alpha = rz / pq;
+        r_norm = 0.;
+#pragma omp parallel for reduction(+:r_norm) schedule(static)
+        for (i = 0; i < n; ++i) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+            r_norm += r[i] * r[i];
+        }
+        apply_preconditioner(z, preconditioner, r, n);
+        rz_old = rz;
+        rz = 0.;
+#pragma omp parallel for reduction(+:rz) schedule(static)
+        for (i = 0; i < n; ++i)
+            rz += r[i] * z[i];
+        beta = rz / rz_old;
+#pragma omp parallel for schedule(static)
+        for (i = 0; i < n; ++i)
+            p[i] = z[i] + beta * p[i];
+    }
+    status = MY_MATH_SATISFIED;
+
+result:
+    free(r);
+    return status;
+}
+
+static void
+dense_matrix_vector(
+    double *y,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i, j;
+    double temp, **a = (double **)user;
+
+#pragma omp parallel for private(j, temp) schedule(static)
+    for (i = 0; i < n; ++i) {
+        for (j = 0, temp = 0.; j < n; ++j)
+            temp += a[i][j] * x[j];
+        y[i] = temp;
+    }
+}
+
+static void
+packed_matrix_vector(
+    double *y,
+    const double *x,
+    int n,
+    void *user
+) {
+    int i, j;
+    double temp;
+    const double *a = (const double *)user;
+
+#pragma omp parallel for private(j, temp) schedule(dynamic, 64)
+    for (i = 0; i < n; ++i) {
+        for (j = 0, temp = 0.; j <= i; ++j)
+            temp += a[PACKED_INDEX(i, j)] * x[j];
+        for (j = i + 1; j < n; ++j)
+            temp += a[PACKED_INDEX(j, i)] * x[j];
+        y[i] = temp;
+    }
+}
+
+static void
+csr_matrix_vector(
+    double *y,
+    const double *x,
+    int n,
+    void *user
+) {
+    sparse_matrix_vector(y, (const SparseMatrix *)user, x);
+}
+
+int
+preconditioned_conjugate_gradient(
+    double **a,
+    const Preconditioner *preconditioner,
+    double *x,
+    const double *b,
+    int n,
+    double tolerance,
+    int upper_iter,
+    int *iterations
+) {
+    return linear_operator_conjugate_gradient(dense_matrix_vector,
+            (void *)a, preconditioner, x, b, n, tolerance, upper_iter,
+            iterations);
+}
+
+int
+packed_preconditioned_conjugate_gradient(
+    const double *a,
+    const Preconditioner *preconditioner,
+    double *x,
+    const double *b,
+    int n,
+    double tolerance,
+    int upper_iter,
+    int *iterations
+) {
+    return linear_operator_conjugate_gradient(packed_matrix_vector,
+            (void *)a, preconditioner, x, b, n, tolerance, upper_iter,
+            iterations);
+}
+
+int
+sparse_preconditioned_conjugate_gradient(
+    const SparseMatrix *a,
+    const Preconditioner *preconditioner,
+    double *x,
+    const double *b,
+    double tolerance,
+    int upper_iter,
+    int *iterations
+) {
+    return linear_operator_conjugate_gradient(csr_matrix_vector,
+            (void *)a, preconditioner, x, b, a->n_rows, tolerance,
+            upper_iter, iterations);
+}
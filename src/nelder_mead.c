@@ -0,0 +1,309 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        nelder_mead.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/nelder_mead.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/mymath.h"
+
+static const char method_name[] = "Nelder-Mead";
+
+enum NelderMeadCandidate {
+    NELDER_MEAD_REFLECTION = 0,
+    NELDER_MEAD_EXPANSION,
+    NELDER_MEAD_OUTSIDE_CONTRACTION,
+    NELDER_MEAD_INSIDE_CONTRACTION,
+    NELDER_MEAD_CANDIDATES,
+};
+
+static void
+default_nelder_mead_parameter(
+    NelderMeadParameter *parameter
+);
+
+static void
+evaluate_vertices(
+    double *f,
+    const double *vertex,
+    int num,
+    int skip,
+    int n,
+    FunctionObject *function_object
+);
+
+static void
+sort_vertices(
+    int *order,
+    const double *f,
+    int n
+);
+
+int
+nelder_mead(
+    double *x,
+    int n,
+    FunctionObject *function_object,
+    NelderMeadParameter *nelder_mead_parameter
+) {
+    int i, j, iter, status, best, worst, accept;
+    long int memory_size;
+    double alpha, beta, gamma, delta, spread, temp,
+           *storage, *simplex, *f, *candidate, *f_candidate, *centroid, *sum;
+    int *order;
+    NonLinearComponent component;
+    NelderMeadParameter _nelder_mead_parameter;
+    EvaluateObject evaluate_object;
+
+    memory_size = sizeof(double) * n;
+    storage = NULL;
+    order = NULL;
+    iter = 0;
+    initialize_non_linear_component(
+            method_name, function_object, &evaluate_object, &component);
+
+    /* make sure that f of this problem exists: gf is not required */
+    if (NULL == function_object->function) {
+        status = NON_LINEAR_NO_FUNCTION;
+        goto result;
+    }
+
+    /* set the parameter of Nelder-Mead method */
+    if (NULL == nelder_mead_parameter) {
+        nelder_mead_parameter = &_nelder_mead_parameter;
+        memset(nelder_mead_parameter, 0, sizeof(NelderMeadParameter));
+    }
+    default_nelder_mead_parameter(nelder_mead_parameter);
+    if ('a' == nelder_mead_parameter->coefficient) {
+        alpha = 1.;
+        beta = 1. + 2. / n;
+        gamma = .75 - .5 / n;
+        delta = 1. - 1. / n;
+    } else {
+        alpha = 1.;
+        beta = 2.;
+        gamma = .5;
+        delta = .5;
+    }
+
+    /*
+     * allocate memory to storage
+     *  simplex:    (n + 1) vertices, vertex-major, one vertex per n doubles
+     *  candidate:  reflection, expansion and contractions
+     */
+    if (NULL == (storage = (double *)malloc(sizeof(double)
+                    * ((n + 1) * n + (n + 1) + NELDER_MEAD_CANDIDATES * n
+                        + NELDER_MEAD_CANDIDATES + 2 * n)))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    if (NULL == (order = (int *)malloc(sizeof(int) * (n + 1)))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    simplex = storage;
+    f = simplex + (n + 1) * n;
+    candidate = f + n + 1;
+    f_candidate = candidate + NELDER_MEAD_CANDIDATES * n;
+    centroid = f_candidate + NELDER_MEAD_CANDIDATES;
+    sum = centroid + n;
+
+    /* initial simplex: x and x + step * e_i */
+    for (i = 0; i <= n; ++i) {
+        memcpy(simplex + i * n, x, memory_size);
+        if (i > 0)
+            simplex[i * n + i - 1] += nelder_mead_parameter->initial_step;
+        order[i] = i;
+    }
+    evaluate_vertices(f, simplex, n + 1, -1, n, function_object);
+    component.iteration_f += n + 1;
+    sort_vertices(order, f, n);
+    for (j = 0; j < n; ++j) {
+        for (i = 0, sum[j] = 0.; i <= n; ++i) {
+            sum[j] += simplex[i * n + j];
+        }
+    }
+
+    /*
+     * start to compute for solving this problem
+     */
+    for (iter = 1; iter <= nelder_mead_parameter->upper_iter; ++iter) {
+        best = order[0];
+        worst = order[n];
+        /* centroid of all vertices but the worst */
+        for (j = 0; j < n; ++j) {
+            centroid[j] = (sum[j] - simplex[worst * n + j]) / n;
+        }
+        /* all candidates lie on the line from the worst to the centroid,
+         * and they are evaluated at once */
+        for (j = 0; j < n; ++j) {
+            temp = centroid[j] - simplex[worst * n + j];
+            candidate[NELDER_MEAD_REFLECTION * n + j] =
+                centroid[j] + alpha * temp;
+            candidate[NELDER_MEAD_EXPANSION * n + j] =
+                centroid[j] + alpha * beta * temp;
+            candidate[NELDER_MEAD_OUTSIDE_CONTRACTION * n + j] =
+                centroid[j] + alpha * gamma * temp;
+            candidate[NELDER_MEAD_INSIDE_CONTRACTION * n + j] =
+                centroid[j] - gamma * temp;
+        }
+        evaluate_vertices(f_candidate, candidate, NELDER_MEAD_CANDIDATES, -1,
+                n, function_object);
+        component.iteration_f += NELDER_MEAD_CANDIDATES;
+
+        accept = -1;
+        if (f_candidate[NELDER_MEAD_REFLECTION] < f[best]) {
+            accept = f_candidate[NELDER_MEAD_EXPANSION]
+                < f_candidate[NELDER_MEAD_REFLECTION]
+                ? NELDER_MEAD_EXPANSION : NELDER_MEAD_REFLECTION;
+        } else if (f_candidate[NELDER_MEAD_REFLECTION] < f[order[n - 1]]) {
+            accept = NELDER_MEAD_REFLECTION;
+        } else if (f_candidate[NELDER_MEAD_REFLECTION] < f[worst]) {
+            if (f_candidate[NELDER_MEAD_OUTSIDE_CONTRACTION]
+                    <= f_candidate[NELDER_MEAD_REFLECTION])
+                accept = NELDER_MEAD_OUTSIDE_CONTRACTION;
+        } else {
+            if (f_candidate[NELDER_MEAD_INSIDE_CONTRACTION] < f[worst])
+                accept = NELDER_MEAD_INSIDE_CONTRACTION;
+        }
+
+        if (accept >= 0) {
+            /* replace the worst vertex */
+            for (j = 0; j < n; ++j) {
+                sum[j] += candidate[accept * n + j] - simplex[worst * n + j];
+            }
+            memcpy(simplex + worst * n, candidate + accept * n, memory_size);
+            f[worst] = f_candidate[accept];
+        } else {
+            /* shrink toward the best vertex */
+            for (i = 0; i <= n; ++i) {
+                if (i == best)
+                    continue;
+                for (j = 0; j < n; ++j) {
+                    simplex[i * n + j] = simplex[best * n + j] + delta
+                        * (simplex[i * n + j] - simplex[best * n + j]);
+                }
+            }
+            evaluate_vertices(f, simplex, n + 1, best, n, function_object);
+            component.iteration_f += n;
+            for (j = 0; j < n; ++j) {
+                for (i = 0, sum[j] = 0.; i <= n; ++i) {
+                    sum[j] += simplex[i * n + j];
+                }
+            }
+        }
+        sort_vertices(order, f, n);
+
+        /* spread of f and size of the simplex */
+        best = order[0];
+        spread = f[order[n]] - f[best];
+        for (i = 1; i <= n; ++i) {
+            for (j = 0; j < n; ++j) {
+                temp = fabs(simplex[order[i] * n + j] - simplex[best * n + j]);
+                if (temp > spread)
+                    spread = temp;
+            }
+        }
+        component.f = f[best];
+        component.alpha = spread;
+
+        if (observe_iteration(iter, spread, &component)) {
+            status = NON_LINEAR_STOPPED;
+            goto result;
+        }
+
+        if (spread < nelder_mead_parameter->tolerance) {
+            status = NON_LINEAR_SATISFIED;
+            goto result;
+        }
+    }
+    status = NON_LINEAR_NO_CONVERGENCE;
+result:
+    if (NULL != storage && NULL != order) {
+        memcpy(x, simplex + order[0] * n, memory_size);
+        if (HUGE_VAL == f[order[0]])
+            status = NON_LINEAR_FUNCTION_NAN;
+    }
+    observe_result(status, iter, &component);
+
+    /* release memory of storage and order */
+    if (NULL != storage) {
+        free(storage);
+        storage = NULL;
+    }
+    if (NULL != order) {
+        free(order);
+        order = NULL;
+    }
+
+    return status;
+}
+
+static void
+default_nelder_mead_parameter(
+    NelderMeadParameter *parameter
+) {
+    parameter->coefficient =
+        's' == parameter->coefficient || 'S' == parameter->coefficient
+        ? 's' : 'a';
+    parameter->initial_step =
+        parameter->initial_step > 0. ? parameter->initial_step : 1.;
+    parameter->tolerance =
+        parameter->tolerance > lower_eps ? parameter->tolerance : lower_eps;
+    parameter->upper_iter = parameter->upper_iter > lower_iteration
+        && parameter->upper_iter < upper_iteration
+        ? parameter->upper_iter : upper_iteration;
+}
+
+static void
+evaluate_vertices(
+    double *f,
+    const double *vertex,
+    int num,
+    int skip,
+    int n,
+    FunctionObject *function_object
+) {
+    /*
+     * The vertices are independent, so they are evaluated in parallel when
+     * function may be called from several threads at once.
+     * Not a Number is regarded as +infinity, which rejects the vertex.
+     */
+    int i;
+#pragma omp parallel for schedule(static) if (function_object->thread_safe)
+    for (i = 0; i < num; ++i) {
+        if (i == skip)
+            continue;
+        f[i] = function_object->function(
+                vertex + i * n, n, function_object->user);
+        if (f[i] != f[i])
+            f[i] = HUGE_VAL;
+    }
+}
+
+static void
+sort_vertices(
+    int *order,
+    const double *f,
+    int n
+) {
+    /* insertion sort: the order is almost kept between iterations */
+    int i, j, temp;
+    for (i = 1; i <= n; ++i) {
+        temp = order[i];
+        for (j = i - 1; j >= 0 && f[order[j]] > f[temp]; --j) {
+            order[j + 1] = order[j];
+        }
+        order[j + 1] = temp;
+    }
+}
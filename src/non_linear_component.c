@@ -4,14 +4,34 @@
  * File:        non_linear_component.c
  * Version:     0.1.0
  * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
- * Last Change: 09-Jul-2012.
+ * Last Change: 19-Oct-2026.
  */
 
 #include "include/non_linear_component.h"
+#include "include/finite_difference.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
 
 const double lower_eps = 1.e-8;
 const int lower_iteration = 1;
 const int upper_iteration = 1000;
+const double sr1_skipping_ratio = 1.e-8;
+
+static double
+monotonic_seconds(
+    void
+);
+
+static void
+set_solver_iteration(
+    SolverIteration *state,
+    int iteration,
+    double g_norm,
+    NonLinearComponent *component
+);
 
 static int
 function(
@@ -36,14 +56,29 @@ function_gradient(
     NonLinearComponent *component
 );
 
+void
+default_function_object(
+    FunctionObject *function_object
+) {
+    function_object->function = NULL;
+    function_object->gradient = NULL;
+    function_object->function_gradient = NULL;
+    function_object->batch_function = NULL;
+    function_object->user = NULL;
+    function_object->observer = NULL;
+    function_object->finite_difference = 'c';
+    function_object->thread_safe = 0;
+}
+
 void
 initialize_non_linear_component(
-    char *method_name,
+    const char *method_name,
     FunctionObject *function_object,
     EvaluateObject *evaluate_object,
     NonLinearComponent *component
 ) {
     component->method_name = method_name;
+    component->iteration = 1;
     component->iteration_f = 0;
     component->iteration_g = 0;
     component->f = 0.;
@@ -52,6 +87,216 @@ initialize_non_linear_component(
     evaluate_object->function = function;
     evaluate_object->gradient = gradient;
     evaluate_object->function_gradient = function_gradient;
+    attach_observer(
+            NULL != function_object ? function_object->observer : NULL,
+            component);
+}
+
+/*
+ * for the solvers whose problem is not a FunctionObject
+ */
+void
+attach_observer(
+    SolverObserver *observer,
+    NonLinearComponent *component
+) {
+    component->observer = observer;
+    component->telemetry = NULL != observer ? observer->telemetry : NULL;
+    component->statistics = NULL != observer ? observer->statistics : NULL;
+    component->perf_counters = NULL;
+    component->trials = 0;
+    if (NULL != component->statistics) {
+        memset(component->statistics, 0, sizeof(SolverStatistics));
+        if (NULL != observer->perf_counters
+                && observer->perf_counters->leader >= 0) {
+            component->perf_counters = observer->perf_counters;
+            component->statistics->counters = observer->perf_counters->mask;
+        }
+        component->started = monotonic_seconds();
+    }
+    observe_event(TELEMETRY_SOLVE_BEGIN, 0., 0., component);
+    observe_event(TELEMETRY_ITERATION_BEGIN, 0., 0., component);
+}
+
+int
+observe_iteration(
+    int iteration,
+    double g_norm,
+    NonLinearComponent *component
+) {
+    SolverObserver *observer = component->observer;
+    SolverIteration state;
+
+    observe_event(TELEMETRY_ITERATION_END, component->f, g_norm, component);
+    if (NULL != component->statistics) {
+        component->statistics->trials[component->trials < SOLVER_TRIAL_BINS
+            ? component->trials : SOLVER_TRIAL_BINS - 1]++;
+        component->statistics->iterations = iteration;
+    }
+    component->trials = 0;
+    component->iteration = iteration + 1;
+    observe_event(TELEMETRY_ITERATION_BEGIN, 0., 0., component);
+    if (NULL == observer || NULL == observer->iteration
+            || observer->verbosity < SOLVER_VERBOSITY_ITERATION)
+        return 0;
+    set_solver_iteration(&state, iteration, g_norm, component);
+    return observer->iteration(&state, observer->user);
+}
+
+void
+observe_result(
+    int status,
+    int iteration,
+    NonLinearComponent *component
+) {
+    SolverObserver *observer = component->observer;
+    SolverIteration state;
+
+    observe_event(TELEMETRY_SOLVE_END, status, iteration, component);
+    if (NULL != component->statistics) {
+        component->statistics->seconds =
+            monotonic_seconds() - component->started;
+        component->statistics->iterations = iteration;
+        component->statistics->iteration_f = component->iteration_f;
+        component->statistics->iteration_g = component->iteration_g;
+    }
+    if (NULL == observer || NULL == observer->result
+            || observer->verbosity < SOLVER_VERBOSITY_RESULT)
+        return;
+    set_solver_iteration(&state, iteration, 0., component);
+    observer->result(status, &state, observer->user);
+}
+
+void
+observe_message(
+    const char *message,
+    int verbosity,
+    NonLinearComponent *component
+) {
+    SolverObserver *observer = component->observer;
+    SolverIteration state;
+
+    if (NULL == observer || NULL == observer->message
+            || observer->verbosity < verbosity)
+        return;
+    set_solver_iteration(&state, 0, 0., component);
+    observer->message(message, &state, observer->user);
+}
+
+void
+observe_update_skipped(
+    NonLinearComponent *component
+) {
+    observe_event(TELEMETRY_UPDATE_SKIPPED, 0., 0., component);
+    if (NULL != component->statistics)
+        component->statistics->skipped_updates++;
+    observe_message("Matrix is NOT updated",
+            SOLVER_VERBOSITY_ITERATION, component);
+}
+
+void
+observe_event(
+    int type,
+    double value0,
+    double value1,
+    NonLinearComponent *component
+) {
+    if (TELEMETRY_LINE_SEARCH_TRIAL == type)
+        component->trials++;
+    if (NULL == component->telemetry)
+        return;
+    record_telemetry_event(component->telemetry, type,
+            component->iteration, value0, value1);
+}
+
+/*
+ * Phases other than SOLVER_PHASE_EVALUATION exclude the evaluations made
+ * while they run, which are accounted to SOLVER_PHASE_EVALUATION.
+ */
+void
+start_phase(
+    PhaseTimer *timer,
+    NonLinearComponent *component
+) {
+    timer->started = 0.;
+    timer->evaluation = 0.;
+    if (NULL == component->statistics)
+        return;
+    timer->evaluation =
+        component->statistics->phase_seconds[SOLVER_PHASE_EVALUATION];
+    if (NULL != component->perf_counters) {
+        memcpy(timer->evaluation_counter,
+                component->statistics->phase_counters[SOLVER_PHASE_EVALUATION],
+                sizeof(timer->evaluation_counter));
+        read_perf_counters(component->perf_counters, timer->counter);
+    }
+    timer->started = monotonic_seconds();
+}
+
+void
+stop_phase(
+    PhaseTimer *timer,
+    int phase,
+    long long int bytes,
+    NonLinearComponent *component
+) {
+    SolverStatistics *statistics = component->statistics;
+    unsigned long long counter[PERF_COUNTER_NUM];
+    long long int count;
+    double seconds;
+    int k;
+
+    if (NULL == statistics)
+        return;
+    seconds = monotonic_seconds() - timer->started;
+    if (NULL != component->perf_counters) {
+        read_perf_counters(component->perf_counters, counter);
+        for (k = 0; k < PERF_COUNTER_NUM; ++k) {
+            count = (long long int)(counter[k] - timer->counter[k]);
+            if (SOLVER_PHASE_EVALUATION != phase) {
+                count -= (long long int)(statistics->phase_counters
+                        [SOLVER_PHASE_EVALUATION][k]
+                        - timer->evaluation_counter[k]);
+            }
+            /* multiplexed counts are estimates and may step back */
+            if (count > 0)
+                statistics->phase_counters[phase][k] += count;
+        }
+    }
+    if (SOLVER_PHASE_EVALUATION != phase) {
+        seconds -= statistics->phase_seconds[SOLVER_PHASE_EVALUATION]
+            - timer->evaluation;
+    }
+    statistics->phase_seconds[phase] += seconds;
+    statistics->phase_calls[phase]++;
+    statistics->phase_bytes[phase] += bytes;
+}
+
+static double
+monotonic_seconds(
+    void
+) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec;
+}
+
+static void
+set_solver_iteration(
+    SolverIteration *state,
+    int iteration,
+    double g_norm,
+    NonLinearComponent *component
+) {
+    state->method_name = component->method_name;
+    state->iteration = iteration;
+    state->f = component->f;
+    state->g_norm = g_norm;
+    state->alpha = component->alpha;
+    state->iteration_f = component->iteration_f;
+    state->iteration_g = component->iteration_g;
+    state->statistics = component->statistics;
 }
 
 static int
@@ -60,8 +305,18 @@ function(
     int n,
     NonLinearComponent *component
 ) {
-    component->f = component->function_object->function(x, n);
+    PhaseTimer timer;
+
+    observe_event(TELEMETRY_EVALUATION_BEGIN,
+            TELEMETRY_EVALUATION_FUNCTION, 0., component);
+    start_phase(&timer, component);
+    component->f = component->function_object->function(
+            x, n, component->function_object->user);
     component->iteration_f++;
+    stop_phase(&timer, SOLVER_PHASE_EVALUATION,
+            (long long int)sizeof(double) * n, component);
+    observe_event(TELEMETRY_EVALUATION_END,
+            TELEMETRY_EVALUATION_FUNCTION, 0., component);
     if (component->f != component->f) {
         return NON_LINEAR_FUNCTION_OBJECT_NAN;
     }
@@ -75,9 +330,30 @@ gradient(
     int n,
     NonLinearComponent *component
 ) {
-    int i;
-    component->function_object->gradient(g, x, n);
+    int i, count;
+    PhaseTimer timer;
+
+    observe_event(TELEMETRY_EVALUATION_BEGIN,
+            TELEMETRY_EVALUATION_GRADIENT, 0., component);
+    start_phase(&timer, component);
+    if (NULL != component->function_object->gradient) {
+        component->function_object->gradient(
+                g, x, n, component->function_object->user);
+    } else if (NULL != component->function_object->function_gradient) {
+        component->f = component->function_object->function_gradient(
+                g, x, n, component->function_object->user);
+        component->iteration_f++;
+    } else if (0 > (count = finite_difference_gradient(
+                    g, NULL, x, n, component->function_object))) {
+        g[0] = NAN;
+    } else {
+        component->iteration_f += count;
+    }
     component->iteration_g++;
+    stop_phase(&timer, SOLVER_PHASE_EVALUATION,
+            (long long int)sizeof(double) * 2 * n, component);
+    observe_event(TELEMETRY_EVALUATION_END,
+            TELEMETRY_EVALUATION_GRADIENT, 0., component);
     for (i = 0; i < n; ++i) {
         if (g[i] != g[i]) {
             return NON_LINEAR_FUNCTION_OBJECT_NAN;
@@ -93,11 +369,32 @@ function_gradient(
     int n,
     NonLinearComponent *component
 ) {
-    int i;
-    component->f = component->function_object->function(x, n);
+    int i, count;
+    PhaseTimer timer;
+
+    observe_event(TELEMETRY_EVALUATION_BEGIN,
+            TELEMETRY_EVALUATION_FUNCTION_GRADIENT, 0., component);
+    start_phase(&timer, component);
+    if (NULL != component->function_object->function_gradient) {
+        component->f = component->function_object->function_gradient(
+                g, x, n, component->function_object->user);
+    } else if (NULL != component->function_object->gradient) {
+        component->f = component->function_object->function(
+                x, n, component->function_object->user);
+        component->function_object->gradient(
+                g, x, n, component->function_object->user);
+    } else if (0 > (count = finite_difference_gradient(
+                    g, &component->f, x, n, component->function_object))) {
+        component->f = NAN;
+    } else {
+        component->iteration_f += count - 1;
+    }
     component->iteration_f++;
-    component->function_object->gradient(g, x, n);
     component->iteration_g++;
+    stop_phase(&timer, SOLVER_PHASE_EVALUATION,
+            (long long int)sizeof(double) * 3 * n, component);
+    observe_event(TELEMETRY_EVALUATION_END,
+            TELEMETRY_EVALUATION_FUNCTION_GRADIENT, 0., component);
     if (component->f != component->f) {
         return NON_LINEAR_FUNCTION_OBJECT_NAN;
     }
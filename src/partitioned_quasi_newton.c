@@ -0,0 +1,566 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        partitioned_quasi_newton.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/partitioned_quasi_newton.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/mymath.h"
+
+static const char method_name[] = "Partitioned Quasi-Newton";
+
+/*
+ * The element matrix B_e is b + offset[e] (n_e x n_e, row major). The
+ * element vectors are stored like index: the entries of element e start
+ * at element_start[e].
+ * g_element:   element gradients of the last gradient evaluation
+ * g_previous:  element gradients at the current iterate
+ */
+typedef struct _PartitionedWorkspace {
+    PartiallySeparableObject *object;
+    long int *offset;
+    double *b;
+    double *f_element;
+    double *x_element;
+    double *g_element;
+    double *g_previous;
+    double *s_element;
+    double *y_element;
+    double *t_element;
+} PartitionedWorkspace;
+
+static void
+default_partitioned_quasi_newton_parameter(
+    PartitionedQuasiNewtonParameter *parameter,
+    int n
+);
+
+static void
+gather_elements(
+    double *v_element,
+    const double *v,
+    const PartiallySeparableObject *object
+);
+
+static double
+partitioned_function(
+    const double *x,
+    int n,
+    void *user
+);
+
+static void
+partitioned_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+);
+
+static void
+partitioned_product(
+    double *q,
+    const double *v,
+    int n,
+    PartitionedWorkspace *workspace
+);
+
+static int
+partitioned_direction(
+    double *d,
+    const double *g,
+    double *r,
+    int n,
+    int cg_upper_iter,
+    PartitionedWorkspace *workspace
+);
+
+static int
+update_element_matrices(
+    const double *s,
+    char formula,
+    int first,
+    PartitionedWorkspace *workspace
+);
+
+int
+partitioned_quasi_newton(
+    double *x,
+    int n,
+    PartiallySeparableObject *partially_separable_object,
+    line_search_t line_search,
+    LineSearchParameter *line_search_parameter,
+    PartitionedQuasiNewtonParameter *partitioned_quasi_newton_parameter
+) {
+    int i, e, n_e, num_elements, num_entries, status, iter, skipped;
+    long int num_matrix;
+    size_t memory_size = sizeof(double) * n;
+    double g_norm, *storage, *element_storage, *d, *g, *x_temp, *g_temp, *s,
+           *r, *work;
+    const int *element_start;
+    NonLinearComponent component;
+    EvaluateObject evaluate_object;
+    FunctionObject function_object;
+    PartitionedQuasiNewtonParameter _partitioned_quasi_newton_parameter;
+    PartitionedWorkspace workspace;
+    PhaseTimer timer;
+
+    storage = element_storage = NULL;
+    workspace.offset = NULL;
+    iter = 0;
+    /* the problem as a FunctionObject for the line searches */
+    default_function_object(&function_object);
+    function_object.function = partitioned_function;
+    function_object.gradient = partitioned_gradient;
+    function_object.user = &workspace;
+    function_object.observer = partially_separable_object->observer;
+    initialize_non_linear_component(
+            method_name, &function_object, &evaluate_object, &component);
+
+    /* make sure that f and gf of this problem exist */
+    if (NULL == partially_separable_object->function
+            || NULL == partially_separable_object->gradient
+            || NULL == partially_separable_object->element_start
+            || NULL == partially_separable_object->index) {
+        status = NON_LINEAR_NO_FUNCTION;
+        goto result;
+    }
+    if (NULL == line_search_parameter) {
+        status = NON_LINEAR_NO_PARAMETER;
+        goto result;
+    }
+    if (NULL == partitioned_quasi_newton_parameter) {
+        partitioned_quasi_newton_parameter
+            = &_partitioned_quasi_newton_parameter;
+        memset(partitioned_quasi_newton_parameter, 0,
+                sizeof(PartitionedQuasiNewtonParameter));
+    }
+    default_partitioned_quasi_newton_parameter(
+            partitioned_quasi_newton_parameter, n);
+
+    /* the element matrices, initialized as identity */
+    num_elements = partially_separable_object->num_elements;
+    element_start = partially_separable_object->element_start;
+    num_entries = element_start[num_elements];
+    workspace.object = partially_separable_object;
+    if (NULL == (workspace.offset = (long int *)malloc(
+                    sizeof(long int) * (num_elements + 1)))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    workspace.offset[0] = 0;
+    for (e = 0; e < num_elements; ++e) {
+        n_e = element_start[e + 1] - element_start[e];
+        workspace.offset[e + 1] = workspace.offset[e] + (long int)n_e * n_e;
+    }
+    num_matrix = workspace.offset[num_elements];
+    if (NULL == (element_storage = (double *)malloc(sizeof(double)
+                    * (num_matrix + num_elements + 6 * (long int)num_entries
+                        + 1)))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    workspace.b = element_storage;
+    workspace.f_element = workspace.b + num_matrix;
+    workspace.x_element = workspace.f_element + num_elements;
+    workspace.g_element = workspace.x_element + num_entries;
+    workspace.g_previous = workspace.g_element + num_entries;
+    workspace.s_element = workspace.g_previous + num_entries;
+    workspace.y_element = workspace.s_element + num_entries;
+    workspace.t_element = workspace.y_element + num_entries;
+    memset(workspace.b, 0, sizeof(double) * num_matrix);
+    for (e = 0; e < num_elements; ++e) {
+        n_e = element_start[e + 1] - element_start[e];
+        for (i = 0; i < n_e; ++i)
+            workspace.b[workspace.offset[e] + (long int)i * n_e + i] = 1.;
+    }
+    /* storage for d, g, x_temp, g_temp, s, r (4n) and work (2n) */
+    if (NULL == (storage = (double *)malloc(memory_size * 11))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    d = storage;
+    g = d + n;
+    x_temp = g + n;
+    g_temp = x_temp + n;
+    s = g_temp + n;
+    r = s + n;
+    work = r + 4 * n;
+
+    /*
+     * start to compute for solving this problem
+     */
+    if (NON_LINEAR_FUNCTION_OBJECT_NAN
+            == evaluate_object.gradient(g, x, n, &component)) {
+        status = NON_LINEAR_FUNCTION_NAN;
+        goto result;
+    }
+    memcpy(workspace.g_previous, workspace.g_element,
+            sizeof(double) * num_entries);
+    for (iter = 1; iter <= partitioned_quasi_newton_parameter->upper_iter;
+            ++iter) {
+        /* search a direction of descent */
+        start_phase(&timer, &component);
+        i = partitioned_direction(d, g, r, n,
+                partitioned_quasi_newton_parameter->cg_upper_iter,
+                &workspace);
+        stop_phase(&timer, SOLVER_PHASE_DIRECTION,
+                (long long int)sizeof(double) * i
+                * (num_matrix + 3 * num_entries + 6 * n), &component);
+        /* compute step width with a line search algorithm */
+        start_phase(&timer, &component);
+        status = line_search(work, x, g, d, n,
+                &evaluate_object, line_search_parameter, &component);
+        stop_phase(&timer, SOLVER_PHASE_LINE_SEARCH,
+                (long long int)sizeof(double) * 3 * n * component.trials,
+                &component);
+        switch (status) {
+            case LINE_SEARCH_FUNCTION_NAN:
+                status = NON_LINEAR_FUNCTION_NAN;
+                goto result;
+            case LINE_SEARCH_FAILED:
+                status = NON_LINEAR_LINE_SEARCH_FAILED;
+                goto result;
+            default:
+                break;
+        }
+        /* update x_temp = x + alpha * d and g_temp = gradient(x_temp) */
+        start_phase(&timer, &component);
+        for (i = 0; i < n; ++i) {
+            x_temp[i] = x[i] + component.alpha * d[i];
+            s[i] = component.alpha * d[i];
+        }
+        if (NON_LINEAR_FUNCTION_OBJECT_NAN
+                == evaluate_object.gradient(g_temp, x_temp, n, &component)) {
+            status = NON_LINEAR_FUNCTION_NAN;
+            goto result;
+        }
+        g_norm = infinity_norm(g_temp, n);
+        stop_phase(&timer, SOLVER_PHASE_VECTOR, 5 * memory_size, &component);
+
+        if (observe_iteration(iter, g_norm, &component)) {
+            status = NON_LINEAR_STOPPED;
+            goto result;
+        }
+        if (g_norm < partitioned_quasi_newton_parameter->tolerance) {
+            /* return the iterate which satisfied the test */
+            memcpy(x, x_temp, memory_size);
+            memcpy(g, g_temp, memory_size);
+            status = NON_LINEAR_SATISFIED;
+            goto result;
+        }
+
+        /* update the element matrices with s_e and y_e */
+        start_phase(&timer, &component);
+        skipped = update_element_matrices(s,
+                partitioned_quasi_newton_parameter->formula, 1 == iter,
+                &workspace);
+        stop_phase(&timer, SOLVER_PHASE_UPDATE,
+                (long long int)sizeof(double)
+                * (2 * num_matrix + 4 * num_entries), &component);
+        if (skipped < 0) {
+            status = NON_LINEAR_FUNCTION_NAN;
+            goto result;
+        }
+        if (skipped > 0)
+            observe_update_skipped(&component);
+
+        start_phase(&timer, &component);
+        memcpy(x, x_temp, memory_size);
+        memcpy(g, g_temp, memory_size);
+        memcpy(workspace.g_previous, workspace.g_element,
+                sizeof(double) * num_entries);
+        stop_phase(&timer, SOLVER_PHASE_VECTOR,
+                4 * memory_size + 2 * sizeof(double) * num_entries,
+                &component);
+    }
+    status = NON_LINEAR_NO_CONVERGENCE;
+result:
+    observe_result(status, iter, &component);
+    free(storage);
+    free(element_storage);
+    free(workspace.offset);
+
+    return status;
+}
+
+static void
+default_partitioned_quasi_newton_parameter(
+    PartitionedQuasiNewtonParameter *parameter,
+    int n
+) {
+    parameter->formula =
+        parameter->formula ? parameter->formula : 'b';
+    parameter->tolerance =
+        parameter->tolerance > lower_eps ? parameter->tolerance : lower_eps;
+    parameter->upper_iter = parameter->upper_iter > lower_iteration
+        && parameter->upper_iter < upper_iteration
+        ? parameter->upper_iter : upper_iteration;
+    parameter->cg_upper_iter = parameter->cg_upper_iter > 0
+        ? parameter->cg_upper_iter
+        : (n < upper_iteration ? n : upper_iteration);
+}
+
+static void
+gather_elements(
+    double *v_element,
+    const double *v,
+    const PartiallySeparableObject *object
+) {
+    int k, num_entries = object->element_start[object->num_elements];
+
+#pragma omp parallel for schedule(static)
+    for (k = 0; k < num_entries; ++k)
+        v_element[k] = v[object->index[k]];
+}
+
+static double
+partitioned_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    PartitionedWorkspace *workspace = (PartitionedWorkspace *)user;
+    const PartiallySeparableObject *object = workspace->object;
+    const int *element_start = object->element_start;
+    int e;
+    double f;
+
+    gather_elements(workspace->x_element, x, object);
+#pragma omp parallel for schedule(dynamic, 64)
+    for (e = 0; e < object->num_elements; ++e) {
+        workspace->f_element[e] = object->function(
+                workspace->x_element + element_start[e],
+                element_start[e + 1] - element_start[e], e, object->user);
+    }
+    for (e = 0, f = 0.; e < object->num_elements; ++e)
+        f += workspace->f_element[e];
+    return f;
+}
+
+/*
+ * the element gradients are kept in g_element for the update
+ */
+static void
+partitioned_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    PartitionedWorkspace *workspace = (PartitionedWorkspace *)user;
+    const PartiallySeparableObject *object = workspace->object;
+    const int *element_start = object->element_start;
+    int e, k;
+
+    gather_elements(workspace->x_element, x, object);
+#pragma omp parallel for schedule(dynamic, 64)
+    for (e = 0; e < object->num_elements; ++e) {
+        object->gradient(workspace->g_element + element_start[e],
+                workspace->x_element + element_start[e],
+                element_start[e + 1] - element_start[e], e, object->user);
+    }
+    memset(g, 0, sizeof(double) * n);
+    for (k = 0; k < element_start[object->num_elements]; ++k)
+        g[object->index[k]] += workspace->g_element[k];
+}
+
+/*
+ * q = sum of U_e^T B_e U_e v
+ */
+static void
+partitioned_product(
+    double *q,
+    const double *v,
+    int n,
+    PartitionedWorkspace *workspace
+) {
+    const PartiallySeparableObject *object = workspace->object;
+    const int *element_start = object->element_start;
+    int e, i, j, k, n_e;
+    const double *b_e, *v_e;
+    double temp;
+
+    gather_elements(workspace->s_element, v, object);
+#pragma omp parallel for private(i, j, n_e, b_e, v_e, temp) \
+    schedule(dynamic, 64)
+    for (e = 0; e < object->num_elements; ++e) {
+        n_e = element_start[e + 1] - element_start[e];
+        b_e = workspace->b + workspace->offset[e];
+        v_e = workspace->s_element + element_start[e];
+        for (i = 0; i < n_e; ++i) {
+            for (j = 0, temp = 0.; j < n_e; ++j)
+                temp += b_e[i * n_e + j] * v_e[j];
+            workspace->t_element[element_start[e] + i] = temp;
+        }
+    }
+    memset(q, 0, sizeof(double) * n);
+    for (k = 0; k < element_start[object->num_elements]; ++k)
+        q[object->index[k]] += workspace->t_element[k];
+}
+
+/*
+ * Solves (sum of U_e^T B_e U_e) d = -g by conjugate gradient
+ * preconditioned with the diagonal of the sum, to the relative residual
+ * min(0.5, sqrt(||g||)), stopping at negative curvature (SR1). Falls back
+ * to -g when d is not a direction of descent. r is work of 4n. Returns
+ * the number of products.
+ */
+static int
+partitioned_direction(
+    double *d,
+    const double *g,
+    double *r,
+    int n,
+    int cg_upper_iter,
+    PartitionedWorkspace *workspace
+) {
+    const PartiallySeparableObject *object = workspace->object;
+    const int *element_start = object->element_start;
+    int e, i, k, n_e;
+    double rz, rz_new, rr, pq, alpha, beta, target, *z, *p, *q;
+
+    z = r + n;
+    p = z + n;
+    q = p + n;
+    /* the diagonal of the sum of the element matrices in q */
+    memset(q, 0, sizeof(double) * n);
+    for (e = 0; e < object->num_elements; ++e) {
+        n_e = element_start[e + 1] - element_start[e];
+        for (i = 0; i < n_e; ++i) {
+            q[object->index[element_start[e] + i]]
+                += workspace->b[workspace->offset[e] + (long int)i * n_e + i];
+        }
+    }
+    for (i = 0; i < n; ++i) {
+        d[i] = 0.;
+        r[i] = -g[i];
+        z[i] = p[i] = q[i] > 0. ? r[i] / q[i] : r[i];
+    }
+    /* z holds the inverse of the diagonal from here on */
+    for (i = 0; i < n; ++i)
+        z[i] = q[i] > 0. ? 1. / q[i] : 1.;
+    rz = dot_product(r, p, n);
+    rr = dot_product(r, r, n);
+    target = sqrt(rr) < .25 ? sqrt(rr) * rr : .25 * rr;
+    for (k = 0; k < cg_upper_iter && rr > target; ++k) {
+        partitioned_product(q, p, n, workspace);
+        pq = dot_product(p, q, n);
+        if (pq <= 0. || pq != pq)
+            break;
+        alpha = rz / pq;
+        for (i = 0, rr = rz_new = 0.; i < n; ++i) {
+            d[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+            rr += r[i] * r[i];
+            rz_new += r[i] * r[i] * z[i];
+        }
+        beta = rz_new / rz;
+        rz = rz_new;
+        for (i = 0; i < n; ++i)
+            p[i] = z[i] * r[i] + beta * p[i];
+    }
+    if (0 == k || dot_product(d, g, n) >= 0.) {
+        for (i = 0; i < n; ++i)
+            d[i] = -g[i];
+    }
+    return k;
+}
+
+/*
+ * B_e from s_e = U_e s and y_e = g_e(x_temp) - g_e(x) of every element:
+ *  'b' - BFGS when s_e^T y_e > 1e-8 ||s_e|| ||y_e||; on the first call
+ *        B_e is scaled to y_e^T y_e / s_e^T y_e beforehand
+ *  's' - SR1 when |s_e^T r_e| >= sr1_skipping_ratio ||s_e|| ||r_e||,
+ *        r_e = y_e - B_e s_e
+ * Elements whose variables did not move are left as they are. Returns the
+ * number of skipped elements, or -1 for Not a Number.
+ */
+static int
+update_element_matrices(
+    const double *s,
+    char formula,
+    int first,
+    PartitionedWorkspace *workspace
+) {
+    const PartiallySeparableObject *object = workspace->object;
+    const int *element_start = object->element_start;
+    int e, i, j, k, n_e, skipped = 0, failed = 0;
+    double *b_e, *s_e, *y_e, *t_e, sy, sr, sBs, ss, yy, tt, scale;
+
+    gather_elements(workspace->s_element, s, object);
+    for (k = 0; k < element_start[object->num_elements]; ++k) {
+        workspace->y_element[k]
+            = workspace->g_element[k] - workspace->g_previous[k];
+    }
+#pragma omp parallel for private(i, j, n_e, b_e, s_e, y_e, t_e, \
+        sy, sr, sBs, ss, yy, tt, scale) \
+    reduction(+:skipped, failed) schedule(dynamic, 64)
+    for (e = 0; e < object->num_elements; ++e) {
+        n_e = element_start[e + 1] - element_start[e];
+        b_e = workspace->b + workspace->offset[e];
+        s_e = workspace->s_element + element_start[e];
+        y_e = workspace->y_element + element_start[e];
+        t_e = workspace->t_element + element_start[e];
+        for (i = 0, sy = ss = yy = 0.; i < n_e; ++i) {
+            sy += s_e[i] * y_e[i];
+            ss += s_e[i] * s_e[i];
+            yy += y_e[i] * y_e[i];
+        }
+        if (0. == ss)
+            continue;
+        if (sy != sy || yy != yy) {
+            failed++;
+            continue;
+        }
+        if ('s' == formula || 'S' == formula) {
+            /* t_e = r_e = y_e - B_e s_e */
+            for (i = 0, sr = tt = 0.; i < n_e; ++i) {
+                for (j = 0, t_e[i] = y_e[i]; j < n_e; ++j)
+                    t_e[i] -= b_e[i * n_e + j] * s_e[j];
+                sr += s_e[i] * t_e[i];
+                tt += t_e[i] * t_e[i];
+            }
+            if (fabs(sr) < sr1_skipping_ratio * sqrt(ss * tt)) {
+                skipped += 0. != tt;
+                continue;
+            }
+            for (i = 0; i < n_e; ++i) {
+                for (j = 0; j < n_e; ++j)
+                    b_e[i * n_e + j] += t_e[i] * t_e[j] / sr;
+            }
+            continue;
+        }
+        if (sy <= 1.e-8 * sqrt(ss * yy)) {
+            skipped++;
+            continue;
+        }
+        if (first) {
+            scale = yy / sy;
+            for (i = 0; i < n_e * n_e; ++i)
+                b_e[i] *= scale;
+        }
+        /* t_e = B_e s_e */
+        for (i = 0, sBs = 0.; i < n_e; ++i) {
+            for (j = 0, t_e[i] = 0.; j < n_e; ++j)
+                t_e[i] += b_e[i * n_e + j] * s_e[j];
+            sBs += s_e[i] * t_e[i];
+        }
+        for (i = 0; i < n_e; ++i) {
+            for (j = 0; j < n_e; ++j) {
+                b_e[i * n_e + j] += y_e[i] * y_e[j] / sy
+                    - t_e[i] * t_e[j] / sBs;
+            }
+        }
+    }
+    return failed ? -1 : skipped;
+}
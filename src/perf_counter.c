@@ -0,0 +1,148 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        perf_counter.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/perf_counter.h"
+
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static const unsigned long long perf_event_config[PERF_COUNTER_NUM] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+static int
+open_perf_event(
+    unsigned long long config,
+    int group
+);
+#endif
+
+int
+initialize_perf_counters(
+    PerfCounters *counters
+) {
+    int k;
+
+    counters->leader = -1;
+    counters->num = 0;
+    counters->mask = 0;
+    for (k = 0; k < PERF_COUNTER_NUM; ++k) {
+        counters->fd[k] = -1;
+        counters->index[k] = -1;
+    }
+#ifdef __linux__
+    for (k = 0; k < PERF_COUNTER_NUM; ++k) {
+        counters->fd[k] = open_perf_event(
+                perf_event_config[k], counters->leader);
+        if (counters->fd[k] < 0)
+            continue;
+        if (counters->leader < 0)
+            counters->leader = counters->fd[k];
+        counters->index[k] = counters->num++;
+        counters->mask |= 1 << k;
+    }
+    if (counters->leader < 0)
+        return -1;
+    ioctl(counters->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(counters->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+void
+release_perf_counters(
+    PerfCounters *counters
+) {
+#ifdef __linux__
+    int k;
+
+    /* close the members before the leader */
+    for (k = PERF_COUNTER_NUM - 1; k >= 0; --k) {
+        if (counters->fd[k] >= 0)
+            close(counters->fd[k]);
+        counters->fd[k] = -1;
+        counters->index[k] = -1;
+    }
+#endif
+    counters->leader = -1;
+    counters->num = 0;
+    counters->mask = 0;
+}
+
+/*
+ * value[k] is the count of event k so far, scaled up when the kernel
+ * had to multiplex the group; returns -1 with zeros when nothing is
+ * counted.
+ */
+int
+read_perf_counters(
+    const PerfCounters *counters,
+    unsigned long long *value
+) {
+    int k;
+#ifdef __linux__
+    /* nr, time_enabled, time_running and a value per event */
+    unsigned long long buffer[3 + PERF_COUNTER_NUM];
+    double scale;
+#endif
+
+    for (k = 0; k < PERF_COUNTER_NUM; ++k)
+        value[k] = 0;
+    if (counters->leader < 0)
+        return -1;
+#ifdef __linux__
+    if (read(counters->leader, buffer, sizeof(buffer))
+            < (long int)(sizeof(unsigned long long) * (3 + counters->num)))
+        return -1;
+    scale = buffer[2] > 0 && buffer[2] < buffer[1]
+        ? (double)buffer[1] / (double)buffer[2] : 1.;
+    for (k = 0; k < PERF_COUNTER_NUM; ++k) {
+        if (counters->index[k] >= 0) {
+            value[k] = 1. == scale ? buffer[3 + counters->index[k]]
+                : (unsigned long long)(scale
+                        * (double)buffer[3 + counters->index[k]]);
+        }
+    }
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+#ifdef __linux__
+static int
+open_perf_event(
+    unsigned long long config,
+    int group
+) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP
+        | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+#endif
@@ -4,7 +4,7 @@
  * File:        print_message.c
  * Version:     0.1.0
  * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
- * Last Change: 09-Jul-2012.
+ * Last Change: 19-Oct-2026.
  * TODO:
  */
 
@@ -13,61 +13,145 @@
 #include <stdio.h>
 
 void
+initialize_print_observer(
+    SolverObserver *observer,
+    int verbosity
+) {
+    observer->verbosity = verbosity;
+    observer->iteration = print_iteration_info;
+    observer->result = print_result_info;
+    observer->message = print_message_info;
+    observer->user = NULL;
+    observer->telemetry = NULL;
+    observer->statistics = NULL;
+    observer->perf_counters = NULL;
+}
+
+int
 print_iteration_info(
-    int iteration,
-    double g_norm,
-    NonLinearComponent *component
+    const SolverIteration *iteration,
+    void *user
 ) {
-    printf("\n == iteration: %7d ================================\n", iteration);
-    printf("step width parameter:  \t%13.6e\n", component->alpha);
-    printf("-------------------------------------------------------\n");
-    printf("function value:        \t%13.6e\n", component->f);
-    printf("||gf(x_k+1)||_infinity = %e\n", g_norm);
-    printf("-------------------------------------------------------\n");
+    FILE *stream = NULL != user ? (FILE *)user : stdout;
+
+    fprintf(stream, "\n == iteration: %7d ================================\n",
+            iteration->iteration);
+    fprintf(stream, "step width parameter:  \t%13.6e\n", iteration->alpha);
+    fprintf(stream, "-------------------------------------------------------\n");
+    fprintf(stream, "function value:        \t%13.6e\n", iteration->f);
+    fprintf(stream, "||gf(x_k+1)||_infinity = %e\n", iteration->g_norm);
+    fprintf(stream, "-------------------------------------------------------\n");
+    return 0;
 }
 
 void
 print_result_info(
     int status,
-    int iteration,
-    NonLinearComponent *component
+    const SolverIteration *iteration,
+    void *user
 ) {
-    printf("\n\n\nCompute status: %3d\n", status);
+    FILE *stream = NULL != user ? (FILE *)user : stdout;
+
+    fprintf(stream, "\n\n\nCompute status: %3d\n", status);
     switch (status) {
         case NON_LINEAR_SATISFIED:
-            printf("Satisfied: %s Method is finished\n", component->method_name);
+            fprintf(stream, "Satisfied: %s Method is finished\n",
+                    iteration->method_name);
             break;
         case NON_LINEAR_FUNCTION_NAN:
-            printf("Failed: Function value is Not a Number\n");
+            fprintf(stream, "Failed: Function value is Not a Number\n");
             break;
         case NON_LINEAR_OUT_OF_MEMORY:
-            printf("Failed: Out of Memory\n");
+            fprintf(stream, "Failed: Out of Memory\n");
             break;
         case NON_LINEAR_NO_FUNCTION:
-            printf("Failed: Function Object is not defined\n");
+            fprintf(stream, "Failed: Function Object is not defined\n");
             break;
         case NON_LINEAR_NO_PARAMETER:
-            printf("Failed: Parameter of line search is not defined\n");
+            fprintf(stream, "Failed: Parameter of line search is not defined\n");
             break;
         case NON_LINEAR_FAILED:
-            printf("Failed: FAILED\n");
+            fprintf(stream, "Failed: FAILED\n");
             break;
         case NON_LINEAR_NO_CONVERGENCE:
-            printf("Failed: No convergence\n");
+            fprintf(stream, "Failed: No convergence\n");
             break;
         case NON_LINEAR_LINE_SEARCH_FAILED:
-            printf("Failed: Line Search is failed\n");
+            fprintf(stream, "Failed: Line Search is failed\n");
+            break;
+        case NON_LINEAR_STOPPED:
+            fprintf(stream, "Stopped: %s Method is stopped by the observer\n",
+                    iteration->method_name);
             break;
         default:
             break;
     }
     if (status >= NON_LINEAR_SATISFIED) {
-        printf("-------------------------------------------------------\n");
-        printf("iterations:          %12d\n", iteration);
-        printf("function evaluations:%12d\n", component->iteration_f);
-        printf("gradient evaluations:%12d\n", component->iteration_g);
-        printf("=======================================================\n");
-        printf("function value:      \t%13.6e\n", component->f);
+        fprintf(stream, "-------------------------------------------------------\n");
+        fprintf(stream, "iterations:          %12d\n", iteration->iteration);
+        fprintf(stream, "function evaluations:%12d\n", iteration->iteration_f);
+        fprintf(stream, "gradient evaluations:%12d\n", iteration->iteration_g);
+        fprintf(stream, "=======================================================\n");
+        fprintf(stream, "function value:      \t%13.6e\n", iteration->f);
+    }
+    if (NULL != iteration->statistics) {
+        print_statistics_info(iteration->statistics, stream);
     }
 }
 
+void
+print_statistics_info(
+    const SolverStatistics *statistics,
+    FILE *stream
+) {
+    static const char *phase_name[SOLVER_PHASE_NUM] = {
+        "evaluation", "line search", "direction", "update", "vector"
+    };
+    int i;
+
+    fprintf(stream, "-------------------------------------------------------\n");
+    fprintf(stream, "phase          seconds       calls        bytes\n");
+    for (i = 0; i < SOLVER_PHASE_NUM; ++i) {
+        fprintf(stream, "%-12s %13.6e %9ld %14lld\n", phase_name[i],
+                statistics->phase_seconds[i], statistics->phase_calls[i],
+                statistics->phase_bytes[i]);
+    }
+    fprintf(stream, "total        %13.6e\n", statistics->seconds);
+    fprintf(stream, "skipped updates:     %12d\n",
+            statistics->skipped_updates);
+    fprintf(stream, "SOR sweeps:          %12ld\n", statistics->sor_sweeps);
+    fprintf(stream, "line search trials per iteration:\n");
+    for (i = 0; i < SOLVER_TRIAL_BINS; ++i) {
+        if (statistics->trials[i] > 0) {
+            fprintf(stream, "  %2d%s %9d\n", i,
+                    SOLVER_TRIAL_BINS - 1 == i ? "+" : " ",
+                    statistics->trials[i]);
+        }
+    }
+    if (0 == statistics->counters)
+        return;
+    fprintf(stream, "phase           cycles  instructions   IPC  "
+            "LLC misses  branch misses\n");
+    for (i = 0; i < SOLVER_PHASE_NUM; ++i) {
+        const unsigned long long *counter = statistics->phase_counters[i];
+        fprintf(stream, "%-12s %11llu %13llu %5.2f %11llu %14llu\n",
+                phase_name[i], counter[PERF_COUNTER_CYCLES],
+                counter[PERF_COUNTER_INSTRUCTIONS],
+                counter[PERF_COUNTER_CYCLES] > 0
+                ? (double)counter[PERF_COUNTER_INSTRUCTIONS]
+                / (double)counter[PERF_COUNTER_CYCLES] : 0.,
+                counter[PERF_COUNTER_LLC_MISSES],
+                counter[PERF_COUNTER_BRANCH_MISSES]);
+    }
+}
+
+void
+print_message_info(
+    const char *message,
+    const SolverIteration *iteration,
+    void *user
+) {
+    FILE *stream = NULL != user ? (FILE *)user : stdout;
+
+    fprintf(stream, "* %s\n", message);
+}
@@ -4,27 +4,31 @@
  * File:        quasi_newton.c
  * Version:     0.1.0
  * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
- * Last Change: 12-Jul-2012.
+ * Last Change: 19-Oct-2026.
  * TODO:
  */
 
 #include "include/quasi_newton.h"
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "include/mymath.h"
-#include "include/print_message.h"
+#include "include/quasi_newton_kernels.h"
+#include "include/solver_context.h"
 
-static char method_name[64] = "Quasi-Newton";
+static const char method_name[] = "Quasi-Newton";
 
 typedef struct _QuasiNewtonFormula {
     int (*direction_search)(
             double *,
             double **,
             double *,
-            int
+            double *,
+            int,
+            NonLinearComponent *
         );
     int (*update_matrix)(
             double **,
@@ -46,33 +50,35 @@ set_quasi_newton_formula(
     QuasiNewtonParameter *parameter
 );
 
+static void
+count_direction(
+    int sweeps,
+    int n,
+    NonLinearComponent *component
+);
+
 static int
 direction_search_bfgs_B_formula(
     double *d,
     double **B,
     double *g,
-    int n
-);
-
-static int
-update_matrix_bfgs_B_formula(
-    double **B,
-    const double *s,
-    const double *y,
-    double *Bs,
-    int n
+    double *work,
+    int n,
+    NonLinearComponent *component
 );
 
 static int
-direction_search_bfgs_H_formula(
+direction_search_sr1_H_formula(
     double *d,
     double **H,
     double *g,
-    int n
+    double *work,
+    int n,
+    NonLinearComponent *component
 );
 
 static int
-update_matrix_bfgs_H_formula(
+update_matrix_sr1_H_formula(
     double **H,
     const double *s,
     const double *y,
@@ -90,70 +96,91 @@ quasi_newton(
     LineSearchParameter *line_search_parameter,
     QuasiNewtonParameter *quasi_newton_parameter
 ) {
-    int i, j, iter, status, storage_b_num, storage_num;
+    int status;
+    SolverContext context;
+
+    /* the matrix is not reserved when the caller gives b */
+    status = initialize_solver_context(&context, 'q', n, NULL != b);
+    if (NON_LINEAR_SATISFIED == status) {
+        status = quasi_newton_with_context(&context, x, b, n,
+                function_object, line_search, line_search_parameter,
+                quasi_newton_parameter);
+    }
+    release_solver_context(&context);
+    return status;
+}
+
+int
+quasi_newton_with_context(
+    SolverContext *context,
+    double *x,
+    double **b,
+    int n,
+    FunctionObject *function_object,
+    line_search_t line_search,
+    LineSearchParameter *line_search_parameter,
+    QuasiNewtonParameter *quasi_newton_parameter
+) {
+    int i, j, iter, status, storage_num;
     long int memory_size;
     double g_norm,
-           *storage, *storage_x, **storage_b,
-           *d, *g, *x_temp, *g_temp, *work, *s, *y;
+           *storage,
+           *d, *g, *x_temp, *g_temp, *work, *s, *y, *solve;
     NonLinearComponent component;
+    PhaseTimer timer;
     QuasiNewtonFormula quasi_newton_formula;
     QuasiNewtonParameter _quasi_newton_parameter;
     EvaluateObject evaluate_object;
 
     /* memory_size is for doing memcpy */
     memory_size = sizeof(double) * n;
-    /* prepare a number of vector for storage_b and storage */
-    storage_b_num = n;
-    storage_num = 6;
+    /* prepare a number of vector for storage */
+    storage_num = 8;
+    iter = 0;
+    /* set the component of Non-Linear Programming */
+    initialize_non_linear_component(
+            method_name, function_object, &evaluate_object, &component);
     /*
-     * allocate memory to storage
+     * take memory of storage from the arena of the context
      */
+    reset_solver_context(context);
     if (NULL == x) {
-        /* allocate memory to storage_x for x as a vector */
-        if (NULL == (storage_x = (double *)malloc(memory_size))) {
+        /* x as a vector */
+        if (NULL == (x = (double *)solver_context_allocate(
+                        context, memory_size))) {
             status = NON_LINEAR_OUT_OF_MEMORY;
             goto result;
         }
         for (i = 0; i < n; ++i) {
-            storage_x[i] = 0.;
+            x[i] = 0.;
         }
-        x = storage_x;
-    } else {
-        storage_x = NULL;
     }
     if (NULL == b) {
-        /* allocate memory to storage_b for b as a matrix
-         *      size: storage_b_num * n */
-        if (NULL == (storage_b = (double **)malloc(
-                        sizeof(double *) * storage_b_num))) {
+        /* b as a matrix (n * n) */
+        if (NULL == (b = (double **)solver_context_allocate(
+                        context, sizeof(double *) * n))) {
             status = NON_LINEAR_OUT_OF_MEMORY;
             goto result;
         }
-        if (NULL == (*storage_b = (double *)malloc(
-                        memory_size * storage_b_num))) {
+        if (NULL == (*b = (double *)solver_context_allocate(
+                        context, memory_size * n))) {
             status = NON_LINEAR_OUT_OF_MEMORY;
             goto result;
         }
-        for (i = 1; i < storage_b_num; ++i) {
-            storage_b[i] = storage_b[i - 1] + n;
+        for (i = 1; i < n; ++i) {
+            b[i] = b[i - 1] + n;
         }
         /* initialize a matrix as identify */
-        for (i = 0; i < storage_b_num; ++i) {
-            storage_b[i][i] = 1.;
-            for (j = 0; j < i; ++j) {
-                storage_b[i][j] = 0.;
-            }
-            for (j = i + 1; j < n; ++j) {
-                storage_b[i][j] = 0.;
+        for (i = 0; i < n; ++i) {
+            for (j = 0; j < n; ++j) {
+                b[i][j] = 0.;
             }
+            b[i][i] = 1.;
         }
-        b = storage_b;
-    } else {
-        storage_b = NULL;
     }
-    /* allocate memory to storage for d, g, x_temp, g_temp and
-     * work (s and y) */
-    if (NULL == (storage = (double *)malloc(memory_size * storage_num))) {
+    /* storage for d, g, x_temp, g_temp, work (s and y) and solve */
+    if (NULL == (storage = (double *)solver_context_allocate(
+                    context, memory_size * storage_num))) {
         status = NON_LINEAR_OUT_OF_MEMORY;
         goto result;
     }
@@ -164,21 +191,19 @@ quasi_newton(
     /* work share memory with s and y */
     s = work = g_temp + n;
     y = s + n;
+    /* the workspace of the direction search */
+    solve = y + n;
 
-    /* make sure that f and gf of this problem exist */
-    if (NULL == function_object->function
-            || NULL == function_object->gradient) {
+    /* make sure that f of this problem exists (gf may be differenced) */
+    if (NULL == function_object->function) {
         status = NON_LINEAR_NO_FUNCTION;
         goto result;
     }
 
-    /* set the component of Non-Linear Programming */
-    initialize_non_linear_component(
-            method_name, function_object, &evaluate_object, &component);
-
     /* set the parameter of Quasi-Newton method */
     if (NULL == quasi_newton_parameter) {
         quasi_newton_parameter = &_quasi_newton_parameter;
+        memset(quasi_newton_parameter, 0, sizeof(QuasiNewtonParameter));
     }
     default_quasi_newton_parameter(quasi_newton_parameter);
 
@@ -201,13 +226,21 @@ quasi_newton(
     }
     for (iter = 1; iter <= quasi_newton_parameter->upper_iter; ++iter) {
         /* search a direction of descent */
-        status = quasi_newton_formula.direction_search(d, b, g, n);
+        start_phase(&timer, &component);
+        status = quasi_newton_formula.direction_search(
+                d, b, g, solve, n, &component);
+        stop_phase(&timer, SOLVER_PHASE_DIRECTION, 0, &component);
         if (status) {
             goto result;
         }
         /* compute step width with a line search algorithm */
-        switch (line_search(work, x, g, d, n,
-                    &evaluate_object, line_search_parameter, &component)) {
+        start_phase(&timer, &component);
+        status = line_search(work, x, g, d, n,
+                &evaluate_object, line_search_parameter, &component);
+        stop_phase(&timer, SOLVER_PHASE_LINE_SEARCH,
+                (long long int)sizeof(double) * 3 * n * component.trials,
+                &component);
+        switch (status) {
             case LINE_SEARCH_FUNCTION_NAN:
                 status = NON_LINEAR_FUNCTION_NAN;
                 goto result;
@@ -218,6 +251,7 @@ quasi_newton(
                 break;
         }
         /* update x_temp = x + alpha * d */
+        start_phase(&timer, &component);
         for (i = 0; i < n; ++i) {
             x_temp[i] = x[i] + component.alpha * d[i];
         }
@@ -229,26 +263,38 @@ quasi_newton(
         }
         /* compute g_norm */
         g_norm = infinity_norm(g_temp, n);
+        stop_phase(&timer, SOLVER_PHASE_VECTOR, 4 * memory_size, &component);
 
-        print_iteration_info(iter, g_norm, &component);
+        if (observe_iteration(iter, g_norm, &component)) {
+            status = NON_LINEAR_STOPPED;
+            goto result;
+        }
 
         if (g_norm < quasi_newton_parameter->tolerance) {
+            /* return the iterate which satisfied the test */
+            memcpy(x, x_temp, memory_size);
+            memcpy(g, g_temp, memory_size);
             status = NON_LINEAR_SATISFIED;
             goto result;
         }
 
         /* compute s = x_temp - x and y = g_temp - g */
+        start_phase(&timer, &component);
         for (i = 0; i < n; ++i) {
             s[i] = x_temp[i] - x[i];
             y[i] = g_temp[i] - g[i];
         }
+        stop_phase(&timer, SOLVER_PHASE_VECTOR, 6 * memory_size, &component);
         /* update matrix */
+        start_phase(&timer, &component);
         status = quasi_newton_formula.update_matrix(b, s, y, x, n);
+        stop_phase(&timer, SOLVER_PHASE_UPDATE,
+                (long long int)sizeof(double) * 3 * n * n, &component);
         switch (status) {
             case NON_LINEAR_FUNCTION_NAN:
                 goto result;
             case NON_LINEAR_NOT_UPDATE:
-                printf("* Matrix is NOT updated\n");
+                observe_update_skipped(&component);
             case NON_LINEAR_SATISFIED:
             default:
                 break;
@@ -258,30 +304,14 @@ quasi_newton(
          *  If you'd like to update vector, use memcpy from string.h.
          *  Don't use For statement. It's slow.
          * update x and g to new step */
+        start_phase(&timer, &component);
         memcpy(x, x_temp, memory_size);
         memcpy(g, g_temp, memory_size);
+        stop_phase(&timer, SOLVER_PHASE_VECTOR, 4 * memory_size, &component);
     }
     status = NON_LINEAR_NO_CONVERGENCE;
 result:
-    print_result_info(status, iter, &component);
-
-    /* release memory of storage_x, storage_b and storage_x */
-    if (NULL != storage_x) {
-        free(storage_x);
-        storage_x = NULL;
-    }
-    if (NULL != storage_b) {
-        if (NULL != *storage_b) {
-            free(*storage_b);
-            *storage_b = NULL;
-        }
-        free(storage_b);
-        storage_b = NULL;
-    }
-    if (NULL != storage) {
-        free(storage);
-        storage = NULL;
-    }
+    observe_result(status, iter, &component);
 
     return status;
 }
@@ -313,6 +343,10 @@ set_quasi_newton_formula(
             quasi_newton_formula->direction_search = direction_search_bfgs_H_formula;
             quasi_newton_formula->update_matrix = update_matrix_bfgs_H_formula;
             break;
+        case 's': case 'S':
+            quasi_newton_formula->direction_search = direction_search_sr1_H_formula;
+            quasi_newton_formula->update_matrix = update_matrix_sr1_H_formula;
+            break;
         default:
             quasi_newton_formula->direction_search = direction_search_bfgs_H_formula;
             quasi_newton_formula->update_matrix = update_matrix_bfgs_H_formula;
@@ -325,19 +359,49 @@ direction_search_bfgs_B_formula(
     double *d,
     double **B,
     double *g,
-    int n
+    double *work,
+    int n,
+    NonLinearComponent *component
 ) {
-    int i , status;
+    int i , status, sweeps;
 
     for (i = 0; i < n; ++i)
         g[i] = -g[i];
-    status = successive_over_relaxation(B, d, g, n, 1.e-7, 0.5);
+    /*
+     * B is dense, not consistently ordered, so the relaxation of SOR has no
+     * reliable estimate; symmetric Gauss-Seidel with Chebyshev acceleration
+     * needs only that B is positive definite
+     */
+    status = chebyshev_symmetric_successive_over_relaxation(
+            B, d, g, n, 1.e-7, 1., upper_iteration, work, &sweeps);
     for (i = 0; i < n; ++i)
         g[i] = -g[i];
+    count_direction(2 * sweeps, n, component);
+    /*
+     * an unconverged d serves while it is a direction of descent; fall back
+     * on the steepest descent direction otherwise, as SR1 does
+     */
+    switch (status) {
+        case MY_MATH_NOT_UPDATE:
+            if (dot_product(g, d, n) >= 0.) {
+                for (i = 0; i < n; ++i)
+                    d[i] = -g[i];
+            }
+            status = NON_LINEAR_SATISFIED;
+            break;
+        case MY_MATH_FUNCTION_NAN:
+            status = NON_LINEAR_FUNCTION_NAN;
+            break;
+        case MY_MATH_FAILED:
+            status = NON_LINEAR_FAILED;
+            break;
+        default:
+            break;
+    }
     return status;
 }
 
-static int
+int
 update_matrix_bfgs_B_formula(
     double **B,
     const double *s,
@@ -373,12 +437,14 @@ update_matrix_bfgs_B_formula(
     return NON_LINEAR_NOT_UPDATE;
 }
 
-static int
+int
 direction_search_bfgs_H_formula(
     double *d,
     double **H,
     double *g,
-    int n
+    double *work,
+    int n,
+    NonLinearComponent *component
 ) {
     int i, j;
     double Hg;
@@ -390,10 +456,11 @@ direction_search_bfgs_H_formula(
             return NON_LINEAR_FUNCTION_NAN;
         d[i] = Hg;
     }
+    count_direction(0, n, component);
     return NON_LINEAR_SATISFIED;
 }
 
-static int
+int
 update_matrix_bfgs_H_formula(
     double **H,
     const double *s,
@@ -430,3 +497,88 @@ update_matrix_bfgs_H_formula(
     return NON_LINEAR_NOT_UPDATE;
 }
 
+
+static int
+direction_search_sr1_H_formula(
+    double *d,
+    double **H,
+    double *g,
+    double *work,
+    int n,
+    NonLinearComponent *component
+) {
+    /*
+     * NOTE:
+     *  H of SR1 is not always positive definite. If -Hg is not a direction
+     *  of descent, fall back on the steepest descent direction so that the
+     *  line search can still be applied.
+     */
+    int i, status;
+
+    status = direction_search_bfgs_H_formula(d, H, g, work, n, component);
+    if (status)
+        return status;
+    if (dot_product(g, d, n) >= 0.) {
+        for (i = 0; i < n; ++i)
+            d[i] = -g[i];
+    }
+    return NON_LINEAR_SATISFIED;
+}
+
+static int
+update_matrix_sr1_H_formula(
+    double **H,
+    const double *s,
+    const double *y,
+    double *Hy,
+    int n
+) {
+    /*
+     * H = H + (s - Hy)(s - Hy)^T / (s - Hy)^T y
+     *
+     * The update is skipped if |(s - Hy)^T y| < r * ||s - Hy|| * ||y||
+     * so that the denominator can not be vanishingly small.
+     */
+    int i, j;
+    double Hyi, vy, v_norm, y_norm;
+
+    for (i = 0; i < n; ++i) {
+        for (j = 0, Hyi = 0.; j < n; j++) {
+            Hyi += H[i][j] * y[j];
+        }
+        if (Hyi != Hyi)
+            return NON_LINEAR_FUNCTION_NAN;
+        /* Hy is overwritten with v = s - Hy */
+        Hy[i] = s[i] - Hyi;
+    }
+    vy = dot_product(Hy, y, n);
+    v_norm = euclidean_norm(Hy, n);
+    y_norm = euclidean_norm(y, n);
+    if (vy != vy)
+        return NON_LINEAR_FUNCTION_NAN;
+    if (fabs(vy) >= sr1_skipping_ratio * v_norm * y_norm && 0. != vy) {
+        for (i = 0; i < n; ++i) {
+            for (j = 0; j < n; j++) {
+                H[i][j] += Hy[i] * Hy[j] / vy;
+            }
+        }
+        return NON_LINEAR_SATISFIED;
+    }
+    return NON_LINEAR_NOT_UPDATE;
+}
+
+/*
+ * a pass over H (or B for every sweep of SOR), g and d
+ */
+static void
+count_direction(
+    int sweeps,
+    int n,
+    NonLinearComponent *component
+) {
+    if (NULL == component->statistics)
+        return;
+    component->statistics->sor_sweeps += sweeps;
+    component->statistics->phase_bytes[SOLVER_PHASE_DIRECTION] +=
+        (long long int)sizeof(double) * n * (n + 2) * (sweeps > 0 ? sweeps : 1);
+}
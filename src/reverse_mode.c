@@ -0,0 +1,570 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        reverse_mode.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#define _GNU_SOURCE /* sincos */
+#include "include/reverse_mode.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAPE_MIN_CAPACITY 1024
+
+static int
+grow_tape(
+    Tape *tape
+);
+
+static TapeVariable
+record_node(
+    Tape *tape,
+    int operation,
+    TapeVariable a,
+    TapeVariable b,
+    double c
+);
+
+static void
+evaluate_node(
+    Tape *tape,
+    int k
+);
+
+static double
+forward_pass(
+    const double *x,
+    int n,
+    ReverseModeObject *reverse_mode_object
+);
+
+static void
+reverse_sweep_gradient(
+    double *g,
+    int n,
+    ReverseModeObject *reverse_mode_object
+);
+
+void
+initialize_tape(
+    Tape *tape
+) {
+    tape->node = NULL;
+    tape->operation = NULL;
+    tape->constant = NULL;
+    tape->value = NULL;
+    tape->adjoint = NULL;
+    tape->num_nodes = 0;
+    tape->capacity = 0;
+    tape->failed = 0;
+}
+
+void
+release_tape(
+    Tape *tape
+) {
+    free(tape->node);
+    free(tape->operation);
+    free(tape->constant);
+    free(tape->value);
+    free(tape->adjoint);
+    initialize_tape(tape);
+}
+
+/*
+ * the arena of a tape doubled; nonzero when out of memory
+ */
+static int
+grow_tape(
+    Tape *tape
+) {
+    int capacity;
+    void *p;
+
+    capacity = tape->capacity > 0 ? 2 * tape->capacity : TAPE_MIN_CAPACITY;
+    if (NULL == (p = realloc(tape->node, sizeof(TapeNode) * capacity)))
+        return 1;
+    tape->node = (TapeNode *)p;
+    if (NULL == (p = realloc(tape->operation, sizeof(int) * capacity)))
+        return 1;
+    tape->operation = (int *)p;
+    if (NULL == (p = realloc(tape->constant, sizeof(double) * capacity)))
+        return 1;
+    tape->constant = (double *)p;
+    if (NULL == (p = realloc(tape->value, sizeof(double) * capacity)))
+        return 1;
+    tape->value = (double *)p;
+    if (NULL == (p = realloc(tape->adjoint, sizeof(double) * capacity)))
+        return 1;
+    tape->adjoint = (double *)p;
+    tape->capacity = capacity;
+    return 0;
+}
+
+/*
+ * Appends a node and evaluates it. When the arena cannot grow the tape
+ * fails and every later operation returns the variable -1.
+ */
+static TapeVariable
+record_node(
+    Tape *tape,
+    int operation,
+    TapeVariable a,
+    TapeVariable b,
+    double c
+) {
+    TapeVariable z;
+
+    z.index = -1;
+    if (tape->failed || a.index < -1 || b.index < -1)
+        return z;
+    if (tape->num_nodes == tape->capacity && 0 != grow_tape(tape)) {
+        tape->failed = 1;
+        return z;
+    }
+    z.index = tape->num_nodes++;
+    tape->node[z.index].a = a.index;
+    tape->node[z.index].b = b.index;
+    tape->operation[z.index] = operation;
+    tape->constant[z.index] = c;
+    evaluate_node(tape, z.index);
+    return z;
+}
+
+/*
+ * value of the node k and its partial derivatives, from the values of its
+ * operands; shared by recording and replaying
+ */
+static void
+evaluate_node(
+    Tape *tape,
+    int k
+) {
+    TapeNode *node = &tape->node[k];
+    double a, b, c, value;
+
+    a = node->a >= 0 ? tape->value[node->a] : 0.;
+    b = node->b >= 0 ? tape->value[node->b] : 0.;
+    c = tape->constant[k];
+    node->db = 0.;
+    switch (tape->operation[k]) {
+        case TAPE_INPUT:
+            value = tape->value[k];
+            node->da = 0.;
+            break;
+        case TAPE_CONSTANT:
+            value = c;
+            node->da = 0.;
+            break;
+        case TAPE_ADD:
+            value = a + b;
+            node->da = 1.;
+            node->db = 1.;
+            break;
+        case TAPE_SUB:
+            value = a - b;
+            node->da = 1.;
+            node->db = -1.;
+            break;
+        case TAPE_MUL:
+            value = a * b;
+            node->da = b;
+            node->db = a;
+            break;
+        case TAPE_DIV:
+            value = a / b;
+            node->da = 1. / b;
+            node->db = -value / b;
+            break;
+        case TAPE_ADD_CONSTANT:
+            value = a + c;
+            node->da = 1.;
+            break;
+        case TAPE_SCALE:
+            value = c * a;
+            node->da = c;
+            break;
+        case TAPE_SQR:
+            value = a * a;
+            node->da = 2. * a;
+            break;
+        case TAPE_SQRT:
+            value = sqrt(a);
+            node->da = .5 / value;
+            break;
+        case TAPE_POW:
+            node->da = pow(a, c - 1.);
+            value = node->da * a;
+            node->da *= c;
+            break;
+        case TAPE_EXP:
+            value = exp(a);
+            node->da = value;
+            break;
+        case TAPE_LOG:
+            value = log(a);
+            node->da = 1. / a;
+            break;
+        case TAPE_SIN:
+            sincos(a, &value, &node->da);
+            break;
+        case TAPE_COS:
+            sincos(a, &node->da, &value);
+            node->da = -node->da;
+            break;
+        case TAPE_FABS:
+            value = fabs(a);
+            node->da = a < 0. ? -1. : 1.;
+            break;
+        default:
+            value = NAN;
+            node->da = 0.;
+            break;
+    }
+    tape->value[k] = value;
+}
+
+TapeVariable
+tape_input(
+    Tape *tape,
+    double value
+) {
+    TapeVariable none = {-1}, z;
+
+    /* evaluated as a constant, replayed with the value set by the caller */
+    z = record_node(tape, TAPE_CONSTANT, none, none, value);
+    if (z.index >= 0)
+        tape->operation[z.index] = TAPE_INPUT;
+    return z;
+}
+
+TapeVariable
+tape_constant(
+    Tape *tape,
+    double c
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_CONSTANT, none, none, c);
+}
+
+double
+tape_value(
+    const Tape *tape,
+    TapeVariable a
+) {
+    return tape->failed || a.index < 0 ? NAN : tape->value[a.index];
+}
+
+TapeVariable
+tape_add(
+    Tape *tape,
+    TapeVariable a,
+    TapeVariable b
+) {
+    return record_node(tape, TAPE_ADD, a, b, 0.);
+}
+
+TapeVariable
+tape_sub(
+    Tape *tape,
+    TapeVariable a,
+    TapeVariable b
+) {
+    return record_node(tape, TAPE_SUB, a, b, 0.);
+}
+
+TapeVariable
+tape_mul(
+    Tape *tape,
+    TapeVariable a,
+    TapeVariable b
+) {
+    return record_node(tape, TAPE_MUL, a, b, 0.);
+}
+
+TapeVariable
+tape_div(
+    Tape *tape,
+    TapeVariable a,
+    TapeVariable b
+) {
+    return record_node(tape, TAPE_DIV, a, b, 0.);
+}
+
+TapeVariable
+tape_add_constant(
+    Tape *tape,
+    TapeVariable a,
+    double c
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_ADD_CONSTANT, a, none, c);
+}
+
+TapeVariable
+tape_scale(
+    Tape *tape,
+    TapeVariable a,
+    double c
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_SCALE, a, none, c);
+}
+
+TapeVariable
+tape_sqr(
+    Tape *tape,
+    TapeVariable a
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_SQR, a, none, 0.);
+}
+
+TapeVariable
+tape_sqrt(
+    Tape *tape,
+    TapeVariable a
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_SQRT, a, none, 0.);
+}
+
+TapeVariable
+tape_pow(
+    Tape *tape,
+    TapeVariable a,
+    double p
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_POW, a, none, p);
+}
+
+TapeVariable
+tape_exp(
+    Tape *tape,
+    TapeVariable a
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_EXP, a, none, 0.);
+}
+
+TapeVariable
+tape_log(
+    Tape *tape,
+    TapeVariable a
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_LOG, a, none, 0.);
+}
+
+TapeVariable
+tape_sin(
+    Tape *tape,
+    TapeVariable a
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_SIN, a, none, 0.);
+}
+
+TapeVariable
+tape_cos(
+    Tape *tape,
+    TapeVariable a
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_COS, a, none, 0.);
+}
+
+TapeVariable
+tape_fabs(
+    Tape *tape,
+    TapeVariable a
+) {
+    TapeVariable none = {-1};
+    return record_node(tape, TAPE_FABS, a, none, 0.);
+}
+
+void
+tape_reverse_sweep(
+    Tape *tape,
+    TapeVariable output
+) {
+    int k;
+    double adjoint;
+    const TapeNode *node;
+
+    if (tape->failed || output.index < 0)
+        return;
+    memset(tape->adjoint, 0, sizeof(double) * (output.index + 1));
+    tape->adjoint[output.index] = 1.;
+    for (k = output.index; k >= 0; --k) {
+        node = &tape->node[k];
+        adjoint = tape->adjoint[k];
+        if (node->a >= 0)
+            tape->adjoint[node->a] += node->da * adjoint;
+        if (node->b >= 0)
+            tape->adjoint[node->b] += node->db * adjoint;
+    }
+}
+
+void
+initialize_reverse_mode(
+    FunctionObject *function_object,
+    ReverseModeObject *reverse_mode_object
+) {
+    initialize_tape(&reverse_mode_object->tape);
+    reverse_mode_object->output.index = -1;
+    reverse_mode_object->input = NULL;
+    reverse_mode_object->x = NULL;
+    reverse_mode_object->n = 0;
+    reverse_mode_object->recorded = 0;
+    function_object->function = reverse_mode_function;
+    function_object->gradient = reverse_mode_gradient;
+    function_object->function_gradient = reverse_mode_function_gradient;
+    function_object->user = reverse_mode_object;
+}
+
+void
+release_reverse_mode(
+    ReverseModeObject *reverse_mode_object
+) {
+    release_tape(&reverse_mode_object->tape);
+    free(reverse_mode_object->input);
+    free(reverse_mode_object->x);
+    reverse_mode_object->input = NULL;
+    reverse_mode_object->x = NULL;
+    reverse_mode_object->n = 0;
+    reverse_mode_object->recorded = 0;
+}
+
+/*
+ * Leaves the tape evaluated at x: replays the recorded nodes when the
+ * control flow is static, records tape_function otherwise. The inputs are
+ * the first n nodes of the tape.
+ */
+static double
+forward_pass(
+    const double *x,
+    int n,
+    ReverseModeObject *reverse_mode_object
+) {
+    int i, k;
+    Tape *tape = &reverse_mode_object->tape;
+
+    if (n != reverse_mode_object->n) {
+        free(reverse_mode_object->input);
+        free(reverse_mode_object->x);
+        reverse_mode_object->input
+            = (TapeVariable *)malloc(sizeof(TapeVariable) * (n > 0 ? n : 1));
+        reverse_mode_object->x
+            = (double *)malloc(sizeof(double) * (n > 0 ? n : 1));
+        reverse_mode_object->recorded = 0;
+        reverse_mode_object->n = n;
+        if (NULL == reverse_mode_object->input
+                || NULL == reverse_mode_object->x) {
+            release_reverse_mode(reverse_mode_object);
+            return NAN;
+        }
+    }
+    if (reverse_mode_object->recorded
+            && reverse_mode_object->static_control) {
+        for (i = 0; i < n; ++i)
+            tape->value[i] = x[i];
+        for (k = n; k <= reverse_mode_object->output.index; ++k)
+            evaluate_node(tape, k);
+    } else {
+        tape->num_nodes = 0;
+        tape->failed = 0;
+        for (i = 0; i < n; ++i)
+            reverse_mode_object->input[i] = tape_input(tape, x[i]);
+        reverse_mode_object->output = reverse_mode_object->tape_function(
+                tape, reverse_mode_object->input, n,
+                reverse_mode_object->user);
+        if (tape->failed || reverse_mode_object->output.index < 0) {
+            reverse_mode_object->recorded = 0;
+            return NAN;
+        }
+    }
+    memcpy(reverse_mode_object->x, x, sizeof(double) * n);
+    reverse_mode_object->recorded = 1;
+    return tape_value(tape, reverse_mode_object->output);
+}
+
+double
+reverse_mode_function(
+    const double *x,
+    int n,
+    void *user
+) {
+    ReverseModeObject *reverse_mode_object = (ReverseModeObject *)user;
+
+    if (NULL != reverse_mode_object->function) {
+        return reverse_mode_object->function(
+                x, n, reverse_mode_object->user);
+    }
+    return forward_pass(x, n, reverse_mode_object);
+}
+
+/*
+ * g from one reverse sweep over the tape; NaN when the tape failed. The
+ * sweep clears the adjoints up to the output only, so the inputs after an
+ * output which is itself an input get 0 here.
+ */
+static void
+reverse_sweep_gradient(
+    double *g,
+    int n,
+    ReverseModeObject *reverse_mode_object
+) {
+    int i;
+
+    if (!reverse_mode_object->recorded) {
+        for (i = 0; i < n; ++i)
+            g[i] = NAN;
+        return;
+    }
+    tape_reverse_sweep(&reverse_mode_object->tape,
+            reverse_mode_object->output);
+    for (i = 0; i < n; ++i) {
+        g[i] = i <= reverse_mode_object->output.index
+            ? reverse_mode_object->tape.adjoint[i] : 0.;
+    }
+}
+
+void
+reverse_mode_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    ReverseModeObject *reverse_mode_object = (ReverseModeObject *)user;
+
+    /* reuse the forward pass of the last function evaluation at this x */
+    if (!reverse_mode_object->recorded || n != reverse_mode_object->n
+            || 0 != memcmp(x, reverse_mode_object->x, sizeof(double) * n)) {
+        forward_pass(x, n, reverse_mode_object);
+    }
+    reverse_sweep_gradient(g, n, reverse_mode_object);
+}
+
+double
+reverse_mode_function_gradient(
+    double *g,
+    const double *x,
+    int n,
+    void *user
+) {
+    ReverseModeObject *reverse_mode_object = (ReverseModeObject *)user;
+    double f;
+
+    f = forward_pass(x, n, reverse_mode_object);
+    reverse_sweep_gradient(g, n, reverse_mode_object);
+    return f;
+}
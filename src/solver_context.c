@@ -0,0 +1,136 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        solver_context.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/solver_context.h"
+
+#include <stdlib.h>
+
+#include "include/non_linear_component.h"
+
+/* every block of the arena starts on a cache line */
+#define SOLVER_CONTEXT_ALIGNMENT 64
+
+static long int
+aligned_size(
+    long int size
+);
+
+long int
+solver_context_size(
+    char solver,
+    int n,
+    int m
+) {
+    /*
+     * The blocks which the solvers take from the arena, in their order:
+     *  'q': x, rows of b and b (m = 0, m = 1 when the caller gives b)
+     *       and 8 vectors
+     *  'c': x and 6 vectors
+     *  't': x, rows of b and b (m = 0) or the limited memory pairs and
+     *       pivot (m > 0), and 9 vectors
+     */
+    long int size, vector, matrix;
+
+    vector = aligned_size(sizeof(double) * n);
+    matrix = aligned_size(sizeof(double *) * n)
+        + aligned_size(sizeof(double) * n * n);
+    switch (solver) {
+        case 'q':
+            size = vector + aligned_size(sizeof(double) * 8 * n);
+            if (0 == m)
+                size += matrix;
+            break;
+        case 'c':
+            size = vector + aligned_size(sizeof(double) * 6 * n);
+            break;
+        case 't':
+            size = vector + aligned_size(sizeof(double) * 9 * n);
+            if (m > 0) {
+                size += aligned_size(sizeof(double)
+                        * (2 * m * n + 3 * m * m + m))
+                    + aligned_size(sizeof(int) * m);
+            } else {
+                size += matrix;
+            }
+            break;
+        default:
+            size = 0;
+            break;
+    }
+    return size;
+}
+
+int
+initialize_solver_context(
+    SolverContext *context,
+    char solver,
+    int n,
+    int m
+) {
+    context->solver = solver;
+    context->n = n;
+    context->m = m;
+    context->offset = 0;
+    context->capacity = solver_context_size(solver, n, m);
+    context->arena = NULL;
+    if (context->capacity <= 0) {
+        context->capacity = 0;
+        return NON_LINEAR_NO_PARAMETER;
+    }
+    if (0 != posix_memalign((void **)&context->arena,
+                SOLVER_CONTEXT_ALIGNMENT, context->capacity)) {
+        context->arena = NULL;
+        context->capacity = 0;
+        return NON_LINEAR_OUT_OF_MEMORY;
+    }
+    return NON_LINEAR_SATISFIED;
+}
+
+void *
+solver_context_allocate(
+    SolverContext *context,
+    long int size
+) {
+    void *block;
+
+    size = aligned_size(size);
+    if (NULL == context->arena || context->offset + size > context->capacity)
+        return NULL;
+    block = context->arena + context->offset;
+    context->offset += size;
+    return block;
+}
+
+void
+reset_solver_context(
+    SolverContext *context
+) {
+    context->offset = 0;
+}
+
+void
+release_solver_context(
+    SolverContext *context
+) {
+    if (NULL != context->arena) {
+        free(context->arena);
+        context->arena = NULL;
+    }
+    context->capacity = 0;
+    context->offset = 0;
+}
+
+static long int
+aligned_size(
+    long int size
+) {
+    return (size + SOLVER_CONTEXT_ALIGNMENT - 1)
+        / SOLVER_CONTEXT_ALIGNMENT * SOLVER_CONTEXT_ALIGNMENT;
+}
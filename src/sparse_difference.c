@@ -0,0 +1,381 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        sparse_difference.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/sparse_difference.h"
+#include "include/finite_difference.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int
+smallest_color(
+    const int *forbidden,
+    int stamp
+);
+
+static void
+difference_steps(
+    double *h,
+    const double *x,
+    int n,
+    double relative_step
+);
+
+static int
+sorted_position(
+    const SparseMatrix *a,
+    int i,
+    int j
+);
+
+/*
+ * the smallest color c with forbidden[c] != stamp; forbidden holds one
+ * more entry than there can be colors
+ */
+static int
+smallest_color(
+    const int *forbidden,
+    int stamp
+) {
+    int c;
+    for (c = 0; forbidden[c] == stamp; ++c)
+        ;
+    return c;
+}
+
+int
+column_coloring(
+    const SparseMatrix *pattern,
+    int *color
+) {
+    int i, j, k, l, n_cols, num_colors, *col_start, *row, *forbidden;
+
+    n_cols = pattern->n_cols;
+    col_start = (int *)malloc(sizeof(int)
+            * (2 * n_cols + 2 + (pattern->nnz > 0 ? pattern->nnz : 1)));
+    if (NULL == col_start)
+        return MY_MATH_OUT_OF_MEMORY;
+    forbidden = col_start + n_cols + 1;
+    row = forbidden + n_cols + 1;
+
+    /* the rows of every column (the transpose of the pattern) */
+    memset(col_start, 0, sizeof(int) * (n_cols + 1));
+    for (k = 0; k < pattern->nnz; ++k)
+        col_start[pattern->column[k] + 1]++;
+    for (j = 0; j < n_cols; ++j)
+        col_start[j + 1] += col_start[j];
+    for (i = 0; i < pattern->n_rows; ++i) {
+        for (k = pattern->row_start[i]; k < pattern->row_start[i + 1]; ++k)
+            row[col_start[pattern->column[k]]++] = i;
+    }
+    for (j = n_cols; j > 0; --j)
+        col_start[j] = col_start[j - 1];
+    col_start[0] = 0;
+
+    for (j = 0; j <= n_cols; ++j)
+        forbidden[j] = -1;
+    num_colors = 0;
+    for (j = 0; j < n_cols; ++j) {
+        /* no two columns with an entry in the same row share a color */
+        for (k = col_start[j]; k < col_start[j + 1]; ++k) {
+            i = row[k];
+            for (l = pattern->row_start[i]; l < pattern->row_start[i + 1];
+                    ++l) {
+                if (pattern->column[l] < j)
+                    forbidden[color[pattern->column[l]]] = j;
+            }
+        }
+        color[j] = smallest_color(forbidden, j);
+        if (color[j] >= num_colors)
+            num_colors = color[j] + 1;
+    }
+    free(col_start);
+    return num_colors;
+}
+
+/*
+ * Greedy star coloring in the natural order. A vertex v may not take
+ *  - the color of a neighbor w (distance-1), nor
+ *  - the color of x in v - w - x when that closes a path on four vertices
+ *    in two colors: v has another neighbor of the color of w, or x has
+ *    another neighbor y of the color of w (v - w - x - y).
+ * Every such path has a last colored vertex, which checks it.
+ */
+int
+star_coloring(
+    const SparseMatrix *pattern,
+    int *color
+) {
+    int v, w, x, k, l, m, n, c, num_colors, hit, *forbidden, *count;
+    const int *row_start = pattern->row_start, *column = pattern->column;
+
+    n = pattern->n_rows;
+    forbidden = (int *)malloc(sizeof(int) * 2 * (n + 1));
+    if (NULL == forbidden)
+        return MY_MATH_OUT_OF_MEMORY;
+    count = forbidden + n + 1;
+    for (v = 0; v <= n; ++v) {
+        forbidden[v] = -1;
+        count[v] = 0;
+    }
+    num_colors = 0;
+    for (v = 0; v < n; ++v) {
+        for (k = row_start[v]; k < row_start[v + 1]; ++k) {
+            w = column[k];
+            if (w < v) {
+                forbidden[color[w]] = v;
+                count[color[w]]++;
+            }
+        }
+        for (k = row_start[v]; k < row_start[v + 1]; ++k) {
+            w = column[k];
+            if (w >= v)
+                continue;
+            for (l = row_start[w]; l < row_start[w + 1]; ++l) {
+                x = column[l];
+                if (x >= v || x == w || forbidden[color[x]] == v)
+                    continue;
+                hit = count[color[w]] >= 2;
+                for (m = row_start[x]; !hit && m < row_start[x + 1]; ++m) {
+                    hit = column[m] < v && column[m] != w
+                        && column[m] != x && color[column[m]] == color[w];
+                }
+                if (hit)
+                    forbidden[color[x]] = v;
+            }
+        }
+        c = smallest_color(forbidden, v);
+        for (k = row_start[v]; k < row_start[v + 1]; ++k) {
+            if (column[k] < v)
+                count[color[column[k]]] = 0;
+        }
+        color[v] = c;
+        if (c >= num_colors)
+            num_colors = c + 1;
+    }
+    free(forbidden);
+    return num_colors;
+}
+
+/*
+ * h_j = relative_step max(|x_j|, 1), rounded so that x_j + h_j - x_j is
+ * exact
+ */
+static void
+difference_steps(
+    double *h,
+    const double *x,
+    int n,
+    double relative_step
+) {
+    int j;
+    double temp;
+
+    for (j = 0; j < n; ++j) {
+        temp = x[j] + relative_step * (fabs(x[j]) > 1. ? fabs(x[j]) : 1.);
+        h[j] = temp - x[j];
+    }
+}
+
+int
+sparse_jacobian(
+    SparseMatrix *jacobian,
+    const double *x,
+    int n,
+    ResidualObject *residual_object,
+    const int *color,
+    int num_colors
+) {
+    int i, k, c, m = residual_object->m, failed = 0;
+    double *h, *r, *work;
+
+    work = (double *)malloc(sizeof(double) * (n + m * (num_colors + 1)));
+    if (NULL == work)
+        return MY_MATH_OUT_OF_MEMORY;
+    h = work;
+    r = h + n;
+    difference_steps(h, x, n, sqrt(DBL_EPSILON));
+    /* r_c = r(x + sum of h_j e_j over the columns of color c), r_num = r(x) */
+#pragma omp parallel private(c, k) reduction(||:failed) \
+        if (residual_object->thread_safe)
+    {
+        double *x_local = (double *)malloc(sizeof(double) * n);
+
+        if (NULL == x_local)
+            failed = 1;
+#pragma omp for schedule(dynamic, 1)
+        for (c = 0; c <= num_colors; ++c) {
+            if (NULL == x_local)
+                continue;
+            for (k = 0; k < n; ++k)
+                x_local[k] = c == color[k] ? x[k] + h[k] : x[k];
+            residual_object->residual(r + c * m, x_local, n, m,
+                    residual_object->user);
+        }
+        free(x_local);
+    }
+    if (failed) {
+        free(work);
+        return MY_MATH_OUT_OF_MEMORY;
+    }
+    /* J_ij from the color of column j alone (no two share a row) */
+    for (i = 0; i < m; ++i) {
+        for (k = jacobian->row_start[i]; k < jacobian->row_start[i + 1]; ++k) {
+            c = color[jacobian->column[k]];
+            jacobian->value[k] = (r[c * m + i] - r[num_colors * m + i])
+                / h[jacobian->column[k]];
+        }
+    }
+    free(work);
+    return MY_MATH_SATISFIED;
+}
+
+/*
+ * the position of the entry (i, j) of a, -1 when it is not in the
+ * pattern
+ */
+static int
+sorted_position(
+    const SparseMatrix *a,
+    int i,
+    int j
+) {
+    int lo = a->row_start[i], hi = a->row_start[i + 1] - 1, mid;
+
+    while (lo <= hi) {
+        mid = (lo + hi) / 2;
+        if (a->column[mid] == j)
+            return mid;
+        if (a->column[mid] < j)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return -1;
+}
+
+/*
+ * With d_c the sum of h_j e_j over the columns of color c,
+ * g(x + d_c) - g(x) = sum of h_j H e_j and row i of it is h_j H_ij when
+ * column j is the only column of its color in row i ("unique"). Star
+ * coloring leaves at least one of (i, j) and (j, i) unique; the entry is
+ * taken from the first of them in row order, for both triangles.
+ * Without a gradient, gf is taken by finite differences with an error of
+ * about eps^(2/3) |f|, which a forward outer difference would amplify to
+ * about eps^(1/3). The outer difference is then central instead,
+ * (g(x + d_c) - g(x - d_c)) / 2 with h_j = eps^(2/9) max(|x_j|, 1), for an
+ * error of about eps^(4/9) |f| at 2 num_colors differenced gradients.
+ */
+int
+sparse_hessian(
+    SparseMatrix *hessian,
+    const double *x,
+    int n,
+    FunctionObject *function_object,
+    const int *color,
+    int num_colors
+) {
+    int i, j, k, l, a, b, c, central, num_gradients, failed = 0;
+    int *unique, *seen;
+    double *h, *dg, *work;
+
+    central = NULL == function_object->gradient;
+    num_gradients = central ? 2 * num_colors : num_colors + 1;
+    work = (double *)malloc(sizeof(double) * (n + n * num_gradients));
+    unique = (int *)malloc(sizeof(int)
+            * (hessian->nnz + 2 * (num_colors > 0 ? num_colors : 1)));
+    if (NULL == work || NULL == unique) {
+        free(work);
+        free(unique);
+        return MY_MATH_OUT_OF_MEMORY;
+    }
+    h = work;
+    dg = h + n;
+    difference_steps(h, x, n, central
+            ? pow(DBL_EPSILON, 2. / 9.) : sqrt(DBL_EPSILON));
+#pragma omp parallel private(c, k) reduction(||:failed) \
+        if (function_object->thread_safe)
+    {
+        double *x_local = (double *)malloc(sizeof(double) * n);
+
+        if (NULL == x_local)
+            failed = 1;
+#pragma omp for schedule(dynamic, 1)
+        for (c = 0; c < num_gradients; ++c) {
+            if (NULL == x_local)
+                continue;
+            /* x + d_c, then x - d_c (central) or x (forward) */
+            for (k = 0; k < n; ++k) {
+                if (c == color[k])
+                    x_local[k] = x[k] + h[k];
+                else if (central && c - num_colors == color[k])
+                    x_local[k] = x[k] - h[k];
+                else
+                    x_local[k] = x[k];
+            }
+            if (!central) {
+                function_object->gradient(dg + c * n, x_local, n,
+                        function_object->user);
+            } else if (0 > finite_difference_gradient(dg + c * n, NULL,
+                        x_local, n, function_object)) {
+                failed = 1;
+            }
+        }
+        free(x_local);
+    }
+    if (failed) {
+        free(work);
+        free(unique);
+        return MY_MATH_OUT_OF_MEMORY;
+    }
+    for (c = 0; c < num_colors; ++c) {
+        for (i = 0; i < n; ++i) {
+            if (central) {
+                dg[c * n + i] = .5 * (dg[c * n + i]
+                        - dg[(num_colors + c) * n + i]);
+            } else {
+                dg[c * n + i] -= dg[num_colors * n + i];
+            }
+        }
+    }
+
+    /* whether column j is the only one of its color in row i */
+    seen = unique + hessian->nnz;
+    for (c = 0; c < num_colors; ++c)
+        seen[c] = seen[num_colors + c] = -1;
+    for (i = 0; i < n; ++i) {
+        for (k = hessian->row_start[i]; k < hessian->row_start[i + 1]; ++k) {
+            c = color[hessian->column[k]];
+            /* seen[c]: last row with color c, seen[num + c]: twice */
+            if (seen[c] == i)
+                seen[num_colors + c] = i;
+            seen[c] = i;
+        }
+        for (k = hessian->row_start[i]; k < hessian->row_start[i + 1]; ++k)
+            unique[k] = seen[num_colors + color[hessian->column[k]]] != i;
+    }
+    for (i = 0; i < n; ++i) {
+        for (k = hessian->row_start[i]; k < hessian->row_start[i + 1]; ++k) {
+            j = hessian->column[k];
+            a = i < j ? i : j;
+            b = i < j ? j : i;
+            l = a == i ? k : sorted_position(hessian, a, b);
+            if (l >= 0 && unique[l])
+                hessian->value[k] = dg[color[b] * n + a] / h[b];
+            else
+                hessian->value[k] = dg[color[a] * n + b] / h[a];
+        }
+    }
+    free(work);
+    free(unique);
+    return MY_MATH_SATISFIED;
+}
@@ -0,0 +1,434 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        stochastic_gradient.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/stochastic_gradient.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "include/mymath.h"
+
+static const char method_name_sgd[] = "Mini-Batch Stochastic Gradient Descent";
+static const char method_name_adam[] = "Adam";
+static const char method_name_svrg[] = "Stochastic Variance Reduced Gradient";
+
+/*
+ * accumulators of threads: local[t * n], ..., local[t * n + n - 1] belong
+ * to the thread t
+ */
+typedef struct _FiniteSumWorkspace {
+    int num_threads;
+    double *local;
+    double *f_local;
+} FiniteSumWorkspace;
+
+static void
+default_stochastic_gradient_parameter(
+    StochasticGradientParameter *parameter,
+    int num_terms
+);
+
+static unsigned int
+next_random(
+    unsigned int *state
+);
+
+static void
+shuffle_index(
+    int *index,
+    int num,
+    unsigned int *state
+);
+
+static double
+finite_sum_function(
+    const double *x,
+    int n,
+    const int *index,
+    int batch,
+    FiniteSumObject *finite_sum_object,
+    FiniteSumWorkspace *workspace
+);
+
+static int
+finite_sum_gradient(
+    double *g,
+    const double *x,
+    int n,
+    const int *index,
+    int batch,
+    FiniteSumObject *finite_sum_object,
+    FiniteSumWorkspace *workspace
+);
+
+int
+stochastic_gradient(
+    double *x,
+    int n,
+    FiniteSumObject *finite_sum_object,
+    StochasticGradientParameter *stochastic_gradient_parameter
+) {
+    int i, iter, status, storage_num, num_terms, batch, begin, t;
+    long int memory_size;
+    unsigned int state;
+    double g_norm, step, beta1_t, beta2_t, m_hat, v_hat,
+           *storage, *g, *x_snapshot, *mu, *g_snapshot, *m, *v;
+    int *index, *all;
+    const char *method_name;
+    NonLinearComponent component;
+    EvaluateObject evaluate_object;
+    StochasticGradientParameter _stochastic_gradient_parameter;
+    FiniteSumWorkspace workspace;
+
+    memory_size = sizeof(double) * n;
+    storage_num = 6;
+    storage = workspace.local = NULL;
+    index = NULL;
+    iter = 0;
+    method_name = method_name_sgd;
+    initialize_non_linear_component(
+            method_name, NULL, &evaluate_object, &component);
+    attach_observer(finite_sum_object->observer, &component);
+
+    /* make sure that f and gf of this problem exist */
+    if (NULL == finite_sum_object->function
+            || NULL == finite_sum_object->gradient
+            || finite_sum_object->num_terms <= 0) {
+        status = NON_LINEAR_NO_FUNCTION;
+        goto result;
+    }
+    num_terms = finite_sum_object->num_terms;
+
+    /* set the parameter of stochastic gradient methods */
+    if (NULL == stochastic_gradient_parameter) {
+        stochastic_gradient_parameter = &_stochastic_gradient_parameter;
+        memset(stochastic_gradient_parameter, 0,
+                sizeof(StochasticGradientParameter));
+    }
+    default_stochastic_gradient_parameter(
+            stochastic_gradient_parameter, num_terms);
+    switch (stochastic_gradient_parameter->method) {
+        case 'a':
+            method_name = method_name_adam;
+            break;
+        case 'v':
+            method_name = method_name_svrg;
+            break;
+        default:
+            break;
+    }
+    component.method_name = method_name;
+
+    /*
+     * allocate memory to storage
+     */
+#ifdef _OPENMP
+    workspace.num_threads = omp_get_max_threads();
+#else
+    workspace.num_threads = 1;
+#endif
+    /* g, x_snapshot, mu, g_snapshot, m, v and the accumulators */
+    if (NULL == (storage = (double *)malloc(memory_size * storage_num))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    if (NULL == (workspace.local = (double *)malloc(sizeof(double)
+                    * (n + 1) * workspace.num_threads))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    workspace.f_local = workspace.local + n * workspace.num_threads;
+    /* the permutation of an epoch and the identity for full passes */
+    if (NULL == (index = (int *)malloc(sizeof(int) * 2 * num_terms))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    all = index + num_terms;
+    for (i = 0; i < num_terms; ++i) {
+        index[i] = all[i] = i;
+    }
+    g = storage;
+    x_snapshot = g + n;
+    mu = x_snapshot + n;
+    g_snapshot = mu + n;
+    m = g_snapshot + n;
+    v = m + n;
+    for (i = 0; i < n; ++i) {
+        m[i] = v[i] = 0.;
+    }
+
+    /*
+     * start to compute for solving this problem
+     */
+    state = stochastic_gradient_parameter->seed;
+    batch = stochastic_gradient_parameter->batch_size;
+    beta1_t = beta2_t = 1.;
+    /* mu = gF(x) at the starting point */
+    if (NON_LINEAR_FUNCTION_OBJECT_NAN == finite_sum_gradient(mu, x, n,
+                all, num_terms, finite_sum_object, &workspace)) {
+        status = NON_LINEAR_FUNCTION_NAN;
+        goto result;
+    }
+    component.iteration_g++;
+    for (iter = 1; iter <= stochastic_gradient_parameter->upper_iter; ++iter) {
+        /* one epoch: a pass over a random permutation of the terms */
+        memcpy(x_snapshot, x, memory_size);
+        shuffle_index(index, num_terms, &state);
+        step = stochastic_gradient_parameter->step;
+        if ('s' == stochastic_gradient_parameter->method) {
+            step /= 1. + stochastic_gradient_parameter->decay * (iter - 1);
+        }
+        for (begin = 0; begin < num_terms; begin += batch) {
+            t = num_terms - begin < batch ? num_terms - begin : batch;
+            if (NON_LINEAR_FUNCTION_OBJECT_NAN == finite_sum_gradient(g, x, n,
+                        index + begin, t, finite_sum_object, &workspace)) {
+                status = NON_LINEAR_FUNCTION_NAN;
+                goto result;
+            }
+            component.iteration_g++;
+            switch (stochastic_gradient_parameter->method) {
+                case 'a':
+                    beta1_t *= stochastic_gradient_parameter->beta1;
+                    beta2_t *= stochastic_gradient_parameter->beta2;
+                    for (i = 0; i < n; ++i) {
+                        m[i] = stochastic_gradient_parameter->beta1 * m[i]
+                            + (1. - stochastic_gradient_parameter->beta1) * g[i];
+                        v[i] = stochastic_gradient_parameter->beta2 * v[i]
+                            + (1. - stochastic_gradient_parameter->beta2)
+                            * g[i] * g[i];
+                        m_hat = m[i] / (1. - beta1_t);
+                        v_hat = v[i] / (1. - beta2_t);
+                        x[i] -= step * m_hat
+                            / (sqrt(v_hat) + stochastic_gradient_parameter->epsilon);
+                    }
+                    break;
+                case 'v':
+                    /* g = gf_B(x) - gf_B(x_snapshot) + mu */
+                    if (NON_LINEAR_FUNCTION_OBJECT_NAN == finite_sum_gradient(
+                                g_snapshot, x_snapshot, n, index + begin, t,
+                                finite_sum_object, &workspace)) {
+                        status = NON_LINEAR_FUNCTION_NAN;
+                        goto result;
+                    }
+                    component.iteration_g++;
+                    for (i = 0; i < n; ++i) {
+                        x[i] -= step * (g[i] - g_snapshot[i] + mu[i]);
+                    }
+                    break;
+                default:
+                    update_step_vector(x, x, -step, g, n);
+                    break;
+            }
+        }
+        /* full pass at the end of the epoch: mu = gF(x) is the snapshot
+         * gradient of SVRG for the next epoch as well */
+        if (NON_LINEAR_FUNCTION_OBJECT_NAN == finite_sum_gradient(mu, x, n,
+                    all, num_terms, finite_sum_object, &workspace)) {
+            status = NON_LINEAR_FUNCTION_NAN;
+            goto result;
+        }
+        component.iteration_g++;
+        component.f = finite_sum_function(x, n, all, num_terms,
+                finite_sum_object, &workspace);
+        component.iteration_f++;
+        if (component.f != component.f) {
+            status = NON_LINEAR_FUNCTION_NAN;
+            goto result;
+        }
+        component.alpha = step;
+        g_norm = infinity_norm(mu, n);
+
+        if (observe_iteration(iter, g_norm, &component)) {
+            status = NON_LINEAR_STOPPED;
+            goto result;
+        }
+
+        if (g_norm < stochastic_gradient_parameter->tolerance) {
+            status = NON_LINEAR_SATISFIED;
+            goto result;
+        }
+    }
+    status = NON_LINEAR_NO_CONVERGENCE;
+result:
+    observe_result(status, iter, &component);
+
+    /* release memory of storage, accumulators and index */
+    if (NULL != storage) {
+        free(storage);
+        storage = NULL;
+    }
+    if (NULL != workspace.local) {
+        free(workspace.local);
+        workspace.local = NULL;
+    }
+    if (NULL != index) {
+        free(index);
+        index = NULL;
+    }
+
+    return status;
+}
+
+static void
+default_stochastic_gradient_parameter(
+    StochasticGradientParameter *parameter,
+    int num_terms
+) {
+    switch (parameter->method) {
+        case 'a': case 'A':
+            parameter->method = 'a';
+            break;
+        case 'v': case 'V':
+            parameter->method = 'v';
+            break;
+        default:
+            parameter->method = 's';
+            break;
+    }
+    parameter->batch_size =
+        parameter->batch_size > 0 && parameter->batch_size <= num_terms
+        ? parameter->batch_size : (num_terms < 32 ? num_terms : 32);
+    parameter->step = parameter->step > 0. ? parameter->step
+        : ('a' == parameter->method ? 1.e-3 : 1.e-2);
+    parameter->decay = parameter->decay > 0. ? parameter->decay : 0.;
+    parameter->beta1 = parameter->beta1 > 0. && parameter->beta1 < 1.
+        ? parameter->beta1 : .9;
+    parameter->beta2 = parameter->beta2 > 0. && parameter->beta2 < 1.
+        ? parameter->beta2 : .999;
+    parameter->epsilon =
+        parameter->epsilon > 0. ? parameter->epsilon : 1.e-8;
+    parameter->tolerance =
+        parameter->tolerance > lower_eps ? parameter->tolerance : lower_eps;
+    parameter->upper_iter = parameter->upper_iter > lower_iteration
+        && parameter->upper_iter < upper_iteration
+        ? parameter->upper_iter : upper_iteration;
+    parameter->seed = parameter->seed ? parameter->seed : 2463534242u;
+}
+
+static unsigned int
+next_random(
+    unsigned int *state
+) {
+    /* xorshift32 */
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void
+shuffle_index(
+    int *index,
+    int num,
+    unsigned int *state
+) {
+    /* Fisher-Yates */
+    int i, j, temp;
+    for (i = num - 1; i > 0; --i) {
+        j = (int)(next_random(state) % (unsigned int)(i + 1));
+        temp = index[i];
+        index[i] = index[j];
+        index[j] = temp;
+    }
+}
+
+static double
+finite_sum_function(
+    const double *x,
+    int n,
+    const int *index,
+    int batch,
+    FiniteSumObject *finite_sum_object,
+    FiniteSumWorkspace *workspace
+) {
+    int t;
+    double f;
+
+    for (t = 0; t < workspace->num_threads; ++t) {
+        workspace->f_local[t] = 0.;
+    }
+#pragma omp parallel num_threads(workspace->num_threads)
+    {
+        int id, num, lo, hi;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+        num = omp_get_num_threads();
+#else
+        id = 0;
+        num = 1;
+#endif
+        lo = (int)((long int)batch * id / num);
+        hi = (int)((long int)batch * (id + 1) / num);
+        workspace->f_local[id] = hi > lo ? finite_sum_object->function(
+                x, n, index + lo, hi - lo, finite_sum_object->user) : 0.;
+    }
+    for (t = 0, f = 0.; t < workspace->num_threads; ++t) {
+        f += workspace->f_local[t];
+    }
+    return f / batch;
+}
+
+static int
+finite_sum_gradient(
+    double *g,
+    const double *x,
+    int n,
+    const int *index,
+    int batch,
+    FiniteSumObject *finite_sum_object,
+    FiniteSumWorkspace *workspace
+) {
+    /*
+     * Each thread evaluates the gradient of a slice of the batch into its
+     * own accumulator, and the accumulators are reduced into g in parallel
+     * over the coordinates.
+     */
+    int i, status;
+
+    status = NON_LINEAR_FUNCTION_OBJECT_SATISFIED;
+#pragma omp parallel num_threads(workspace->num_threads) private(i)
+    {
+        int id, num, lo, hi, t;
+        double sum, *local;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+        num = omp_get_num_threads();
+#else
+        id = 0;
+        num = 1;
+#endif
+        local = workspace->local + id * n;
+        lo = (int)((long int)batch * id / num);
+        hi = (int)((long int)batch * (id + 1) / num);
+        if (hi > lo) {
+            finite_sum_object->gradient(local, x, n, index + lo, hi - lo,
+                    finite_sum_object->user);
+        } else {
+            for (i = 0; i < n; ++i)
+                local[i] = 0.;
+        }
+#pragma omp barrier
+#pragma omp for reduction(min:status)
+        for (i = 0; i < n; ++i) {
+            for (t = 0, sum = 0.; t < num; ++t) {
+                sum += workspace->local[t * n + i];
+            }
+            g[i] = sum / batch;
+            if (g[i] != g[i])
+                status = NON_LINEAR_FUNCTION_OBJECT_NAN;
+        }
+    }
+    return status;
+}
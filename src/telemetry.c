@@ -0,0 +1,174 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        telemetry.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/telemetry.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static long long int
+nanosecond_clock(
+    void
+);
+
+int
+initialize_telemetry_buffer(
+    TelemetryBuffer *buffer,
+    long int capacity
+) {
+    unsigned long long size = 1;
+
+    while (size < (unsigned long long)capacity)
+        size <<= 1;
+    buffer->event = (TelemetryEvent *)malloc(sizeof(TelemetryEvent) * size);
+    if (NULL == buffer->event) {
+        buffer->capacity = 0;
+        return -1;
+    }
+    buffer->capacity = size;
+    reset_telemetry_buffer(buffer);
+    return 0;
+}
+
+void
+reset_telemetry_buffer(
+    TelemetryBuffer *buffer
+) {
+    __atomic_store_n(&buffer->head, 0, __ATOMIC_RELEASE);
+    buffer->tick_origin = telemetry_timestamp();
+    buffer->nanosecond_origin = nanosecond_clock();
+}
+
+void
+release_telemetry_buffer(
+    TelemetryBuffer *buffer
+) {
+    free(buffer->event);
+    buffer->event = NULL;
+    buffer->capacity = 0;
+}
+
+unsigned long long
+telemetry_timestamp(
+    void
+) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (unsigned long long)nanosecond_clock();
+#endif
+}
+
+/*
+ * Only the solver writes, so the slot is filled with plain stores and the
+ * new head is published with a release store.
+ */
+void
+record_telemetry_event(
+    TelemetryBuffer *buffer,
+    int type,
+    int iteration,
+    double value0,
+    double value1
+) {
+    unsigned long long head;
+    TelemetryEvent *event;
+
+    head = __atomic_load_n(&buffer->head, __ATOMIC_RELAXED);
+    event = &buffer->event[head & (buffer->capacity - 1)];
+    event->timestamp = telemetry_timestamp();
+    event->type = type;
+    event->iteration = iteration;
+    event->value[0] = value0;
+    event->value[1] = value1;
+    __atomic_store_n(&buffer->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Copies up to num of the latest events, oldest first, and returns the
+ * number of events copied. Events which the writer may have overwritten
+ * during the copy are dropped, and so is the slot it may be filling, so
+ * that a wrapped buffer gives at most capacity - 1 events.
+ */
+long int
+read_telemetry_events(
+    const TelemetryBuffer *buffer,
+    TelemetryEvent *event,
+    long int num
+) {
+    unsigned long long head, tail, after, k;
+
+    head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+    tail = head > buffer->capacity ? head - buffer->capacity : 0;
+    if (head - tail > (unsigned long long)num)
+        tail = head - num;
+    for (k = tail; k < head; ++k)
+        event[k - tail] = buffer->event[k & (buffer->capacity - 1)];
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    after = __atomic_load_n(&buffer->head, __ATOMIC_RELAXED);
+    /* the writer may be filling the slot of after, that of after - capacity */
+    if (after + 1 > tail + buffer->capacity) {
+        k = after + 1 - buffer->capacity - tail;
+        if (k >= head - tail)
+            return 0;
+        memmove(event, event + k, sizeof(TelemetryEvent) * (head - tail - k));
+        tail += k;
+    }
+    return (long int)(head - tail);
+}
+
+int
+dump_telemetry_buffer(
+    const TelemetryBuffer *buffer,
+    FILE *stream
+) {
+    TelemetryHeader header;
+    TelemetryEvent *event;
+    unsigned long long head, ticks;
+    long long int nanoseconds;
+    long int num;
+
+    event = (TelemetryEvent *)malloc(sizeof(TelemetryEvent)
+            * (buffer->capacity > 0 ? buffer->capacity : 1));
+    if (NULL == event)
+        return -1;
+    head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+    num = read_telemetry_events(buffer, event, (long int)buffer->capacity);
+    ticks = telemetry_timestamp() - buffer->tick_origin;
+    nanoseconds = nanosecond_clock() - buffer->nanosecond_origin;
+
+    memcpy(header.magic, TELEMETRY_MAGIC, sizeof(header.magic));
+    header.num_events = (unsigned long long)num;
+    header.num_lost = head > (unsigned long long)num ? head - num : 0;
+    header.ticks_per_second = nanoseconds > 0
+        ? (double)ticks * 1.e9 / (double)nanoseconds : 1.e9;
+    if (1 != fwrite(&header, sizeof(header), 1, stream)
+            || (size_t)num != fwrite(event, sizeof(TelemetryEvent),
+                (size_t)num, stream)) {
+        free(event);
+        return -1;
+    }
+    free(event);
+    return 0;
+}
+
+static long long int
+nanosecond_clock(
+    void
+) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long int)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
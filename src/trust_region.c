@@ -0,0 +1,626 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        trust_region.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+#include "include/trust_region.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/mymath.h"
+#include "include/solver_context.h"
+
+static const char method_name[] = "Trust Region SR1";
+
+/*
+ * The model of the Hessian.
+ *  dense:          B
+ *  limited memory: B = gamma * I + Psi * M^-1 * Psi^T
+ *                  Psi = Y - gamma * S
+ *                  M   = D + L + L^T - gamma * S^T S
+ */
+typedef struct _TrustRegionModel {
+    char formula;
+    int n;
+    double **b;
+    int memory;
+    int k;
+    double gamma;
+    double *s_list;
+    double *y_list;
+    double *sy;
+    double *ss;
+    double *lu;
+    double *work;
+    int *pivot;
+} TrustRegionModel;
+
+static void
+default_trust_region_parameter(
+    TrustRegionParameter *parameter
+);
+
+static void
+hessian_vector_product(
+    double *Bv,
+    const double *v,
+    TrustRegionModel *model
+);
+
+static int
+update_model(
+    TrustRegionModel *model,
+    const double *s,
+    const double *y,
+    double *v
+);
+
+static int
+append_limited_memory_pair(
+    TrustRegionModel *model,
+    const double *s,
+    const double *y
+);
+
+static int
+factorize_compact_matrix(
+    TrustRegionModel *model
+);
+
+static void
+steihaug_conjugate_gradient(
+    double *p,
+    const double *g,
+    double radius,
+    TrustRegionModel *model,
+    double *work
+);
+
+static double
+boundary_step(
+    const double *z,
+    const double *d,
+    double radius,
+    int n
+);
+
+int
+trust_region(
+    double *x,
+    double **b,
+    int n,
+    FunctionObject *function_object,
+    TrustRegionParameter *trust_region_parameter
+) {
+    int status;
+    SolverContext context;
+    TrustRegionParameter _trust_region_parameter;
+
+    /* the defaults are needed here to size the context */
+    if (NULL == trust_region_parameter) {
+        trust_region_parameter = &_trust_region_parameter;
+        memset(trust_region_parameter, 0, sizeof(TrustRegionParameter));
+    }
+    default_trust_region_parameter(trust_region_parameter);
+    status = initialize_solver_context(&context, 't', n,
+            'l' == trust_region_parameter->formula
+            ? trust_region_parameter->memory : 0);
+    if (NON_LINEAR_SATISFIED == status) {
+        status = trust_region_with_context(&context, x, b, n,
+                function_object, trust_region_parameter);
+    }
+    release_solver_context(&context);
+    return status;
+}
+
+int
+trust_region_with_context(
+    SolverContext *context,
+    double *x,
+    double **b,
+    int n,
+    FunctionObject *function_object,
+    TrustRegionParameter *trust_region_parameter
+) {
+    int i, j, iter, status, storage_num, memory;
+    long int memory_size;
+    double g_norm, f, f_temp, radius, ared, pred, rho, p_norm,
+           *storage, *storage_lm,
+           *g, *x_temp, *g_temp, *p, *y, *Bp, *work;
+    int *storage_pivot;
+    NonLinearComponent component;
+    PhaseTimer timer;
+    long long int model_bytes;
+    TrustRegionModel model;
+    TrustRegionParameter _trust_region_parameter;
+    EvaluateObject evaluate_object;
+
+    memory_size = sizeof(double) * n;
+    storage_num = 9;
+    storage_lm = NULL;
+    storage_pivot = NULL;
+    iter = 0;
+    /* set the component of Non-Linear Programming */
+    initialize_non_linear_component(
+            method_name, function_object, &evaluate_object, &component);
+
+    /* set the parameter of Trust Region method */
+    if (NULL == trust_region_parameter) {
+        trust_region_parameter = &_trust_region_parameter;
+        memset(trust_region_parameter, 0, sizeof(TrustRegionParameter));
+    }
+    default_trust_region_parameter(trust_region_parameter);
+    memory = trust_region_parameter->memory;
+
+    /*
+     * take memory of storage from the arena of the context
+     */
+    reset_solver_context(context);
+    if (NULL == x) {
+        if (NULL == (x = (double *)solver_context_allocate(
+                        context, memory_size))) {
+            status = NON_LINEAR_OUT_OF_MEMORY;
+            goto result;
+        }
+        for (i = 0; i < n; ++i) {
+            x[i] = 0.;
+        }
+    }
+    if ('l' == trust_region_parameter->formula) {
+        /* S, Y, S^T Y, S^T S, LU factors of M and work */
+        if (NULL == (storage_lm = (double *)solver_context_allocate(context,
+                        sizeof(double)
+                        * (2 * memory * n + 3 * memory * memory + memory)))) {
+            status = NON_LINEAR_OUT_OF_MEMORY;
+            goto result;
+        }
+        if (NULL == (storage_pivot = (int *)solver_context_allocate(
+                        context, sizeof(int) * memory))) {
+            status = NON_LINEAR_OUT_OF_MEMORY;
+            goto result;
+        }
+        b = NULL;
+    } else if (NULL == b) {
+        if (NULL == (b = (double **)solver_context_allocate(
+                        context, sizeof(double *) * n))) {
+            status = NON_LINEAR_OUT_OF_MEMORY;
+            goto result;
+        }
+        if (NULL == (*b = (double *)solver_context_allocate(
+                        context, memory_size * n))) {
+            status = NON_LINEAR_OUT_OF_MEMORY;
+            goto result;
+        }
+        for (i = 1; i < n; ++i) {
+            b[i] = b[i - 1] + n;
+        }
+        for (i = 0; i < n; ++i) {
+            for (j = 0; j < n; ++j) {
+                b[i][j] = 0.;
+            }
+            b[i][i] = 1.;
+        }
+    }
+    /* storage for g, x_temp, g_temp, p, y, Bp and work (3 vectors for the
+     * Steihaug-CG) */
+    if (NULL == (storage = (double *)solver_context_allocate(
+                    context, memory_size * storage_num))) {
+        status = NON_LINEAR_OUT_OF_MEMORY;
+        goto result;
+    }
+    g = storage;
+    x_temp = g + n;
+    g_temp = x_temp + n;
+    p = g_temp + n;
+    y = p + n;
+    Bp = y + n;
+    work = Bp + n;
+
+    /* set the model of the Hessian */
+    model.formula = trust_region_parameter->formula;
+    model.n = n;
+    model.b = b;
+    model.memory = memory;
+    model.k = 0;
+    model.gamma = 1.;
+    if (NULL != storage_lm) {
+        model.s_list = storage_lm;
+        model.y_list = model.s_list + memory * n;
+        model.sy = model.y_list + memory * n;
+        model.ss = model.sy + memory * memory;
+        model.lu = model.ss + memory * memory;
+        model.work = model.lu + memory * memory;
+        model.pivot = storage_pivot;
+    }
+
+    /* make sure that f of this problem exists (gf may be differenced) */
+    if (NULL == function_object->function) {
+        status = NON_LINEAR_NO_FUNCTION;
+        goto result;
+    }
+
+    /*
+     * start to compute for solving this problem
+     */
+    if (NON_LINEAR_FUNCTION_OBJECT_NAN
+            == evaluate_object.function_gradient(g, x, n, &component)) {
+        status = NON_LINEAR_FUNCTION_NAN;
+        goto result;
+    }
+    f = component.f;
+    radius = trust_region_parameter->initial_radius;
+    /* a pass over B or over S and Y of the compact form */
+    model_bytes = (long long int)sizeof(double)
+        * (NULL != storage_lm ? 2 * memory * n : n * n);
+    for (iter = 1; iter <= trust_region_parameter->upper_iter; ++iter) {
+        /* solve the subproblem of trust region approximately */
+        start_phase(&timer, &component);
+        steihaug_conjugate_gradient(p, g, radius, &model, work);
+        hessian_vector_product(Bp, p, &model);
+        stop_phase(&timer, SOLVER_PHASE_DIRECTION, 2 * model_bytes,
+                &component);
+        pred = -(dot_product(g, p, n) + .5 * dot_product(p, Bp, n));
+        /* update x_temp = x + p and g_temp = gradient(x_temp) */
+        for (i = 0; i < n; ++i) {
+            x_temp[i] = x[i] + p[i];
+        }
+        if (NON_LINEAR_FUNCTION_OBJECT_NAN
+                == evaluate_object.function_gradient(
+                    g_temp, x_temp, n, &component)) {
+            status = NON_LINEAR_FUNCTION_NAN;
+            goto result;
+        }
+        f_temp = component.f;
+        ared = f - f_temp;
+        rho = pred > 0. ? ared / pred : -1.;
+
+        /* update the model with s = p and y = g_temp - g even if the step
+         * is rejected: SR1 learns from every trial */
+        for (i = 0; i < n; ++i) {
+            y[i] = g_temp[i] - g[i];
+        }
+        start_phase(&timer, &component);
+        status = update_model(&model, p, y, Bp);
+        stop_phase(&timer, SOLVER_PHASE_UPDATE, 2 * model_bytes, &component);
+        if (NON_LINEAR_FUNCTION_NAN == status) {
+            goto result;
+        } else if (NON_LINEAR_NOT_UPDATE == status) {
+            observe_update_skipped(&component);
+        }
+
+        /* accept or reject the step */
+        if (rho > trust_region_parameter->eta) {
+            memcpy(x, x_temp, memory_size);
+            memcpy(g, g_temp, memory_size);
+            f = f_temp;
+        }
+        /* update the radius of trust region */
+        p_norm = euclidean_norm(p, n);
+        if (rho > .75) {
+            if (p_norm > .8 * radius) {
+                radius = 2. * radius < trust_region_parameter->max_radius
+                    ? 2. * radius : trust_region_parameter->max_radius;
+            }
+        } else if (rho < .1) {
+            radius *= .5;
+        }
+
+        component.f = f;
+        component.alpha = radius;
+        g_norm = infinity_norm(g, n);
+
+        if (observe_iteration(iter, g_norm, &component)) {
+            status = NON_LINEAR_STOPPED;
+            goto result;
+        }
+
+        if (g_norm < trust_region_parameter->tolerance) {
+            status = NON_LINEAR_SATISFIED;
+            goto result;
+        }
+        if (radius < lower_eps * lower_eps) {
+            status = NON_LINEAR_FAILED;
+            goto result;
+        }
+    }
+    status = NON_LINEAR_NO_CONVERGENCE;
+result:
+    observe_result(status, iter, &component);
+
+    return status;
+}
+
+static void
+default_trust_region_parameter(
+    TrustRegionParameter *parameter
+) {
+    parameter->formula =
+        'l' == parameter->formula || 'L' == parameter->formula ? 'l' : 's';
+    parameter->memory = parameter->memory > 0 ? parameter->memory : 5;
+    parameter->tolerance =
+        parameter->tolerance > lower_eps ? parameter->tolerance : lower_eps;
+    parameter->upper_iter = parameter->upper_iter > lower_iteration
+        && parameter->upper_iter < upper_iteration
+        ? parameter->upper_iter : upper_iteration;
+    parameter->initial_radius =
+        parameter->initial_radius > 0. ? parameter->initial_radius : 1.;
+    parameter->max_radius =
+        parameter->max_radius > parameter->initial_radius
+        ? parameter->max_radius : 1.e+3 * parameter->initial_radius;
+    parameter->eta = parameter->eta > 0. && parameter->eta < .25
+        ? parameter->eta : 1.e-4;
+}
+
+static void
+hessian_vector_product(
+    double *Bv,
+    const double *v,
+    TrustRegionModel *model
+) {
+    int i, j, k, n;
+    double sum, *w, *s_j, *y_j;
+
+    n = model->n;
+    if ('l' != model->formula) {
+        for (i = 0; i < n; ++i) {
+            for (j = 0, sum = 0.; j < n; ++j) {
+                sum += model->b[i][j] * v[j];
+            }
+            Bv[i] = sum;
+        }
+        return;
+    }
+    /* Bv = gamma * v + Psi * M^-1 * Psi^T * v */
+    k = model->k;
+    w = model->work;
+    for (j = 0; j < k; ++j) {
+        s_j = model->s_list + j * n;
+        y_j = model->y_list + j * n;
+        w[j] = dot_product(y_j, v, n) - model->gamma * dot_product(s_j, v, n);
+    }
+    /* solve M * w = Psi^T * v with the LU factors */
+    for (i = 0; i < k; ++i) {
+        sum = w[model->pivot[i]];
+        w[model->pivot[i]] = w[i];
+        w[i] = sum;
+        for (j = 0; j < i; ++j) {
+            w[i] -= model->lu[i * model->memory + j] * w[j];
+        }
+    }
+    for (i = k - 1; i >= 0; --i) {
+        for (j = i + 1; j < k; ++j) {
+            w[i] -= model->lu[i * model->memory + j] * w[j];
+        }
+        w[i] /= model->lu[i * model->memory + i];
+    }
+    for (i = 0; i < n; ++i) {
+        Bv[i] = model->gamma * v[i];
+    }
+    for (j = 0; j < k; ++j) {
+        s_j = model->s_list + j * n;
+        y_j = model->y_list + j * n;
+        for (i = 0; i < n; ++i) {
+            Bv[i] += w[j] * (y_j[i] - model->gamma * s_j[i]);
+        }
+    }
+}
+
+static int
+update_model(
+    TrustRegionModel *model,
+    const double *s,
+    const double *y,
+    double *v
+) {
+    /*
+     * B = B + (y - Bs)(y - Bs)^T / (y - Bs)^T s
+     *
+     * The update is skipped if |s^T (y - Bs)| < r * ||s|| * ||y - Bs||.
+     */
+    int i, j, n;
+    double vs, sy;
+
+    n = model->n;
+    if ('l' == model->formula && 0 == model->k) {
+        /* scale B0 = gamma * I with the first pair */
+        sy = dot_product(s, y, n);
+        if (sy > 0.)
+            model->gamma = dot_product(y, y, n) / sy;
+    }
+    hessian_vector_product(v, s, model);
+    for (i = 0; i < n; ++i) {
+        v[i] = y[i] - v[i];
+    }
+    vs = dot_product(v, s, n);
+    if (vs != vs)
+        return NON_LINEAR_FUNCTION_NAN;
+    if (fabs(vs) < sr1_skipping_ratio * euclidean_norm(s, n)
+            * euclidean_norm(v, n) || 0. == vs)
+        return NON_LINEAR_NOT_UPDATE;
+    if ('l' == model->formula)
+        return append_limited_memory_pair(model, s, y);
+    for (i = 0; i < n; ++i) {
+        for (j = 0; j < n; ++j) {
+            model->b[i][j] += v[i] * v[j] / vs;
+        }
+    }
+    return NON_LINEAR_SATISFIED;
+}
+
+static int
+append_limited_memory_pair(
+    TrustRegionModel *model,
+    const double *s,
+    const double *y
+) {
+    int i, j, k, n, m;
+    long int memory_size;
+
+    n = model->n;
+    m = model->memory;
+    memory_size = sizeof(double) * n;
+    /* discard the oldest pair if the memory is full */
+    if (model->k == m) {
+        memmove(model->s_list, model->s_list + n, memory_size * (m - 1));
+        memmove(model->y_list, model->y_list + n, memory_size * (m - 1));
+        for (i = 1; i < m; ++i) {
+            for (j = 1; j <= i; ++j) {
+                model->sy[(i - 1) * m + j - 1] = model->sy[i * m + j];
+                model->ss[(i - 1) * m + j - 1] = model->ss[i * m + j];
+            }
+        }
+        model->k--;
+    }
+    k = model->k;
+    memcpy(model->s_list + k * n, s, memory_size);
+    memcpy(model->y_list + k * n, y, memory_size);
+    /* only the lower triangles of S^T Y and S^T S are required */
+    for (j = 0; j <= k; ++j) {
+        model->sy[k * m + j] = dot_product(s, model->y_list + j * n, n);
+        model->ss[k * m + j] = dot_product(s, model->s_list + j * n, n);
+    }
+    model->k++;
+    if (MY_MATH_SATISFIED != factorize_compact_matrix(model)) {
+        /* M is singular: forget the new pair */
+        model->k--;
+        factorize_compact_matrix(model);
+        return NON_LINEAR_NOT_UPDATE;
+    }
+    return NON_LINEAR_SATISFIED;
+}
+
+static int
+factorize_compact_matrix(
+    TrustRegionModel *model
+) {
+    /*
+     * LU factorization with partial pivoting of
+     *  M = D + L + L^T - gamma * S^T S
+     */
+    int i, j, l, k, m, p;
+    double max, temp, *lu;
+
+    k = model->k;
+    m = model->memory;
+    lu = model->lu;
+    for (i = 0; i < k; ++i) {
+        for (j = 0; j <= i; ++j) {
+            lu[i * m + j] = lu[j * m + i]
+                = model->sy[i * m + j] - model->gamma * model->ss[i * m + j];
+        }
+    }
+    for (l = 0; l < k; ++l) {
+        for (i = l + 1, p = l, max = fabs(lu[l * m + l]); i < k; ++i) {
+            if (fabs(lu[i * m + l]) > max) {
+                max = fabs(lu[i * m + l]);
+                p = i;
+            }
+        }
+        model->pivot[l] = p;
+        if (max <= lower_eps * lower_eps)
+            return MY_MATH_FAILED;
+        if (p != l) {
+            for (j = 0; j < k; ++j) {
+                temp = lu[l * m + j];
+                lu[l * m + j] = lu[p * m + j];
+                lu[p * m + j] = temp;
+            }
+        }
+        for (i = l + 1; i < k; ++i) {
+            lu[i * m + l] /= lu[l * m + l];
+            for (j = l + 1; j < k; ++j) {
+                lu[i * m + j] -= lu[i * m + l] * lu[l * m + j];
+            }
+        }
+    }
+    return MY_MATH_SATISFIED;
+}
+
+static void
+steihaug_conjugate_gradient(
+    double *p,
+    const double *g,
+    double radius,
+    TrustRegionModel *model,
+    double *work
+) {
+    /*
+     * Steihaug-Toint truncated CG for
+     *  minimize g^T p + p^T B p / 2 subject to ||p|| <= radius
+     * The iteration stops at the boundary or on a direction of negative
+     * curvature, which is how the indefinite SR1 matrix is exploited.
+     */
+    int i, j, n;
+    double epsilon, alpha, beta, tau, rr, rr_new, dBd, pp, pd, dd,
+           *r, *d, *Bd;
+
+    n = model->n;
+    r = work;
+    d = r + n;
+    Bd = d + n;
+    for (i = 0; i < n; ++i) {
+        p[i] = 0.;
+        r[i] = g[i];
+        d[i] = -g[i];
+    }
+    rr = dot_product(r, r, n);
+    epsilon = sqrt(sqrt(rr)) < .5 ? sqrt(sqrt(rr)) : .5;
+    epsilon *= sqrt(rr);
+    if (0. == rr)
+        return;
+    for (j = 0, pp = 0.; j < n; ++j) {
+        hessian_vector_product(Bd, d, model);
+        dBd = dot_product(d, Bd, n);
+        if (dBd <= 0.) {
+            tau = boundary_step(p, d, radius, n);
+            update_step_vector(p, p, tau, d, n);
+            return;
+        }
+        alpha = rr / dBd;
+        /* ||p + alpha * d||^2 without forming the vector */
+        pd = dot_product(p, d, n);
+        dd = dot_product(d, d, n);
+        if (pp + 2. * alpha * pd + alpha * alpha * dd >= radius * radius) {
+            tau = boundary_step(p, d, radius, n);
+            update_step_vector(p, p, tau, d, n);
+            return;
+        }
+        update_step_vector(p, p, alpha, d, n);
+        update_step_vector(r, r, alpha, Bd, n);
+        pp = dot_product(p, p, n);
+        rr_new = dot_product(r, r, n);
+        if (sqrt(rr_new) < epsilon)
+            return;
+        beta = rr_new / rr;
+        rr = rr_new;
+        for (i = 0; i < n; ++i) {
+            d[i] = -r[i] + beta * d[i];
+        }
+    }
+}
+
+static double
+boundary_step(
+    const double *z,
+    const double *d,
+    double radius,
+    int n
+) {
+    /*
+     * tau >= 0 such that ||z + tau * d|| = radius
+     */
+    double a, b, c;
+
+    a = dot_product(d, d, n);
+    b = 2. * dot_product(z, d, n);
+    c = dot_product(z, z, n) - radius * radius;
+    return (-b + sqrt(b * b - 4. * a * c)) / (2. * a);
+}
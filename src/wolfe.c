@@ -50,6 +50,8 @@ wolfe(
         if (NON_LINEAR_FUNCTION_OBJECT_NAN
                 == evaluate_object->function(x_temp, n, component))
             return LINE_SEARCH_FUNCTION_NAN;
+        observe_event(TELEMETRY_LINE_SEARCH_TRIAL, beta, component->f,
+                component);
         if (component->f <= f_x + parameter->xi * beta * gd) {
             if (NON_LINEAR_FUNCTION_OBJECT_NAN
                     == evaluate_object->gradient(g_temp, x_temp, n, component))
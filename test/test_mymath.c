@@ -3,6 +3,7 @@
 
 #include "../src/include/mymath.h"
 
+#include <math.h>
 #include <stdlib.h>
 
 static int n;
@@ -190,6 +191,989 @@ test_successive_over_relaxation(void) {
     free(expect);
 }
 
+/*
+ * a = tridiag(-1, 4, -1), symmetric positive definite, and y = a expect
+ * with expect[i] = i
+ */
+static void
+set_spd_system(
+    double *expect
+) {
+    int i, j;
+
+    for (i = 0; i < n; ++i) {
+        for (j = 0; j < n; ++j) {
+            a[i][j] = i == j ? 4. : i == j + 1 || j == i + 1 ? -1. : 0.;
+        }
+        expect[i] = i * 1.;
+    }
+    for (i = 0; i < n; ++i) {
+        for (j = 0, y[i] = 0.; j < n; ++j) {
+            y[i] += a[i][j] * expect[j];
+        }
+    }
+}
+
+/*
+ * the nonzero entries of a in CSR
+ */
+static void
+set_sparse_matrix(
+    SparseMatrix *s
+) {
+    int i, j, k;
+
+    for (i = 0, k = 0; i < n; ++i) {
+        for (j = 0; j < n; ++j) {
+            if (0. != a[i][j]) {
+                s->column[k] = j;
+                s->value[k++] = a[i][j];
+            }
+        }
+        s->row_start[i + 1] = k;
+    }
+    s->nnz = k;
+}
+
+void
+test_sparse_matrix_vector(void) {
+    /* void
+     * sparse_matrix_vector(
+     *     double *y,
+     *     const SparseMatrix *a,
+     *     const double *x
+     * ); */
+    int i;
+    double *expect;
+    SparseMatrix s;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, allocate_sparse_matrix(&s, n, n, 3 * n));
+    set_sparse_matrix(&s);
+    CU_ASSERT_EQUAL(3 * n - 2, s.nnz);
+    sparse_matrix_vector(x, &s, expect);
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_EQUAL(y[i], x[i]);
+    }
+    release_sparse_matrix(&s);
+    free(expect);
+}
+
+void
+test_sparse_sor_forward_sweep(void) {
+    /* int
+     * sparse_sor_forward_sweep(
+     *     const SparseMatrix *a,
+     *     double *x,
+     *     const double *b,
+     *     double omega,
+     *     double *change
+     * ); */
+    int i, k;
+    double change, *expect;
+    SparseMatrix s;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    allocate_sparse_matrix(&s, n, n, 3 * n);
+    set_sparse_matrix(&s);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    /* the first row of the first sweep from 0 is y[0] / a[0][0] */
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            sparse_sor_forward_sweep(&s, x, y, 1., &change));
+    CU_ASSERT_EQUAL(y[0] / 4., x[0]);
+    for (k = 0; k < 100 && change > 1.e-10; ++k) {
+        sparse_sor_forward_sweep(&s, x, y, 1., &change);
+    }
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    /* Not a Number in x */
+    x[n / 2] = NAN;
+    CU_ASSERT_EQUAL(MY_MATH_FUNCTION_NAN,
+            sparse_sor_forward_sweep(&s, x, y, 1., &change));
+    CU_ASSERT(change != change);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    /* a zero diagonal entry */
+    s.value[s.row_start[n / 2] + 1] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED,
+            sparse_sor_forward_sweep(&s, x, y, 1., &change));
+    release_sparse_matrix(&s);
+    free(expect);
+}
+
+void
+test_sparse_sor_backward_sweep(void) {
+    /* int
+     * sparse_sor_backward_sweep(
+     *     const SparseMatrix *a,
+     *     double *x,
+     *     const double *b,
+     *     double omega,
+     *     double *change
+     * ); */
+    int i, k;
+    double change, *expect;
+    SparseMatrix s;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    allocate_sparse_matrix(&s, n, n, 3 * n);
+    set_sparse_matrix(&s);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    /* the last row comes first */
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            sparse_sor_backward_sweep(&s, x, y, 1., &change));
+    CU_ASSERT_EQUAL(y[n - 1] / 4., x[n - 1]);
+    for (k = 0; k < 100 && change > 1.e-10; ++k) {
+        sparse_sor_backward_sweep(&s, x, y, 1., &change);
+    }
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    x[n / 2] = NAN;
+    CU_ASSERT_EQUAL(MY_MATH_FUNCTION_NAN,
+            sparse_sor_backward_sweep(&s, x, y, 1., &change));
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    s.value[s.row_start[n / 2] + 1] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED,
+            sparse_sor_backward_sweep(&s, x, y, 1., &change));
+    release_sparse_matrix(&s);
+    free(expect);
+}
+
+void
+test_sparse_gauss_seidel(void) {
+    /* int
+     * sparse_gauss_seidel(
+     *     const SparseMatrix *a,
+     *     double *x,
+     *     const double *b,
+     *     double epsilon,
+     *     int *sweeps
+     * ); */
+    int i, sweeps;
+    double *expect;
+    SparseMatrix s;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    allocate_sparse_matrix(&s, n, n, 3 * n);
+    set_sparse_matrix(&s);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            sparse_gauss_seidel(&s, x, y, 1.e-10, &sweeps));
+    CU_ASSERT(0 < sweeps);
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = NAN;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_FUNCTION_NAN,
+            sparse_gauss_seidel(&s, x, y, 1.e-10, &sweeps));
+    CU_ASSERT_EQUAL(1, sweeps);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    s.value[s.row_start[n / 2] + 1] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED,
+            sparse_gauss_seidel(&s, x, y, 1.e-10, &sweeps));
+    release_sparse_matrix(&s);
+    free(expect);
+}
+
+void
+test_sparse_successive_over_relaxation(void) {
+    /* int
+     * sparse_successive_over_relaxation(
+     *     const SparseMatrix *a,
+     *     double *x,
+     *     const double *b,
+     *     double epsilon,
+     *     double omega,
+     *     int *sweeps
+     * ); */
+    int i, sweeps;
+    double *expect;
+    SparseMatrix s;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    allocate_sparse_matrix(&s, n, n, 3 * n);
+    set_sparse_matrix(&s);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            sparse_successive_over_relaxation(&s, x, y, 1.e-10, 1.1, &sweeps));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    s.value[s.row_start[n / 2] + 1] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED,
+            sparse_successive_over_relaxation(&s, x, y, 1.e-10, 1.1, &sweeps));
+    release_sparse_matrix(&s);
+    free(expect);
+}
+
+void
+test_sparse_symmetric_successive_over_relaxation(void) {
+    /* int
+     * sparse_symmetric_successive_over_relaxation(
+     *     const SparseMatrix *a,
+     *     double *x,
+     *     const double *b,
+     *     double epsilon,
+     *     double omega,
+     *     int *sweeps
+     * ); */
+    int i, sweeps;
+    double *expect;
+    SparseMatrix s;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    allocate_sparse_matrix(&s, n, n, 3 * n);
+    set_sparse_matrix(&s);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            sparse_symmetric_successive_over_relaxation(
+                &s, x, y, 1.e-10, 1.1, &sweeps));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    s.value[s.row_start[n / 2] + 1] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED,
+            sparse_symmetric_successive_over_relaxation(
+                &s, x, y, 1.e-10, 1.1, &sweeps));
+    release_sparse_matrix(&s);
+    free(expect);
+}
+
+void
+test_sparse_multicolor_ordering(void) {
+    /* int
+     * sparse_multicolor_ordering(
+     *     MulticolorOrdering *ordering,
+     *     const SparseMatrix *a
+     * ); */
+    int i, c, k, *color;
+    double *expect;
+    SparseMatrix s;
+    MulticolorOrdering ordering;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    color = (int *)malloc(sizeof(int) * n);
+    set_spd_system(expect);
+    allocate_sparse_matrix(&s, n, n, 3 * n);
+    set_sparse_matrix(&s);
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            sparse_multicolor_ordering(&ordering, &s));
+    /* a tridiagonal matrix is red-black */
+    CU_ASSERT_EQUAL(2, ordering.num_colors);
+    CU_ASSERT_EQUAL(n, ordering.color_start[ordering.num_colors]);
+    for (c = 0; c < ordering.num_colors; ++c) {
+        for (k = ordering.color_start[c]; k < ordering.color_start[c + 1];
+                ++k) {
+            color[ordering.row[k]] = c;
+        }
+    }
+    for (i = 1; i < n; ++i) {
+        CU_ASSERT(color[i - 1] != color[i]);
+    }
+    release_multicolor_ordering(&ordering);
+    release_sparse_matrix(&s);
+    free(color);
+    free(expect);
+}
+
+void
+test_sparse_multicolor_successive_over_relaxation(void) {
+    /* int
+     * sparse_multicolor_successive_over_relaxation(
+     *     const SparseMatrix *a,
+     *     const MulticolorOrdering *ordering,
+     *     double *x,
+     *     const double *b,
+     *     double epsilon,
+     *     double omega,
+     *     int *sweeps
+     * ); */
+    int i, sweeps;
+    double *expect;
+    SparseMatrix s;
+    MulticolorOrdering ordering;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    allocate_sparse_matrix(&s, n, n, 3 * n);
+    set_sparse_matrix(&s);
+    sparse_multicolor_ordering(&ordering, &s);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            sparse_multicolor_successive_over_relaxation(
+                &s, &ordering, x, y, 1.e-10, 1.1, &sweeps));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = NAN;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_FUNCTION_NAN,
+            sparse_multicolor_successive_over_relaxation(
+                &s, &ordering, x, y, 1.e-10, 1.1, &sweeps));
+    CU_ASSERT_EQUAL(1, sweeps);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    s.value[s.row_start[n / 2] + 1] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED,
+            sparse_multicolor_successive_over_relaxation(
+                &s, &ordering, x, y, 1.e-10, 1.1, &sweeps));
+    release_multicolor_ordering(&ordering);
+    release_sparse_matrix(&s);
+    free(expect);
+}
+
+void
+test_multicolor_successive_over_relaxation(void) {
+    /* int
+     * multicolor_successive_over_relaxation(
+     *     double **a,
+     *     double *x,
+     *     const double *b,
+     *     int n,
+     *     int block,
+     *     double epsilon,
+     *     double omega,
+     *     int *sweeps
+     * ); */
+    int i, sweeps;
+    double *expect;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            multicolor_successive_over_relaxation(
+                a, x, y, n, 2, 1.e-10, 1., &sweeps));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = NAN;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_FUNCTION_NAN,
+            multicolor_successive_over_relaxation(
+                a, x, y, n, 2, 1.e-10, 1., &sweeps));
+    CU_ASSERT_EQUAL(1, sweeps);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    a[n / 2][n / 2] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED,
+            multicolor_successive_over_relaxation(
+                a, x, y, n, 2, 1.e-10, 1., &sweeps));
+    free(expect);
+}
+
+void
+test_weighted_jacobi(void) {
+    /* int
+     * weighted_jacobi(
+     *     double **a,
+     *     double *x,
+     *     const double *b,
+     *     int n,
+     *     double epsilon,
+     *     double omega,
+     *     int *sweeps
+     * ); */
+    int i, sweeps;
+    double *expect;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            weighted_jacobi(a, x, y, n, 1.e-10, 0.8, &sweeps));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = NAN;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_FUNCTION_NAN,
+            weighted_jacobi(a, x, y, n, 1.e-10, 0.8, &sweeps));
+    CU_ASSERT_EQUAL(1, sweeps);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    a[n / 2][n / 2] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED,
+            weighted_jacobi(a, x, y, n, 1.e-10, 0.8, &sweeps));
+    free(expect);
+}
+
+void
+test_sparse_weighted_jacobi(void) {
+    /* int
+     * sparse_weighted_jacobi(
+     *     const SparseMatrix *a,
+     *     double *x,
+     *     const double *b,
+     *     double epsilon,
+     *     double omega,
+     *     int *sweeps
+     * ); */
+    int i, sweeps;
+    double *expect;
+    SparseMatrix s;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    allocate_sparse_matrix(&s, n, n, 3 * n);
+    set_sparse_matrix(&s);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            sparse_weighted_jacobi(&s, x, y, 1.e-10, 0.8, &sweeps));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = NAN;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_FUNCTION_NAN,
+            sparse_weighted_jacobi(&s, x, y, 1.e-10, 0.8, &sweeps));
+    CU_ASSERT_EQUAL(1, sweeps);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    s.value[s.row_start[n / 2] + 1] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED,
+            sparse_weighted_jacobi(&s, x, y, 1.e-10, 0.8, &sweeps));
+    release_sparse_matrix(&s);
+    free(expect);
+}
+
+/*
+ * the lower triangle of a packed by rows
+ */
+static void
+set_packed_matrix(
+    double *packed
+) {
+    int i, j, k;
+
+    for (i = 0, k = 0; i < n; ++i) {
+        for (j = 0; j <= i; ++j) {
+            packed[k++] = a[i][j];
+        }
+    }
+}
+
+static void
+dense_matrix_vector(
+    double *q,
+    const double *p,
+    int n,
+    void *user
+) {
+    int i, j;
+    double **matrix = (double **)user;
+
+    for (i = 0; i < n; ++i) {
+        for (j = 0, q[i] = 0.; j < n; ++j) {
+            q[i] += matrix[i][j] * p[j];
+        }
+    }
+}
+
+void
+test_initialize_preconditioner(void) {
+    /* int
+     * initialize_preconditioner(
+     *     Preconditioner *preconditioner,
+     *     double **a,
+     *     int n,
+     *     int type,
+     *     double omega
+     * ); */
+    int i;
+    double *expect;
+    Preconditioner p;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, initialize_preconditioner(
+                &p, a, n, PRECONDITIONER_JACOBI, 1.));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(4., p.diagonal[i], 1.e-15);
+    }
+    release_preconditioner(&p);
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, initialize_preconditioner(
+                &p, a, n, PRECONDITIONER_SSOR, 1.2));
+    release_preconditioner(&p);
+    /* IC(0) of a tridiagonal matrix has no fill, so M = A */
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, initialize_preconditioner(
+                &p, a, n, PRECONDITIONER_INCOMPLETE_CHOLESKY, 1.));
+    apply_preconditioner(x, &p, y, n);
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    release_preconditioner(&p);
+    a[n / 2][n / 2] = -4.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED, initialize_preconditioner(
+                &p, a, n, PRECONDITIONER_JACOBI, 1.));
+    CU_ASSERT_EQUAL(MY_MATH_FAILED, initialize_preconditioner(
+                &p, a, n, PRECONDITIONER_INCOMPLETE_CHOLESKY, 1.));
+    free(expect);
+}
+
+void
+test_initialize_packed_preconditioner(void) {
+    /* int
+     * initialize_packed_preconditioner(
+     *     Preconditioner *preconditioner,
+     *     const double *a,
+     *     int n,
+     *     int type,
+     *     double omega
+     * ); */
+    int i;
+    double *expect, *packed;
+    Preconditioner p;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    packed = (double *)malloc(sizeof(double) * n * (n + 1) / 2);
+    set_spd_system(expect);
+    set_packed_matrix(packed);
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, initialize_packed_preconditioner(
+                &p, packed, n, PRECONDITIONER_INCOMPLETE_CHOLESKY, 1.));
+    apply_preconditioner(x, &p, y, n);
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    release_preconditioner(&p);
+    packed[(n / 2) * (n / 2 + 1) / 2 + n / 2] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED, initialize_packed_preconditioner(
+                &p, packed, n, PRECONDITIONER_SSOR, 1.));
+    free(packed);
+    free(expect);
+}
+
+void
+test_initialize_sparse_preconditioner(void) {
+    /* int
+     * initialize_sparse_preconditioner(
+     *     Preconditioner *preconditioner,
+     *     const SparseMatrix *a,
+     *     int type,
+     *     double omega
+     * ); */
+    /* the Kershaw matrix is positive definite but IC(0) breaks down */
+    static const int kershaw_row_start[] = {0, 3, 6, 9, 12};
+    static const int kershaw_column[] = {
+        0, 1, 3, 0, 1, 2, 1, 2, 3, 0, 2, 3
+    };
+    static const double kershaw_value[] = {
+        3., -2., 2., -2., 3., -2., -2., 3., -2., 2., -2., 3.
+    };
+    int i, iterations;
+    double *expect, k_x[4], k_b[4] = {1., 2., 3., 4.};
+    SparseMatrix s, k;
+    Preconditioner p;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    allocate_sparse_matrix(&s, n, n, 3 * n);
+    set_sparse_matrix(&s);
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, initialize_sparse_preconditioner(
+                &p, &s, PRECONDITIONER_INCOMPLETE_CHOLESKY, 1.));
+    apply_preconditioner(x, &p, y, n);
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    release_preconditioner(&p);
+
+    /* the diagonal is shifted until IC(0) exists */
+    allocate_sparse_matrix(&k, 4, 4, 12);
+    for (i = 0; i <= 4; ++i) {
+        k.row_start[i] = kershaw_row_start[i];
+    }
+    for (i = 0; i < 12; ++i) {
+        k.column[i] = kershaw_column[i];
+        k.value[i] = kershaw_value[i];
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, initialize_sparse_preconditioner(
+                &p, &k, PRECONDITIONER_INCOMPLETE_CHOLESKY, 1.));
+    for (i = 0; i < 4; ++i) {
+        k_x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, sparse_preconditioned_conjugate_gradient(
+                &k, &p, k_x, k_b, 1.e-12, 100, &iterations));
+    sparse_matrix_vector(expect, &k, k_x);
+    for (i = 0; i < 4; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(k_b[i], expect[i], 1.e-8);
+    }
+    release_preconditioner(&p);
+    release_sparse_matrix(&k);
+
+    s.value[s.row_start[n / 2] + 1] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED, initialize_sparse_preconditioner(
+                &p, &s, PRECONDITIONER_JACOBI, 1.));
+    release_sparse_matrix(&s);
+    free(expect);
+}
+
+void
+test_release_preconditioner(void) {
+    /* void
+     * release_preconditioner(
+     *     Preconditioner *preconditioner
+     * ); */
+    double *expect;
+    Preconditioner p;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    initialize_preconditioner(&p, a, n, PRECONDITIONER_SSOR, 1.);
+    release_preconditioner(&p);
+    CU_ASSERT(NULL == p.diagonal);
+    CU_ASSERT(NULL == p.factor.row_start);
+    CU_ASSERT(NULL == p.factor.column);
+    CU_ASSERT(NULL == p.factor.value);
+    /* a released preconditioner may be released again */
+    release_preconditioner(&p);
+    free(expect);
+}
+
+void
+test_apply_preconditioner(void) {
+    /* void
+     * apply_preconditioner(
+     *     double *z,
+     *     const Preconditioner *preconditioner,
+     *     const double *r,
+     *     int n
+     * ); */
+    int i;
+    double *expect;
+    Preconditioner p;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    apply_preconditioner(x, NULL, y, n);
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_EQUAL(y[i], x[i]);
+    }
+    initialize_preconditioner(&p, a, n, PRECONDITIONER_NONE, 1.);
+    apply_preconditioner(x, &p, y, n);
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_EQUAL(y[i], x[i]);
+    }
+    release_preconditioner(&p);
+    initialize_preconditioner(&p, a, n, PRECONDITIONER_JACOBI, 1.);
+    apply_preconditioner(x, &p, y, n);
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(y[i] / 4., x[i], 1.e-15);
+    }
+    release_preconditioner(&p);
+    free(expect);
+}
+
+void
+test_linear_operator_conjugate_gradient(void) {
+    /* int
+     * linear_operator_conjugate_gradient(
+     *     void (*matrix_vector)(double *, const double *, int, void *),
+     *     void *user,
+     *     const Preconditioner *preconditioner,
+     *     double *x,
+     *     const double *b,
+     *     int n,
+     *     double tolerance,
+     *     int upper_iter,
+     *     int *iterations
+     * ); */
+    int i, iterations;
+    double *expect;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, linear_operator_conjugate_gradient(
+                dense_matrix_vector, a, NULL, x, y, n, 1.e-12, 100,
+                &iterations));
+    CU_ASSERT(iterations <= n);
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_NOT_UPDATE, linear_operator_conjugate_gradient(
+                dense_matrix_vector, a, NULL, x, y, n, 1.e-12, 1,
+                &iterations));
+    CU_ASSERT_EQUAL(1, iterations);
+    free(expect);
+}
+
+void
+test_preconditioned_conjugate_gradient(void) {
+    /* int
+     * preconditioned_conjugate_gradient(
+     *     double **a,
+     *     const Preconditioner *preconditioner,
+     *     double *x,
+     *     const double *b,
+     *     int n,
+     *     double tolerance,
+     *     int upper_iter,
+     *     int *iterations
+     * ); */
+    int i, j, iterations;
+    double *expect;
+    Preconditioner p;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    initialize_preconditioner(&p, a, n, PRECONDITIONER_SSOR, 1.2);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, preconditioned_conjugate_gradient(
+                a, &p, x, y, n, 1.e-12, 100, &iterations));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_NOT_UPDATE, preconditioned_conjugate_gradient(
+                a, &p, x, y, n, 1.e-12, 1, &iterations));
+    release_preconditioner(&p);
+    /* p^T A p <= 0 for a negative definite A */
+    for (i = 0; i < n; ++i) {
+        for (j = 0; j < n; ++j) {
+            a[i][j] = -a[i][j];
+        }
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_FAILED, preconditioned_conjugate_gradient(
+                a, NULL, x, y, n, 1.e-12, 100, &iterations));
+    free(expect);
+}
+
+void
+test_packed_preconditioned_conjugate_gradient(void) {
+    /* int
+     * packed_preconditioned_conjugate_gradient(
+     *     const double *a,
+     *     const Preconditioner *preconditioner,
+     *     double *x,
+     *     const double *b,
+     *     int n,
+     *     double tolerance,
+     *     int upper_iter,
+     *     int *iterations
+     * ); */
+    int i, iterations;
+    double *expect, *packed;
+    Preconditioner p;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    packed = (double *)malloc(sizeof(double) * n * (n + 1) / 2);
+    set_spd_system(expect);
+    set_packed_matrix(packed);
+    initialize_packed_preconditioner(&p, packed, n, PRECONDITIONER_JACOBI, 1.);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, packed_preconditioned_conjugate_gradient(
+                packed, &p, x, y, n, 1.e-12, 100, &iterations));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_NOT_UPDATE, packed_preconditioned_conjugate_gradient(
+                packed, &p, x, y, n, 1.e-12, 1, &iterations));
+    release_preconditioner(&p);
+    free(packed);
+    free(expect);
+}
+
+void
+test_sparse_preconditioned_conjugate_gradient(void) {
+    /* int
+     * sparse_preconditioned_conjugate_gradient(
+     *     const SparseMatrix *a,
+     *     const Preconditioner *preconditioner,
+     *     double *x,
+     *     const double *b,
+     *     double tolerance,
+     *     int upper_iter,
+     *     int *iterations
+     * ); */
+    int i, iterations;
+    double *expect;
+    SparseMatrix s;
+    Preconditioner p;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    allocate_sparse_matrix(&s, n, n, 3 * n);
+    set_sparse_matrix(&s);
+    initialize_sparse_preconditioner(&p, &s, PRECONDITIONER_SSOR, 1.);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, sparse_preconditioned_conjugate_gradient(
+                &s, &p, x, y, 1.e-12, 100, &iterations));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_NOT_UPDATE, sparse_preconditioned_conjugate_gradient(
+                &s, &p, x, y, 1.e-12, 1, &iterations));
+    release_preconditioner(&p);
+    release_sparse_matrix(&s);
+    free(expect);
+}
+
+void
+test_adaptive_successive_over_relaxation(void) {
+    /* int
+     * adaptive_successive_over_relaxation(
+     *     double **a,
+     *     double *x,
+     *     const double *b,
+     *     int n,
+     *     double epsilon,
+     *     double *omega,
+     *     int *sweeps
+     * ); */
+    int i, sweeps;
+    double omega, *expect;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    set_spd_system(expect);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    omega = 1.;
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, adaptive_successive_over_relaxation(
+                a, x, y, n, 1.e-12, &omega, &sweeps));
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    CU_ASSERT(1. <= omega && 2. > omega);
+    /* an omega out of [1, 2) starts from 1 */
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    omega = 0.5;
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED, adaptive_successive_over_relaxation(
+                a, x, y, n, 1.e-12, &omega, &sweeps));
+    CU_ASSERT(1. <= omega && 2. > omega);
+    for (i = 0; i < n; ++i) {
+        x[i] = NAN;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_FUNCTION_NAN, adaptive_successive_over_relaxation(
+                a, x, y, n, 1.e-12, &omega, &sweeps));
+    CU_ASSERT_EQUAL(1, sweeps);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    a[n / 2][n / 2] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED, adaptive_successive_over_relaxation(
+                a, x, y, n, 1.e-12, &omega, &sweeps));
+    free(expect);
+}
+
+void
+test_chebyshev_symmetric_successive_over_relaxation(void) {
+    /* int
+     * chebyshev_symmetric_successive_over_relaxation(
+     *     double **a,
+     *     double *x,
+     *     const double *b,
+     *     int n,
+     *     double epsilon,
+     *     double omega,
+     *     int upper_sweeps,
+     *     double *work,
+     *     int *sweeps
+     * ); */
+    int i, sweeps;
+    double *expect, *work;
+
+    expect = (double *)malloc(sizeof(double) * n);
+    work = (double *)malloc(sizeof(double) * 2 * n);
+    set_spd_system(expect);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_SATISFIED,
+            chebyshev_symmetric_successive_over_relaxation(
+                a, x, y, n, 1.e-12, 1., 1000, work, &sweeps));
+    CU_ASSERT(sweeps < 1000);
+    for (i = 0; i < n; ++i) {
+        CU_ASSERT_DOUBLE_EQUAL(expect[i], x[i], 1.e-8);
+    }
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_NOT_UPDATE,
+            chebyshev_symmetric_successive_over_relaxation(
+                a, x, y, n, 1.e-12, 1., 2, work, &sweeps));
+    CU_ASSERT_EQUAL(2, sweeps);
+    for (i = 0; i < n; ++i) {
+        x[i] = NAN;
+    }
+    CU_ASSERT_EQUAL(MY_MATH_FUNCTION_NAN,
+            chebyshev_symmetric_successive_over_relaxation(
+                a, x, y, n, 1.e-12, 1., 1000, work, &sweeps));
+    CU_ASSERT_EQUAL(1, sweeps);
+    for (i = 0; i < n; ++i) {
+        x[i] = 0.;
+    }
+    a[n / 2][n / 2] = 0.;
+    CU_ASSERT_EQUAL(MY_MATH_FAILED,
+            chebyshev_symmetric_successive_over_relaxation(
+                a, x, y, n, 1.e-12, 1., 1000, work, &sweeps));
+    free(work);
+    free(expect);
+}
+
 int
 main(int argc, char* argv[]) {
     int i;
@@ -212,6 +1196,28 @@ main(int argc, char* argv[]) {
     CU_add_test(testSuite, "infinity_norm Test", test_infinity_norm);
     CU_add_test(testSuite, "gauss_seidel Test", test_gauss_seidel);
     CU_add_test(testSuite, "successive_over_relaxation Test", test_successive_over_relaxation);
+    CU_add_test(testSuite, "sparse_matrix_vector Test", test_sparse_matrix_vector);
+    CU_add_test(testSuite, "sparse_sor_forward_sweep Test", test_sparse_sor_forward_sweep);
+    CU_add_test(testSuite, "sparse_sor_backward_sweep Test", test_sparse_sor_backward_sweep);
+    CU_add_test(testSuite, "sparse_gauss_seidel Test", test_sparse_gauss_seidel);
+    CU_add_test(testSuite, "sparse_successive_over_relaxation Test", test_sparse_successive_over_relaxation);
+    CU_add_test(testSuite, "sparse_symmetric_successive_over_relaxation Test", test_sparse_symmetric_successive_over_relaxation);
+    CU_add_test(testSuite, "sparse_multicolor_ordering Test", test_sparse_multicolor_ordering);
+    CU_add_test(testSuite, "sparse_multicolor_successive_over_relaxation Test", test_sparse_multicolor_successive_over_relaxation);
+    CU_add_test(testSuite, "multicolor_successive_over_relaxation Test", test_multicolor_successive_over_relaxation);
+    CU_add_test(testSuite, "weighted_jacobi Test", test_weighted_jacobi);
+    CU_add_test(testSuite, "sparse_weighted_jacobi Test", test_sparse_weighted_jacobi);
+    CU_add_test(testSuite, "initialize_preconditioner Test", test_initialize_preconditioner);
+    CU_add_test(testSuite, "initialize_packed_preconditioner Test", test_initialize_packed_preconditioner);
+    CU_add_test(testSuite, "initialize_sparse_preconditioner Test", test_initialize_sparse_preconditioner);
+    CU_add_test(testSuite, "release_preconditioner Test", test_release_preconditioner);
+    CU_add_test(testSuite, "apply_preconditioner Test", test_apply_preconditioner);
+    CU_add_test(testSuite, "linear_operator_conjugate_gradient Test", test_linear_operator_conjugate_gradient);
+    CU_add_test(testSuite, "preconditioned_conjugate_gradient Test", test_preconditioned_conjugate_gradient);
+    CU_add_test(testSuite, "packed_preconditioned_conjugate_gradient Test", test_packed_preconditioned_conjugate_gradient);
+    CU_add_test(testSuite, "sparse_preconditioned_conjugate_gradient Test", test_sparse_preconditioned_conjugate_gradient);
+    CU_add_test(testSuite, "adaptive_successive_over_relaxation Test", test_adaptive_successive_over_relaxation);
+    CU_add_test(testSuite, "chebyshev_symmetric_successive_over_relaxation Test", test_chebyshev_symmetric_successive_over_relaxation);
 
     CU_console_run_tests();
     CU_cleanup_registry();
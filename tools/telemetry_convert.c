@@ -0,0 +1,319 @@
+/*
+ * vim:set ts=8 sts=4 sw=4 tw=0:
+ *
+ * File:        telemetry_convert.c
+ * Version:     0.1.0
+ * Maintainer:  Shintaro Kaneko <kaneshin0120@gmail.com>
+ * Last Change: 19-Oct-2026.
+ * TODO:
+ */
+
+/*
+ * Converts a buffer written by dump_telemetry_buffer into a Chrome
+ * trace-event JSON (chrome://tracing, Perfetto) and a CSV with one row per
+ * iteration.
+ *
+ *  usage: telemetry_convert dump [trace.json] [iteration.csv]
+ */
+
+#include "../src/include/telemetry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_DEPTH 8
+
+typedef struct _IterationRow {
+    int solve;
+    int iteration;
+    unsigned long long begin;
+    unsigned long long evaluation_begin;
+    double evaluation_time;
+    int evaluation_kind;
+    int iteration_f;
+    int iteration_g;
+    int trials;
+    int skipped;
+} IterationRow;
+
+static const char *
+event_name(
+    const TelemetryEvent *event
+);
+
+static double
+microsecond(
+    unsigned long long timestamp,
+    unsigned long long origin,
+    double ticks_per_second
+);
+
+static void
+write_trace(
+    FILE *stream,
+    const TelemetryEvent *event,
+    long int num,
+    double ticks_per_second
+);
+
+static void
+write_iteration(
+    FILE *stream,
+    const TelemetryEvent *event,
+    long int num,
+    double ticks_per_second
+);
+
+int
+main(
+    int argc,
+    char **argv
+) {
+    FILE *stream;
+    TelemetryHeader header;
+    TelemetryEvent *event;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s dump [trace.json] [iteration.csv]\n",
+                argv[0]);
+        return 1;
+    }
+    if (NULL == (stream = fopen(argv[1], "rb"))) {
+        perror(argv[1]);
+        return 1;
+    }
+    if (1 != fread(&header, sizeof(header), 1, stream)
+            || 0 != memcmp(header.magic, TELEMETRY_MAGIC,
+                sizeof(header.magic))) {
+        fprintf(stderr, "%s: not a telemetry dump\n", argv[1]);
+        fclose(stream);
+        return 1;
+    }
+    event = (TelemetryEvent *)malloc(sizeof(TelemetryEvent)
+            * (header.num_events > 0 ? header.num_events : 1));
+    if (NULL == event || header.num_events
+            != fread(event, sizeof(TelemetryEvent), header.num_events, stream)) {
+        fprintf(stderr, "%s: truncated dump\n", argv[1]);
+        free(event);
+        fclose(stream);
+        return 1;
+    }
+    fclose(stream);
+    if (header.num_lost > 0) {
+        fprintf(stderr, "%s: %llu older events were overwritten\n",
+                argv[1], header.num_lost);
+    }
+
+    stream = argc > 2 ? fopen(argv[2], "w") : stdout;
+    if (NULL == stream) {
+        perror(argv[2]);
+        free(event);
+        return 1;
+    }
+    write_trace(stream, event, (long int)header.num_events,
+            header.ticks_per_second);
+    if (stdout != stream)
+        fclose(stream);
+    if (argc > 3) {
+        if (NULL == (stream = fopen(argv[3], "w"))) {
+            perror(argv[3]);
+            free(event);
+            return 1;
+        }
+        write_iteration(stream, event, (long int)header.num_events,
+                header.ticks_per_second);
+        fclose(stream);
+    }
+    free(event);
+    return 0;
+}
+
+static const char *
+event_name(
+    const TelemetryEvent *event
+) {
+    static const char *evaluation[] = {"f", "gf", "f and gf"};
+
+    switch (event->type) {
+        case TELEMETRY_SOLVE_BEGIN:
+        case TELEMETRY_SOLVE_END:
+            return "solve";
+        case TELEMETRY_ITERATION_BEGIN:
+        case TELEMETRY_ITERATION_END:
+            return "iteration";
+        case TELEMETRY_LINE_SEARCH_TRIAL:
+            return "line search trial";
+        case TELEMETRY_UPDATE_SKIPPED:
+            return "update skipped";
+        case TELEMETRY_EVALUATION_BEGIN:
+        case TELEMETRY_EVALUATION_END:
+            if (event->value[0] >= 0. && event->value[0] < 3.)
+                return evaluation[(int)event->value[0]];
+            return "evaluation";
+        default:
+            return "unknown";
+    }
+}
+
+static double
+microsecond(
+    unsigned long long timestamp,
+    unsigned long long origin,
+    double ticks_per_second
+) {
+    return (double)(timestamp - origin) * 1.e6 / ticks_per_second;
+}
+
+/*
+ * Solves, iterations and evaluations nest, so they are written as B/E
+ * pairs with a stack of the open ones. An end whose begin was overwritten
+ * in the ring is dropped, and an end closes whatever is still open inside
+ * it (a solve ends inside its last, unfinished iteration).
+ */
+static void
+write_trace(
+    FILE *stream,
+    const TelemetryEvent *event,
+    long int num,
+    double ticks_per_second
+) {
+    int stack[MAX_DEPTH], depth, d, first;
+    long int k;
+    unsigned long long origin;
+    double ts;
+
+    origin = num > 0 ? event[0].timestamp : 0;
+    depth = 0;
+    first = 1;
+    fprintf(stream, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+    for (k = 0; k < num; ++k) {
+        ts = microsecond(event[k].timestamp, origin, ticks_per_second);
+        switch (event[k].type) {
+            case TELEMETRY_SOLVE_BEGIN:
+            case TELEMETRY_ITERATION_BEGIN:
+            case TELEMETRY_EVALUATION_BEGIN:
+                if (MAX_DEPTH == depth)
+                    break;
+                stack[depth++] = event[k].type;
+                fprintf(stream, "%s\n{\"name\": \"%s\", \"ph\": \"B\", "
+                        "\"ts\": %.3f, \"pid\": 1, \"tid\": 1, "
+                        "\"args\": {\"iteration\": %d}}",
+                        first ? "" : ",", event_name(&event[k]), ts,
+                        event[k].iteration);
+                first = 0;
+                break;
+            case TELEMETRY_SOLVE_END:
+            case TELEMETRY_ITERATION_END:
+            case TELEMETRY_EVALUATION_END:
+                for (d = depth - 1; d >= 0; --d) {
+                    if (stack[d] == event[k].type - 1)
+                        break;
+                }
+                if (d < 0)
+                    break;
+                while (depth > d + 1) {
+                    fprintf(stream, ",\n{\"ph\": \"E\", \"ts\": %.3f, "
+                            "\"pid\": 1, \"tid\": 1}", ts);
+                    --depth;
+                }
+                --depth;
+                fprintf(stream, ",\n{\"ph\": \"E\", \"ts\": %.3f, "
+                        "\"pid\": 1, \"tid\": 1, \"args\": "
+                        "{\"value0\": %.17g, \"value1\": %.17g}}",
+                        ts, event[k].value[0], event[k].value[1]);
+                break;
+            case TELEMETRY_LINE_SEARCH_TRIAL:
+            case TELEMETRY_UPDATE_SKIPPED:
+                fprintf(stream, "%s\n{\"name\": \"%s\", \"ph\": \"i\", "
+                        "\"s\": \"t\", \"ts\": %.3f, \"pid\": 1, "
+                        "\"tid\": 1, \"args\": {\"iteration\": %d, "
+                        "\"beta\": %.17g, \"f\": %.17g}}",
+                        first ? "" : ",", event_name(&event[k]), ts,
+                        event[k].iteration, event[k].value[0],
+                        event[k].value[1]);
+                first = 0;
+                break;
+            default:
+                break;
+        }
+    }
+    fprintf(stream, "\n]}\n");
+}
+
+/*
+ * One row per finished iteration; an iteration whose begin was
+ * overwritten in the ring is left out.
+ */
+static void
+write_iteration(
+    FILE *stream,
+    const TelemetryEvent *event,
+    long int num,
+    double ticks_per_second
+) {
+    IterationRow row;
+    int solve, open;
+    long int k;
+    unsigned long long origin;
+
+    origin = num > 0 ? event[0].timestamp : 0;
+    solve = 0;
+    open = 0;
+    memset(&row, 0, sizeof(row));
+    fprintf(stream, "solve,iteration,begin_us,duration_us,f,g_norm,"
+            "evaluations_f,evaluations_g,trials,evaluation_us,skipped\n");
+    for (k = 0; k < num; ++k) {
+        switch (event[k].type) {
+            case TELEMETRY_SOLVE_BEGIN:
+                ++solve;
+                open = 0;
+                break;
+            case TELEMETRY_ITERATION_BEGIN:
+                memset(&row, 0, sizeof(row));
+                row.solve = solve;
+                row.iteration = event[k].iteration;
+                row.begin = event[k].timestamp;
+                row.evaluation_kind = -1;
+                open = 1;
+                break;
+            case TELEMETRY_ITERATION_END:
+                if (!open || row.iteration != event[k].iteration)
+                    break;
+                fprintf(stream, "%d,%d,%.3f,%.3f,%.17g,%.17g,%d,%d,%d,"
+                        "%.3f,%d\n", row.solve, row.iteration,
+                        microsecond(row.begin, origin, ticks_per_second),
+                        microsecond(event[k].timestamp, row.begin,
+                            ticks_per_second),
+                        event[k].value[0], event[k].value[1],
+                        row.iteration_f, row.iteration_g, row.trials,
+                        row.evaluation_time * 1.e6 / ticks_per_second,
+                        row.skipped);
+                open = 0;
+                break;
+            case TELEMETRY_EVALUATION_BEGIN:
+                row.evaluation_begin = event[k].timestamp;
+                row.evaluation_kind = (int)event[k].value[0];
+                break;
+            case TELEMETRY_EVALUATION_END:
+                if (row.evaluation_kind != (int)event[k].value[0])
+                    break;
+                row.evaluation_time +=
+                    (double)(event[k].timestamp - row.evaluation_begin);
+                if (TELEMETRY_EVALUATION_GRADIENT != row.evaluation_kind)
+                    row.iteration_f++;
+                if (TELEMETRY_EVALUATION_FUNCTION != row.evaluation_kind)
+                    row.iteration_g++;
+                row.evaluation_kind = -1;
+                break;
+            case TELEMETRY_LINE_SEARCH_TRIAL:
+                row.trials++;
+                break;
+            case TELEMETRY_UPDATE_SKIPPED:
+                row.skipped++;
+                break;
+            default:
+                break;
+        }
+    }
+}